@@ -52,6 +52,7 @@
 #include <embb/base/c/log.h>
 #include <embb/base/c/memory_allocation.h>
 #include <embb/base/c/mutex.h>
+#include <embb/base/c/sharded_counter.h>
 #include <embb/base/c/thread.h>
 #include <embb/base/c/thread_specific_storage.h>
 #include <embb/base/c/time.h>
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_BASE_C_SHARDED_COUNTER_H_
+#define EMBB_BASE_C_SHARDED_COUNTER_H_
+
+/**
+ * \defgroup C_BASE_SHARDED_COUNTER Sharded Counter
+ * Thread-safe counter for frequent updates and rare reads
+ *
+ * In contrast to embb_counter_t, the value is distributed over several
+ * shards, each on its own cache line. A thread always updates the same
+ * shard, so concurrent updates by different threads usually do not contend.
+ * Reading the value sums up all shards.
+ *
+ * \ingroup C_BASE
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/internal/config.h>
+
+/**
+ * Number of shards of a sharded counter.
+ */
+#define EMBB_SHARDED_COUNTER_SHARD_COUNT 16
+
+/**
+ * Opaque type representing a sharded counter.
+ *
+ * A counter with static storage duration is zero-initialized and can be
+ * used without calling embb_sharded_counter_init(). The shards are aligned
+ * to cache lines, so counters created dynamically have to be allocated with
+ * embb_alloc_cache_aligned().
+ */
+#ifdef DOXYGEN
+typedef opaque_type embb_sharded_counter_t;
+#else
+typedef struct EMBB_PLATFORM_ALIGN(EMBB_PLATFORM_CACHE_LINE_SIZE)
+embb_sharded_counter_shard_t {
+  embb_atomic_long value;
+  char padding[EMBB_PLATFORM_CACHE_LINE_SIZE - sizeof(embb_atomic_long)];
+} embb_sharded_counter_shard_t;
+
+typedef struct embb_sharded_counter_t {
+  embb_sharded_counter_shard_t shards[EMBB_SHARDED_COUNTER_SHARD_COUNT];
+} embb_sharded_counter_t;
+#endif /* else defined(DOXYGEN) */
+
+/**
+ * Initializes \c counter and sets it to zero.
+ *
+ * \return EMBB_SUCCESS if counter could be initialized \n
+ *         EMBB_ERROR otherwise
+ *
+ * \memory The counter occupies EMBB_SHARDED_COUNTER_SHARD_COUNT cache lines.
+ *
+ * \notthreadsafe
+ */
+int embb_sharded_counter_init(
+  embb_sharded_counter_t* counter
+  /**< [OUT] Pointer to counter */
+  );
+
+/**
+ * Adds \c value to \c counter.
+ *
+ * \waitfree
+ */
+void embb_sharded_counter_add(
+  embb_sharded_counter_t* counter,
+  /**< [IN,OUT] Pointer to counter */
+  long value
+  /**< [IN] Value to add, may be negative */
+  );
+
+/**
+ * Returns the current value of \c counter, i.e., the sum of all shards.
+ *
+ * The result contains all updates that completed before the call. Updates
+ * running concurrently may or may not be contained.
+ *
+ * \return Current value
+ *
+ * \waitfree
+ */
+long embb_sharded_counter_read(
+  embb_sharded_counter_t* counter
+  /**< [IN] Pointer to counter */
+  );
+
+/**
+ * Destroys an initialized counter.
+ *
+ * \pre Counter is initialized
+ * \post Counter is invalid and cannot be used anymore
+ * \waitfree
+ */
+void embb_sharded_counter_destroy(
+  embb_sharded_counter_t* counter
+  /**< [OUT] Pointer to counter */
+  );
+
+#ifdef __cplusplus
+} /* Close extern "C" { */
+#endif
+
+/**
+ * \}
+ */
+
+#endif /* EMBB_BASE_C_SHARDED_COUNTER_H_ */
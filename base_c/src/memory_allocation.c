@@ -27,13 +27,15 @@
 #include <embb/base/c/memory_allocation.h>
 #include <embb/base/c/internal/config.h>
 #include <embb/base/c/atomic.h>
+#include <embb/base/c/sharded_counter.h>
 #include <embb/base/c/internal/unused.h>
 #include <stdlib.h>
 #include <assert.h>
 
 #ifdef EMBB_DEBUG
 
-static embb_atomic_long embb_bytes_allocated = { 0 };
+// Sharded, since it is updated on every allocation by all threads
+static embb_sharded_counter_t embb_bytes_allocated;
 
 enum {
   // Make the marking unlikely to be something else
@@ -49,7 +51,7 @@ void* embb_alloc(size_t bytes) {
   if (allocated == NULL)
     return NULL;
 
-  embb_atomic_fetch_and_add_long(
+  embb_sharded_counter_add(
     &embb_bytes_allocated, (long)bytes_to_allocate);
 
   size_t* x_as_size_type = (size_t*)allocated;
@@ -72,7 +74,7 @@ void embb_free(void * ptr) {
 
   (*alloc_type) = (size_t)INVALID_ALLOCATION;
 
-  embb_atomic_fetch_and_add_long(
+  embb_sharded_counter_add(
     &embb_bytes_allocated, (long)(0 - (size_t)(*bytes_allocated)));
 
   free((size_t*)ptr - 2);
@@ -127,7 +129,7 @@ void* embb_alloc_aligned(size_t alignment, size_t size) {
   x_as_size_type[-2] = (size_t)allocated;
   x_as_size_type[-3] = bytes_to_allocate;
 
-  embb_atomic_fetch_and_add_long(
+  embb_sharded_counter_add(
       &embb_bytes_allocated, (long)bytes_to_allocate);
 
   return x;
@@ -143,14 +145,14 @@ void embb_free_aligned(void* ptr) {
 
   ptr_conv[-1] = (size_t)INVALID_ALLOCATION;
 
-  embb_atomic_fetch_and_add_long(
+  embb_sharded_counter_add(
     &embb_bytes_allocated, (long)((long)0 - ptr_conv[-3]));
 
   free((void*)ptr_conv[-2]);
 }
 
 size_t embb_get_bytes_allocated() {
-  return (size_t)(embb_atomic_load_long(&embb_bytes_allocated));
+  return (size_t)(embb_sharded_counter_read(&embb_bytes_allocated));
 }
 
 #else // EMBB_DEBUG
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <embb/base/c/sharded_counter.h>
+#include <embb/base/c/errors.h>
+#include <embb/base/c/internal/platform.h>
+#include <embb/base/c/internal/unused.h>
+#include <assert.h>
+
+/**
+ * Shard used by the current thread, plus one (zero if not assigned yet).
+ *
+ * Shards are handed out round robin instead of using
+ * embb_internal_thread_index(), since thread indices are a limited resource
+ * and counters may be updated by any thread, e.g., on memory allocation.
+ *
+ * This variable has local scope.
+ */
+EMBB_THREAD_SPECIFIC unsigned int embb_sharded_counter_thread_shard = 0;
+
+/**
+ * Counter for assigning shards to threads.
+ *
+ * This variable has local scope.
+ */
+static embb_atomic_unsigned_int embb_sharded_counter_next_shard = { 0 };
+
+/**
+ * Returns the shard index of the current thread.
+ *
+ * This function has local scope.
+ */
+static unsigned int embb_sharded_counter_get_shard() {
+  if (embb_sharded_counter_thread_shard == 0) {
+    embb_sharded_counter_thread_shard = 1 +
+      embb_atomic_fetch_and_add_unsigned_int(
+        &embb_sharded_counter_next_shard, 1) %
+      EMBB_SHARDED_COUNTER_SHARD_COUNT;
+  }
+  return embb_sharded_counter_thread_shard - 1;
+}
+
+int embb_sharded_counter_init(embb_sharded_counter_t* counter) {
+  int i;
+  assert(counter != NULL);
+  for (i = 0; i != EMBB_SHARDED_COUNTER_SHARD_COUNT; ++i) {
+    embb_atomic_store_long(&(counter->shards[i].value), 0);
+  }
+  return EMBB_SUCCESS;
+}
+
+void embb_sharded_counter_add(embb_sharded_counter_t* counter, long value) {
+  assert(counter != NULL);
+  embb_atomic_fetch_and_add_long(
+    &(counter->shards[embb_sharded_counter_get_shard()].value), value);
+}
+
+long embb_sharded_counter_read(embb_sharded_counter_t* counter) {
+  int i;
+  long sum = 0;
+  assert(counter != NULL);
+  for (i = 0; i != EMBB_SHARDED_COUNTER_SHARD_COUNT; ++i) {
+    sum += embb_atomic_load_long(&(counter->shards[i].value));
+  }
+  return sum;
+}
+
+void embb_sharded_counter_destroy(embb_sharded_counter_t* counter) {
+  assert(counter != NULL);
+  EMBB_UNUSED_IN_RELEASE(counter);
+}
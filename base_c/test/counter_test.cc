@@ -32,9 +32,28 @@ namespace embb {
 namespace base {
 namespace test {
 
+namespace {
+embb_sharded_counter_t static_sharded_counter;
+
+/**
+ * Checks whether each shard of \c counter starts a cache line.
+ */
+bool IsShardedCounterAligned(embb_sharded_counter_t* counter) {
+  bool result = true;
+  for (int i = 0; i != EMBB_SHARDED_COUNTER_SHARD_COUNT; ++i) {
+    result = result && reinterpret_cast<size_t>(&counter->shards[i]) %
+      EMBB_PLATFORM_CACHE_LINE_SIZE == 0;
+  }
+  return result;
+}
+} // namespace
+
 CounterTest::CounterTest() {
   CreateUnit("Single threaded API test").Add(&CounterTest::TestBase, this);
   CreateUnit<TestStress>();
+  CreateUnit("Single threaded sharded counter test").
+    Add(&CounterTest::TestShardedBase, this);
+  CreateUnit<TestShardedStress>();
 }
 
 void CounterTest::TestBase() {
@@ -54,6 +73,30 @@ void CounterTest::TestBase() {
   embb_counter_destroy(&counter);
 }
 
+void CounterTest::TestShardedBase() {
+  embb_sharded_counter_t counter;
+  embb_sharded_counter_init(&counter);
+
+  PT_EXPECT_EQ(embb_sharded_counter_read(&counter), 0l);
+  embb_sharded_counter_add(&counter, 5);
+  PT_EXPECT_EQ(embb_sharded_counter_read(&counter), 5l);
+  embb_sharded_counter_add(&counter, -7);
+  PT_EXPECT_EQ(embb_sharded_counter_read(&counter), -2l);
+  embb_sharded_counter_init(&counter);
+  PT_EXPECT_EQ(embb_sharded_counter_read(&counter), 0l);
+  embb_sharded_counter_destroy(&counter);
+
+  // Shards must not share cache lines, regardless of the storage duration
+  PT_EXPECT(IsShardedCounterAligned(&counter));
+  PT_EXPECT(IsShardedCounterAligned(&static_sharded_counter));
+  embb_sharded_counter_t* dynamic_counter =
+    static_cast<embb_sharded_counter_t*>(
+    embb_alloc_cache_aligned(sizeof(embb_sharded_counter_t)));
+  PT_ASSERT(dynamic_counter != NULL);
+  PT_EXPECT(IsShardedCounterAligned(dynamic_counter));
+  embb_free_aligned(dynamic_counter);
+}
+
 CounterTest::TestStress::TestStress()
     : TestUnit("Stress test for incrementing and decrementing"), counter_() {
   size_t num_threads = partest::TestSuite::GetDefaultNumThreads();
@@ -70,6 +113,34 @@ void CounterTest::TestStress::CheckAndDestroyCounter() {
   embb_counter_destroy(&counter_);
 }
 
+CounterTest::TestShardedStress::TestShardedStress()
+    : TestUnit("Stress test for adding to a sharded counter"),
+      counter_(NULL) {
+  size_t num_threads = partest::TestSuite::GetDefaultNumThreads();
+  size_t num_iterations = partest::TestSuite::GetDefaultNumIterations();
+  Pre(&TestShardedStress::Init, this);
+  // Twice as many increments as decrements by two
+  Add(&TestShardedStress::TestCounterIncrement, this, 2 * num_threads,
+    num_iterations);
+  Add(&TestShardedStress::TestCounterDecrement, this, num_threads,
+    num_iterations);
+  Post(&TestShardedStress::CheckAndDestroyCounter, this);
+}
+
+void CounterTest::TestShardedStress::Init() {
+  counter_ = static_cast<embb_sharded_counter_t*>(
+    embb_alloc_cache_aligned(sizeof(embb_sharded_counter_t)));
+  PT_ASSERT(counter_ != NULL);
+  embb_sharded_counter_init(counter_);
+}
+
+void CounterTest::TestShardedStress::CheckAndDestroyCounter() {
+  PT_EXPECT_EQ(embb_sharded_counter_read(counter_), 0l);
+  embb_sharded_counter_destroy(counter_);
+  embb_free_aligned(counter_);
+  counter_ = NULL;
+}
+
 } // namespace test
 } // namespace base
 } // namespace embb
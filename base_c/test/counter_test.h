@@ -29,6 +29,7 @@
 
 #include <partest/partest.h>
 #include <embb/base/c/counter.h>
+#include <embb/base/c/sharded_counter.h>
 
 namespace embb {
 namespace base {
@@ -50,6 +51,11 @@ class CounterTest : public partest::TestCase {
    */
   void TestBase();
 
+  /**
+   * Checks adding to and reading from a sharded counter.
+   */
+  void TestShardedBase();
+
   /**
    * Test repeated incrementing and decrement by several threads.
    */
@@ -91,6 +97,48 @@ class CounterTest : public partest::TestCase {
      */
     embb_counter_t counter_;
   };
+
+  /**
+   * Test repeated adding to a sharded counter by several threads.
+   */
+  class TestShardedStress : public partest::TestUnit {
+   public:
+    /**
+     * Adds test methods to unit.
+     */
+    TestShardedStress();
+
+   private:
+    /**
+     * Allocates and inits the counter.
+     */
+    void Init();
+
+    /**
+     * Increases the counter.
+     */
+    void TestCounterIncrement() {
+      embb_sharded_counter_add(counter_, 1);
+    }
+
+    /**
+     * Decreases the counter by two.
+     */
+    void TestCounterDecrement() {
+      embb_sharded_counter_add(counter_, -2);
+    }
+
+    /**
+     * Checks the value of the counter and deletes the counter.
+     */
+    void CheckAndDestroyCounter();
+
+    /**
+     * Counter used in tests. The unit itself is not cache-aligned, so the
+     * counter is allocated separately.
+     */
+    embb_sharded_counter_t* counter_;
+  };
 };
 
 } // namespace test
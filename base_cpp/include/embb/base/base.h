@@ -56,6 +56,7 @@
 #include <embb/base/function.h>
 #include <embb/base/memory_allocation.h>
 #include <embb/base/mutex.h>
+#include <embb/base/sharded_counter.h>
 #include <embb/base/thread.h>
 #include <embb/base/thread_specific_storage.h>
 #include <embb/base/time.h>
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_BASE_SHARDED_COUNTER_H_
+#define EMBB_BASE_SHARDED_COUNTER_H_
+
+#include <embb/base/c/sharded_counter.h>
+#include <embb/base/memory_allocation.h>
+
+namespace embb {
+namespace base {
+
+/**
+ * \defgroup CPP_BASE_SHARDED_COUNTER Sharded Counter
+ * Thread-safe counter for frequent updates and rare reads
+ *
+ * \ingroup CPP_BASE
+ */
+
+/**
+ * Counter whose value is distributed over several cache-line sized shards.
+ *
+ * Each thread updates its own shard, so updates from different threads
+ * usually do not contend. Read() sums up all shards and is therefore more
+ * expensive than an update. Use this class for statistics that are updated
+ * often and read rarely.
+ *
+ * The shards are aligned to cache lines. When created with \c new, the
+ * counter is allocated with Allocation::AllocateCacheAligned().
+ *
+ * \ingroup CPP_BASE_SHARDED_COUNTER
+ */
+class ShardedCounter : public CacheAlignedAllocatable {
+ public:
+  /**
+   * Creates a counter with value zero.
+   *
+   * \memory The counter occupies EMBB_SHARDED_COUNTER_SHARD_COUNT cache lines.
+   *
+   * \notthreadsafe
+   */
+  ShardedCounter();
+
+  /**
+   * Destroys the counter.
+   *
+   * \notthreadsafe
+   */
+  ~ShardedCounter();
+
+  /**
+   * Adds \c value to the counter.
+   *
+   * \waitfree
+   */
+  void Add(
+    long value
+    /**< [IN] Value to add, may be negative */
+    );
+
+  /**
+   * Increments the counter by one.
+   *
+   * \waitfree
+   */
+  void Increment();
+
+  /**
+   * Decrements the counter by one.
+   *
+   * \waitfree
+   */
+  void Decrement();
+
+  /**
+   * Returns the current value of the counter.
+   *
+   * The result contains all updates that completed before the call. Updates
+   * running concurrently may or may not be contained.
+   *
+   * \return Sum of all shards
+   *
+   * \waitfree
+   */
+  long Read() const;
+
+ private:
+  /**
+   * Disables copy construction.
+   */
+  ShardedCounter(const ShardedCounter&);
+
+  /**
+   * Disables assignment.
+   */
+  ShardedCounter& operator=(const ShardedCounter&);
+
+  /**
+   * Holds the actual counter, mutable since reading needs a non-const
+   * pointer.
+   */
+  mutable embb_sharded_counter_t counter_;
+};
+
+} // namespace base
+} // namespace embb
+
+#endif // EMBB_BASE_SHARDED_COUNTER_H_
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sharded_counter_test.h>
+
+namespace embb {
+namespace base {
+namespace test {
+
+ShardedCounterTest::ShardedCounterTest() : counter_(),
+    number_threads_(partest::TestSuite::GetDefaultNumThreads()),
+    number_iterations_(partest::TestSuite::GetDefaultNumIterations()) {
+  CreateUnit("Single threaded updates")
+      .Add(&ShardedCounterTest::TestBasic, this);
+  CreateUnit("Concurrent increments and decrements")
+      .Pre(&ShardedCounterTest::PreCount, this)
+      .Add(&ShardedCounterTest::TestIncrement, this, number_threads_,
+          number_iterations_)
+      .Add(&ShardedCounterTest::TestDecrement, this, number_threads_,
+          number_iterations_)
+      .Post(&ShardedCounterTest::PostCount, this);
+}
+
+void ShardedCounterTest::TestBasic() {
+  ShardedCounter counter;
+  PT_EXPECT_EQ(counter.Read(), 0l);
+  counter.Increment();
+  counter.Increment();
+  PT_EXPECT_EQ(counter.Read(), 2l);
+  counter.Decrement();
+  PT_EXPECT_EQ(counter.Read(), 1l);
+  counter.Add(-11);
+  PT_EXPECT_EQ(counter.Read(), -10l);
+
+  // The shards start at the beginning of the counter
+  PT_EXPECT_EQ(reinterpret_cast<size_t>(&counter) %
+    EMBB_PLATFORM_CACHE_LINE_SIZE, static_cast<size_t>(0));
+  ShardedCounter* dynamic_counter = new ShardedCounter();
+  PT_EXPECT_EQ(reinterpret_cast<size_t>(dynamic_counter) %
+    EMBB_PLATFORM_CACHE_LINE_SIZE, static_cast<size_t>(0));
+  delete dynamic_counter;
+}
+
+void ShardedCounterTest::PreCount() {
+  counter_.Add(-counter_.Read());
+}
+
+void ShardedCounterTest::TestIncrement() {
+  counter_.Add(3);
+}
+
+void ShardedCounterTest::TestDecrement() {
+  counter_.Add(-1);
+}
+
+void ShardedCounterTest::PostCount() {
+  PT_EXPECT_EQ(counter_.Read(),
+    static_cast<long>(2 * number_threads_ * number_iterations_));
+}
+
+} // namespace test
+} // namespace base
+} // namespace embb
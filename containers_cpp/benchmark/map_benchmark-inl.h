@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_BENCHMARK_MAP_BENCHMARK_INL_H_
+#define CONTAINERS_CPP_BENCHMARK_MAP_BENCHMARK_INL_H_
+
+#include <embb/base/c/internal/thread_index.h>
+#include <iostream>
+
+namespace embb {
+namespace containers {
+namespace benchmark {
+inline bool LockedStdMapAdapter::TryInsert(int key, int value) {
+  embb::base::LockGuard<embb::base::Mutex> guard(mutex);
+  return map.insert(std::make_pair(key, value)).second;
+}
+
+inline bool LockedStdMapAdapter::TryFind(int key, int & value) {
+  embb::base::LockGuard<embb::base::Mutex> guard(mutex);
+  std::map<int, int>::const_iterator it = map.find(key);
+  if (it == map.end())
+    return false;
+  value = it->second;
+  return true;
+}
+
+inline bool LockedStdMapAdapter::TryErase(int key) {
+  embb::base::LockGuard<embb::base::Mutex> guard(mutex);
+  return map.erase(key) != 0;
+}
+
+template<typename Adapter>
+MapBenchmark<Adapter>::MapBenchmark() :
+  n_threads(static_cast<int>(partest::TestSuite::GetDefaultNumThreads())),
+  n_running_threads(1),
+  map(NULL) {
+  CreateUnit("MapBenchmarkSingleThread").
+    Pre(&MapBenchmark::MapBenchmarkSingleThread_Pre, this).
+    Add(&MapBenchmark::MapBenchmark_ThreadMethod, this).
+    Post(&MapBenchmark::MapBenchmark_Post, this);
+  CreateUnit("MapBenchmarkMultipleThreads").
+    Pre(&MapBenchmark::MapBenchmarkMultipleThreads_Pre, this).
+    Add(&MapBenchmark::MapBenchmark_ThreadMethod, this,
+    static_cast<size_t>(n_threads)).
+    Post(&MapBenchmark::MapBenchmark_Post, this);
+}
+
+template<typename Adapter>
+void MapBenchmark<Adapter>::MapBenchmark_Pre(size_t running_threads) {
+  embb_internal_thread_index_reset();
+  n_running_threads = running_threads;
+  map = new Adapter(static_cast<size_t>(KEY_RANGE));
+  for (int key = 0; key < KEY_RANGE; key += 2) {
+    map->TryInsert(key, key);
+  }
+  embb_time_now(&start);
+}
+
+template<typename Adapter>
+void MapBenchmark<Adapter>::MapBenchmarkSingleThread_Pre() {
+  MapBenchmark_Pre(1);
+}
+
+template<typename Adapter>
+void MapBenchmark<Adapter>::MapBenchmarkMultipleThreads_Pre() {
+  MapBenchmark_Pre(static_cast<size_t>(n_threads));
+}
+
+template<typename Adapter>
+void MapBenchmark<Adapter>::MapBenchmark_ThreadMethod() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+  PT_ASSERT(EMBB_SUCCESS == return_val);
+
+  // Linear congruential generator, one sequence per thread
+  unsigned int random = thread_index * 7919u + 1u;
+  for (int i = 0; i != OPERATIONS_PER_THREAD; ++i) {
+    random = random * 1103515245u + 12345u;
+    int key = static_cast<int>((random >> 8) % KEY_RANGE);
+    int value;
+    switch ((random >> 4) % 20) {
+    case 0:
+      map->TryInsert(key, key);
+      break;
+    case 1:
+      map->TryErase(key);
+      break;
+    default:
+      if (map->TryFind(key, value)) {
+        PT_ASSERT_EQ(value, key);
+      }
+      break;
+    }
+  }
+}
+
+template<typename Adapter>
+void MapBenchmark<Adapter>::MapBenchmark_Post() {
+  embb_time_t end;
+  embb_time_now(&end);
+  double seconds =
+    static_cast<double>(end.seconds - start.seconds) +
+    (static_cast<double>(end.nanoseconds) -
+    static_cast<double>(start.nanoseconds)) / 1e9;
+  double operations = static_cast<double>(OPERATIONS_PER_THREAD) *
+    static_cast<double>(n_running_threads);
+  std::cout << "  " << Adapter::GetName() << ", " << n_running_threads <<
+    " thread(s): " << static_cast<unsigned long>(operations / seconds) <<
+    " ops/s" << std::endl;
+  delete map;
+}
+} // namespace benchmark
+} // namespace containers
+} // namespace embb
+
+#endif  // CONTAINERS_CPP_BENCHMARK_MAP_BENCHMARK_INL_H_
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_BENCHMARK_MAP_BENCHMARK_H_
+#define CONTAINERS_CPP_BENCHMARK_MAP_BENCHMARK_H_
+
+#include <partest/partest.h>
+#include <embb/base/mutex.h>
+#include <embb/base/c/time.h>
+#include <embb/containers/lock_free_hash_map.h>
+#include <embb/containers/lock_free_skip_list.h>
+#include <map>
+
+namespace embb {
+namespace containers {
+namespace benchmark {
+/**
+ * Adapter providing the benchmark interface for LockFreeHashMap
+ */
+class LockFreeHashMapAdapter {
+ private:
+  embb::containers::LockFreeHashMap<int, int> map;
+
+ public:
+  explicit LockFreeHashMapAdapter(size_t capacity) : map(capacity) {}
+  static const char* GetName() { return "LockFreeHashMap"; }
+  bool TryInsert(int key, int value) { return map.TryInsert(key, value); }
+  bool TryFind(int key, int & value) { return map.TryFind(key, value); }
+  bool TryErase(int key) { return map.TryErase(key); }
+};
+
+/**
+ * Adapter providing the benchmark interface for LockFreeSkipList
+ */
+class LockFreeSkipListAdapter {
+ private:
+  embb::containers::LockFreeSkipList<int, int> skip_list;
+
+ public:
+  explicit LockFreeSkipListAdapter(size_t capacity) : skip_list(capacity) {}
+  static const char* GetName() { return "LockFreeSkipList"; }
+  bool TryInsert(int key, int value) {
+    return skip_list.TryInsert(key, value);
+  }
+  bool TryFind(int key, int & value) { return skip_list.TryFind(key, value); }
+  bool TryErase(int key) { return skip_list.TryErase(key); }
+};
+
+/**
+ * Adapter providing the benchmark interface for a mutex-protected std::map
+ */
+class LockedStdMapAdapter {
+ private:
+  std::map<int, int> map;
+  embb::base::Mutex mutex;
+
+ public:
+  explicit LockedStdMapAdapter(size_t) {}
+  static const char* GetName() { return "std::map + Mutex"; }
+  bool TryInsert(int key, int value);
+  bool TryFind(int key, int & value);
+  bool TryErase(int key);
+};
+
+/**
+ * Measures the throughput of a map under a mixed workload of 90% lookups and
+ * 10% updates (insertions and removals in equal parts). Prints the number of
+ * operations per second for a single thread and for the default number of
+ * threads.
+ *
+ * \tparam Adapter Adapter class providing TryInsert, TryFind, and TryErase
+ */
+template<typename Adapter>
+class MapBenchmark : public partest::TestCase {
+ private:
+  /// Number of distinct keys, half of them are contained initially
+  static const int KEY_RANGE = 4096;
+  /// Number of operations executed by each thread
+  static const int OPERATIONS_PER_THREAD = 50000;
+
+  int n_threads;
+  size_t n_running_threads;
+  Adapter* map;
+  embb_time_t start;
+
+  void MapBenchmark_Pre(size_t running_threads);
+  void MapBenchmarkSingleThread_Pre();
+  void MapBenchmarkMultipleThreads_Pre();
+  void MapBenchmark_ThreadMethod();
+  void MapBenchmark_Post();
+
+ public:
+  /**
+   * Adds benchmark methods.
+   */
+  MapBenchmark();
+};
+} // namespace benchmark
+} // namespace containers
+} // namespace embb
+
+#include "./map_benchmark-inl.h"
+
+#endif  // CONTAINERS_CPP_BENCHMARK_MAP_BENCHMARK_H_
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_BENCHMARK_QUEUE_BENCHMARK_INL_H_
+#define CONTAINERS_CPP_BENCHMARK_QUEUE_BENCHMARK_INL_H_
+
+#include <embb/base/c/internal/thread_index.h>
+#include <iostream>
+
+namespace embb {
+namespace containers {
+namespace benchmark {
+template<typename Adapter>
+QueueBenchmark<Adapter>::QueueBenchmark() :
+  n_threads(static_cast<int>(partest::TestSuite::GetDefaultNumThreads())),
+  n_running_threads(1),
+  queue(NULL) {
+  CreateUnit("QueueBenchmarkSingleThread").
+    Pre(&QueueBenchmark::QueueBenchmarkSingleThread_Pre, this).
+    Add(&QueueBenchmark::QueueBenchmark_ThreadMethod, this).
+    Post(&QueueBenchmark::QueueBenchmark_Post, this);
+  CreateUnit("QueueBenchmarkMultipleThreads").
+    Pre(&QueueBenchmark::QueueBenchmarkMultipleThreads_Pre, this).
+    Add(&QueueBenchmark::QueueBenchmark_ThreadMethod, this,
+    static_cast<size_t>(n_threads)).
+    Post(&QueueBenchmark::QueueBenchmark_Post, this);
+}
+
+template<typename Adapter>
+void QueueBenchmark<Adapter>::QueueBenchmark_Pre(size_t running_threads) {
+  embb_internal_thread_index_reset();
+  n_running_threads = running_threads;
+  queue = new Adapter(static_cast<size_t>(INITIAL_ELEMENTS) +
+    running_threads);
+  for (int i = 0; i != INITIAL_ELEMENTS; ++i) {
+    queue->TryEnqueue(i);
+  }
+  embb_time_now(&start);
+}
+
+template<typename Adapter>
+void QueueBenchmark<Adapter>::QueueBenchmarkSingleThread_Pre() {
+  QueueBenchmark_Pre(1);
+}
+
+template<typename Adapter>
+void QueueBenchmark<Adapter>::QueueBenchmarkMultipleThreads_Pre() {
+  QueueBenchmark_Pre(static_cast<size_t>(n_threads));
+}
+
+template<typename Adapter>
+void QueueBenchmark<Adapter>::QueueBenchmark_ThreadMethod() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+  PT_ASSERT(EMBB_SUCCESS == return_val);
+
+  // Each thread holds at most one element, so the capacity always suffices
+  // and the queue never runs empty.
+  int element = static_cast<int>(thread_index);
+  for (int i = 0; i != OPERATIONS_PER_THREAD; ++i) {
+    PT_ASSERT(queue->TryEnqueue(element));
+    PT_ASSERT(queue->TryDequeue(element));
+  }
+}
+
+template<typename Adapter>
+void QueueBenchmark<Adapter>::QueueBenchmark_Post() {
+  embb_time_t end;
+  embb_time_now(&end);
+  double seconds =
+    static_cast<double>(end.seconds - start.seconds) +
+    (static_cast<double>(end.nanoseconds) -
+    static_cast<double>(start.nanoseconds)) / 1e9;
+  double operations = 2.0 * static_cast<double>(OPERATIONS_PER_THREAD) *
+    static_cast<double>(n_running_threads);
+  std::cout << "  " << Adapter::GetName() << ", " << n_running_threads <<
+    " thread(s): " << static_cast<unsigned long>(operations / seconds) <<
+    " ops/s" << std::endl;
+  delete queue;
+}
+} // namespace benchmark
+} // namespace containers
+} // namespace embb
+
+#endif  // CONTAINERS_CPP_BENCHMARK_QUEUE_BENCHMARK_INL_H_
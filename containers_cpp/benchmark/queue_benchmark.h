@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_BENCHMARK_QUEUE_BENCHMARK_H_
+#define CONTAINERS_CPP_BENCHMARK_QUEUE_BENCHMARK_H_
+
+#include <partest/partest.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/base/c/time.h>
+#include <embb/containers/lock_free_mpmc_queue.h>
+
+namespace embb {
+namespace containers {
+namespace benchmark {
+/**
+ * Adapter providing the benchmark interface for LockFreeMPMCQueue with
+ * densely stored nodes
+ */
+class DenseMPMCQueueAdapter {
+ private:
+  embb::containers::LockFreeMPMCQueue<int> queue;
+
+ public:
+  explicit DenseMPMCQueueAdapter(size_t capacity) : queue(capacity) {}
+  static const char* GetName() { return "LockFreeMPMCQueue, dense nodes"; }
+  bool TryEnqueue(int element) { return queue.TryEnqueue(element); }
+  bool TryDequeue(int & element) { return queue.TryDequeue(element); }
+};
+
+/**
+ * Adapter providing the benchmark interface for LockFreeMPMCQueue with
+ * nodes padded to cache lines
+ */
+class PaddedMPMCQueueAdapter {
+ private:
+  embb::containers::LockFreeMPMCQueue<int,
+    embb::containers::LockFreeTreeValuePool<bool, false>,
+    embb::containers::internal::HazardPointer,
+    embb::base::AllocatorCacheAligned<int> > queue;
+
+ public:
+  explicit PaddedMPMCQueueAdapter(size_t capacity) : queue(capacity) {}
+  static const char* GetName() { return "LockFreeMPMCQueue, padded nodes"; }
+  bool TryEnqueue(int element) { return queue.TryEnqueue(element); }
+  bool TryDequeue(int & element) { return queue.TryDequeue(element); }
+};
+
+/**
+ * Measures the throughput of a queue where each thread alternately enqueues
+ * and dequeues an element. Consecutive nodes are then used by different
+ * threads, which shows the cost of false sharing between nodes. Prints the
+ * number of operations per second for a single thread and for the default
+ * number of threads.
+ *
+ * \tparam Adapter Adapter class providing TryEnqueue and TryDequeue
+ */
+template<typename Adapter>
+class QueueBenchmark : public partest::TestCase {
+ private:
+  /// Number of elements in the queue before the threads start
+  static const int INITIAL_ELEMENTS = 64;
+  /// Number of enqueue/dequeue pairs executed by each thread
+  static const int OPERATIONS_PER_THREAD = 50000;
+
+  int n_threads;
+  size_t n_running_threads;
+  Adapter* queue;
+  embb_time_t start;
+
+  void QueueBenchmark_Pre(size_t running_threads);
+  void QueueBenchmarkSingleThread_Pre();
+  void QueueBenchmarkMultipleThreads_Pre();
+  void QueueBenchmark_ThreadMethod();
+  void QueueBenchmark_Post();
+
+ public:
+  /**
+   * Adds benchmark methods.
+   */
+  QueueBenchmark();
+};
+} // namespace benchmark
+} // namespace containers
+} // namespace embb
+
+#include "./queue_benchmark-inl.h"
+
+#endif  // CONTAINERS_CPP_BENCHMARK_QUEUE_BENCHMARK_H_
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_BLOCKING_QUEUE_H_
+#define EMBB_CONTAINERS_BLOCKING_QUEUE_H_
+
+#include <embb/base/duration.h>
+#include <embb/base/time.h>
+#include <embb/containers/lock_free_mpmc_queue.h>
+#include <embb/containers/internal/event_count.h>
+
+namespace embb {
+namespace containers {
+/**
+ * Queue adapter providing blocking operations
+ *
+ * Wraps a queue satisfying the queue concept and adds operations that wait
+ * until an element is available or space is free, optionally with a
+ * timeout. Waiting threads spin for a short while and then block on an
+ * event count. As long as no thread is blocked, the non-blocking operations
+ * do not acquire any lock and retain the progress guarantee of the wrapped
+ * queue.
+ *
+ * The adapter does not change the thread-safety of the wrapped queue, e.g.,
+ * a BlockingQueue based on WaitFreeSPSCQueue must only be used by one
+ * producer and one consumer.
+ *
+ * \concept{CPP_CONCEPTS_QUEUE}
+ *
+ * \ingroup CPP_CONTAINERS_QUEUES
+ *
+ * \see LockFreeMPMCQueue, WaitFreeSPSCQueue
+ *
+ * \tparam Type Type of the queue elements
+ * \tparam Queue Type of the wrapped queue
+ */
+template< typename Type,
+  class Queue = LockFreeMPMCQueue< Type > >
+class BlockingQueue {
+ private:
+  /**
+   * Number of attempts before a thread blocks
+   */
+  static const int SPIN_COUNT = 64;
+
+  /**
+   * The wrapped queue
+   */
+  Queue queue;
+
+  /**
+   * Consumers wait here for elements
+   */
+  internal::EventCount not_empty;
+
+  /**
+   * Producers wait here for free space
+   */
+  internal::EventCount not_full;
+
+  /**
+   * Enqueues an element, waiting until the specified time point at most.
+   *
+   * \return \c true if the element was enqueued, otherwise \c false
+   */
+  bool EnqueueUntil(
+    Type const& element,
+    /**< [IN] Element to enqueue */
+    const embb::base::Time* deadline
+    /**< [IN] Time point to wait for at most, \c NULL to wait forever */);
+
+  /**
+   * Dequeues an element, waiting until the specified time point at most.
+   *
+   * \return \c true if an element was dequeued, otherwise \c false
+   */
+  bool DequeueUntil(
+    Type & element,
+    /**< [IN, OUT] Dequeued element */
+    const embb::base::Time* deadline
+    /**< [IN] Time point to wait for at most, \c NULL to wait forever */);
+
+  // Prevent copy-construction
+  BlockingQueue(const BlockingQueue&);
+
+  // Prevent assignment
+  BlockingQueue& operator=(const BlockingQueue&);
+
+ public:
+  /**
+   * Creates a queue with the specified capacity.
+   *
+   * \memory Memory of the wrapped queue with the given capacity plus two
+   *         mutexes and condition variables
+   *
+   * \notthreadsafe
+   *
+   * \see CPP_CONCEPTS_QUEUE
+   */
+  explicit BlockingQueue(
+    size_t capacity
+    /**< [IN] Capacity of the queue */);
+
+  /**
+   * Tries to enqueue an element into the queue without waiting.
+   *
+   * \return \c true if the element could be enqueued, \c false if the queue
+   *         is full.
+   *
+   * \see CPP_CONCEPTS_QUEUE
+   */
+  bool TryEnqueue(
+    Type const& element
+    /**< [IN] Const reference to the element that shall be enqueued */);
+
+  /**
+   * Tries to dequeue an element from the queue without waiting.
+   *
+   * \return \c true if an element could be dequeued, \c false if the queue
+   *         is empty.
+   *
+   * \see CPP_CONCEPTS_QUEUE
+   */
+  bool TryDequeue(
+    Type & element
+    /**< [IN, OUT] Reference to the dequeued element. Unchanged, if the
+                   operation was not successful. */);
+
+  /**
+   * Enqueues an element, waiting as long as the queue is full.
+   *
+   * \throws embb::base::ErrorException if waiting failed
+   */
+  void Enqueue(
+    Type const& element
+    /**< [IN] Const reference to the element that shall be enqueued */);
+
+  /**
+   * Enqueues an element, waiting at most the specified duration while the
+   * queue is full.
+   *
+   * \return \c true if the element could be enqueued, \c false if the
+   *         duration has passed.
+   *
+   * \throws embb::base::ErrorException if waiting failed
+   *
+   * \tparam Tick Type of tick of the duration. See embb::base::Duration.
+   */
+  template< typename Tick >
+  bool Enqueue(
+    Type const& element,
+    /**< [IN] Const reference to the element that shall be enqueued */
+    const embb::base::Duration< Tick >& timeout
+    /**< [IN] Maximum duration to wait */);
+
+  /**
+   * Dequeues an element, waiting as long as the queue is empty.
+   *
+   * \throws embb::base::ErrorException if waiting failed
+   */
+  void Dequeue(
+    Type & element
+    /**< [IN, OUT] Reference to the dequeued element */);
+
+  /**
+   * Dequeues an element, waiting at most the specified duration while the
+   * queue is empty.
+   *
+   * \return \c true if an element could be dequeued, \c false if the
+   *         duration has passed.
+   *
+   * \throws embb::base::ErrorException if waiting failed
+   *
+   * \tparam Tick Type of tick of the duration. See embb::base::Duration.
+   */
+  template< typename Tick >
+  bool Dequeue(
+    Type & element,
+    /**< [IN, OUT] Reference to the dequeued element. Unchanged, if the
+                   operation was not successful. */
+    const embb::base::Duration< Tick >& timeout
+    /**< [IN] Maximum duration to wait */);
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/blocking_queue-inl.h>
+
+#endif  // EMBB_CONTAINERS_BLOCKING_QUEUE_H_
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_CONCURRENT_OVERWRITE_RING_H_
+#define EMBB_CONTAINERS_CONCURRENT_OVERWRITE_RING_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/memory_allocation.h>
+
+/**
+ * \defgroup CPP_CONTAINERS_RINGS Rings
+ * Concurrent ring buffers
+ *
+ * \ingroup CPP_CONTAINERS
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Ring slot
+ *
+ * Contains the entry (\c element) and a sequence stamp (\c sequence). For
+ * the entry written at position \c p, the stamp is <tt>2*p+1</tt> while the
+ * entry is written and <tt>2*p+2</tt> afterwards. Both wrap around together
+ * with the positions.
+ *
+ * \tparam Type Entry type
+ */
+template< typename Type >
+class ConcurrentOverwriteRingSlot {
+ private:
+  /**
+   * Sequence stamp
+   */
+  embb::base::Atomic< size_t > sequence;
+
+  /**
+   * The stored entry
+   */
+  Type element;
+
+ public:
+  /**
+   * Creates an empty slot
+   */
+  ConcurrentOverwriteRingSlot();
+
+  /**
+   * Returns the sequence stamp
+   */
+  embb::base::Atomic< size_t > & GetSequence();
+
+  /**
+   * Returns the entry held by this slot
+   */
+  Type & GetElement();
+};
+} // namespace internal
+
+/**
+ * Fixed-size broadcast ring with overwrite semantics
+ *
+ * Writers never wait: each write takes the next position with a single
+ * fetch-and-add and replaces the oldest entry of the ring. Any number of
+ * readers can copy recent entries. A reader validates each copy against the
+ * sequence stamp of its slot (seqlock), so entries that are overwritten
+ * while being copied are discarded instead of returned torn.
+ *
+ * No memory is allocated after construction, which makes the ring suitable
+ * for tracing and metrics from performance-critical code.
+ *
+ * If the writers wrap around the whole ring while a write to the same slot
+ * is still in progress, the later write is dropped.
+ *
+ * \ingroup CPP_CONTAINERS_RINGS
+ *
+ * \tparam Type Type of the entries. Entries are copied while they may be
+ *         modified, so \c Type has to be a POD type.
+ */
+template< typename Type >
+class ConcurrentOverwriteRing {
+ private:
+  /**
+   * Concrete slot type
+   */
+  typedef internal::ConcurrentOverwriteRingSlot< Type > Slot;
+
+  /**
+   * Number of slots, a power of two
+   */
+  size_t capacity;
+
+  /**
+   * <tt>capacity-1</tt>, maps positions to slots
+   */
+  size_t mask;
+
+  /**
+   * The slots
+   */
+  Slot* slots;
+
+  /**
+   * Position of the next write
+   */
+  embb::base::Atomic< size_t > write_position;
+
+  // Prevent copy-construction
+  ConcurrentOverwriteRing(const ConcurrentOverwriteRing&);
+
+  // Prevent assignment
+  ConcurrentOverwriteRing& operator=(const ConcurrentOverwriteRing&);
+
+ public:
+  /**
+   * Creates an empty ring.
+   *
+   * \memory Allocates \c capacity, rounded up to the next power of two,
+   *         slots holding an entry and a sequence stamp.
+   *
+   * \notthreadsafe
+   */
+  explicit ConcurrentOverwriteRing(
+    size_t capacity,
+    /**< [IN] Minimum number of entries kept by the ring */
+    size_t first_position = 0
+    /**< [IN] Position of the first entry. Positions wrap around after the
+              maximum value of \c size_t. */);
+
+  /**
+   * Destroys the ring.
+   *
+   * \notthreadsafe
+   */
+  ~ConcurrentOverwriteRing();
+
+  /**
+   * Returns the number of entries kept by the ring.
+   *
+   * \return Capacity of the ring
+   *
+   * \waitfree
+   */
+  size_t GetCapacity() const;
+
+  /**
+   * Returns the position of the next entry, i.e., the first position plus
+   * the number of entries written so far.
+   *
+   * \return Current write position
+   *
+   * \waitfree
+   */
+  size_t GetWritePosition() const;
+
+  /**
+   * Writes an entry, overwriting the oldest one if the ring is full.
+   *
+   * \return Position of the entry
+   *
+   * \waitfree
+   */
+  size_t Write(
+    Type const& element
+    /**< [IN] Const reference to the entry that shall be written */);
+
+  /**
+   * Tries to read the entry at the specified position.
+   *
+   * \return \c true if the entry was read, \c false if it was not written
+   *         yet, is still being written, or has been overwritten
+   *
+   * \waitfree
+   */
+  bool TryRead(
+    size_t position,
+    /**< [IN] Position of the entry as returned by Write() */
+    Type & element
+    /**< [OUT] Reference to the read entry, unchanged on failure */) const;
+
+  /**
+   * Copies up to \c max_elements of the most recent entries, oldest first.
+   * Entries that are being written or overwritten during the copy are
+   * skipped.
+   *
+   * \return Number of entries stored in \c elements
+   *
+   * \waitfree
+   */
+  size_t Snapshot(
+    Type* elements,
+    /**< [OUT] Array receiving the entries */
+    size_t max_elements
+    /**< [IN] Capacity of \c elements */) const;
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/concurrent_overwrite_ring-inl.h>
+
+#endif  // EMBB_CONTAINERS_CONCURRENT_OVERWRITE_RING_H_
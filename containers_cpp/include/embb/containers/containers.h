@@ -33,11 +33,23 @@
  * Concurrent data structures, mainly containers
  */
 
+#include <embb/containers/blocking_queue.h>
+#include <embb/containers/concurrent_overwrite_ring.h>
+#include <embb/containers/intrusive_mpsc_queue.h>
+#include <embb/containers/lock_free_bag.h>
+#include <embb/containers/lock_free_bitmap_value_pool.h>
+#include <embb/containers/lock_free_hash_map.h>
 #include <embb/containers/lock_free_mpmc_queue.h>
+#include <embb/containers/lock_free_priority_queue.h>
+#include <embb/containers/lock_free_skip_list.h>
 #include <embb/containers/lock_free_stack.h>
 #include <embb/containers/lock_free_tree_value_pool.h>
+#include <embb/containers/lock_free_unbounded_mpmc_queue.h>
+#include <embb/containers/lock_free_vector.h>
 #include <embb/containers/object_pool.h>
+#include <embb/containers/relaxed_priority_queue.h>
 #include <embb/containers/wait_free_array_value_pool.h>
 #include <embb/containers/wait_free_spsc_queue.h>
+#include <embb/containers/work_stealing_deque.h>
 
 #endif  // EMBB_CONTAINERS_CONTAINERS_H_
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_BLOCKING_QUEUE_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_BLOCKING_QUEUE_INL_H_
+
+namespace embb {
+namespace containers {
+template< typename Type, class Queue >
+BlockingQueue<Type, Queue>::BlockingQueue(size_t capacity) :
+  queue(capacity) {
+}
+
+template< typename Type, class Queue >
+bool BlockingQueue<Type, Queue>::TryEnqueue(Type const& element) {
+  if (!queue.TryEnqueue(element))
+    return false;
+  not_empty.NotifyOne();
+  return true;
+}
+
+template< typename Type, class Queue >
+bool BlockingQueue<Type, Queue>::TryDequeue(Type & element) {
+  if (!queue.TryDequeue(element))
+    return false;
+  not_full.NotifyOne();
+  return true;
+}
+
+template< typename Type, class Queue >
+bool BlockingQueue<Type, Queue>::EnqueueUntil(Type const& element,
+  const embb::base::Time* deadline) {
+  for (int i = 0; i != SPIN_COUNT; ++i) {
+    if (TryEnqueue(element))
+      return true;
+  }
+  for (;;) {
+    unsigned int key = not_full.PrepareWait();
+    // Check again, a consumer might have missed the announcement
+    if (TryEnqueue(element)) {
+      not_full.CancelWait();
+      return true;
+    }
+    if (deadline == NULL) {
+      not_full.Wait(key);
+    } else if (!not_full.WaitUntil(key, *deadline)) {
+      return TryEnqueue(element);
+    }
+  }
+}
+
+template< typename Type, class Queue >
+bool BlockingQueue<Type, Queue>::DequeueUntil(Type & element,
+  const embb::base::Time* deadline) {
+  for (int i = 0; i != SPIN_COUNT; ++i) {
+    if (TryDequeue(element))
+      return true;
+  }
+  for (;;) {
+    unsigned int key = not_empty.PrepareWait();
+    // Check again, a producer might have missed the announcement
+    if (TryDequeue(element)) {
+      not_empty.CancelWait();
+      return true;
+    }
+    if (deadline == NULL) {
+      not_empty.Wait(key);
+    } else if (!not_empty.WaitUntil(key, *deadline)) {
+      return TryDequeue(element);
+    }
+  }
+}
+
+template< typename Type, class Queue >
+void BlockingQueue<Type, Queue>::Enqueue(Type const& element) {
+  EnqueueUntil(element, NULL);
+}
+
+template< typename Type, class Queue >
+template< typename Tick >
+bool BlockingQueue<Type, Queue>::Enqueue(Type const& element,
+  const embb::base::Duration< Tick >& timeout) {
+  embb::base::Time deadline(timeout);
+  return EnqueueUntil(element, &deadline);
+}
+
+template< typename Type, class Queue >
+void BlockingQueue<Type, Queue>::Dequeue(Type & element) {
+  DequeueUntil(element, NULL);
+}
+
+template< typename Type, class Queue >
+template< typename Tick >
+bool BlockingQueue<Type, Queue>::Dequeue(Type & element,
+  const embb::base::Duration< Tick >& timeout) {
+  embb::base::Time deadline(timeout);
+  return DequeueUntil(element, &deadline);
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_BLOCKING_QUEUE_INL_H_
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_CONCURRENT_OVERWRITE_RING_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_CONCURRENT_OVERWRITE_RING_INL_H_
+
+#include <embb/base/c/atomic.h>
+
+#include <cstddef>
+#include <new>
+
+/*
+ * Writers claim a slot by switching its stamp from a completed, older
+ * position to the odd "being written" stamp of their own position. If the
+ * slot is being written or already holds a newer entry, the write is
+ * dropped, so writers never wait for each other. Readers copy the entry
+ * between two loads of the stamp and accept the copy only if both loads
+ * yield the completed stamp of the requested position.
+ *
+ * Positions and stamps wrap around, so stamps are only compared by their
+ * signed difference.
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+template< typename Type >
+ConcurrentOverwriteRingSlot< Type >::ConcurrentOverwriteRingSlot() :
+  sequence(0), element() {
+}
+
+template< typename Type >
+embb::base::Atomic< size_t > &
+ConcurrentOverwriteRingSlot< Type >::GetSequence() {
+  return sequence;
+}
+
+template< typename Type >
+Type & ConcurrentOverwriteRingSlot< Type >::GetElement() {
+  return element;
+}
+} // namespace internal
+
+template< typename Type >
+ConcurrentOverwriteRing< Type >::ConcurrentOverwriteRing(size_t capacity,
+  size_t first_position) :
+  capacity(1),
+  mask(0),
+  slots(NULL),
+  write_position(first_position) {
+  while (this->capacity < capacity) {
+    this->capacity <<= 1;
+  }
+  mask = this->capacity - 1;
+  slots = static_cast< Slot* >(embb::base::Allocation::AllocateCacheAligned(
+    sizeof(Slot) * this->capacity));
+  // Empty slots hold the completed stamp of a position that lies before
+  // every position read or written from now on
+  size_t const empty = 2 * (first_position - this->capacity);
+  for (size_t i = 0; i != this->capacity; ++i) {
+    new (&slots[i]) Slot();
+    slots[i].GetSequence().Store(empty);
+  }
+}
+
+template< typename Type >
+ConcurrentOverwriteRing< Type >::~ConcurrentOverwriteRing() {
+  for (size_t i = 0; i != capacity; ++i) {
+    slots[i].~Slot();
+  }
+  embb::base::Allocation::FreeAligned(slots);
+}
+
+template< typename Type >
+size_t ConcurrentOverwriteRing< Type >::GetCapacity() const {
+  return capacity;
+}
+
+template< typename Type >
+size_t ConcurrentOverwriteRing< Type >::GetWritePosition() const {
+  return write_position.Load();
+}
+
+template< typename Type >
+size_t ConcurrentOverwriteRing< Type >::Write(Type const& element) {
+  size_t const position = write_position.FetchAndAdd(1);
+  Slot & slot = slots[position & mask];
+  size_t const writing = 2 * position + 1;
+  size_t stamp = slot.GetSequence().Load();
+  do {
+    if ((stamp & 1) != 0 ||
+      static_cast<ptrdiff_t>(stamp - writing) >= 0) {
+      // Slot is being written or holds a newer entry, drop this one
+      return position;
+    }
+  } while (!slot.GetSequence().CompareAndSwap(stamp, writing));
+  slot.GetElement() = element;
+  slot.GetSequence().Store(writing + 1);
+  return position;
+}
+
+template< typename Type >
+bool ConcurrentOverwriteRing< Type >::TryRead(size_t position,
+  Type & element) const {
+  Slot & slot = slots[position & mask];
+  size_t const written = 2 * position + 2;
+  if (slot.GetSequence().Load() != written) {
+    return false;
+  }
+  Type copy = slot.GetElement();
+  // Complete the copy before validating the stamp
+  embb_atomic_memory_barrier();
+  if (slot.GetSequence().Load() != written) {
+    return false;
+  }
+  element = copy;
+  return true;
+}
+
+template< typename Type >
+size_t ConcurrentOverwriteRing< Type >::Snapshot(Type* elements,
+  size_t max_elements) const {
+  size_t const end = write_position.Load();
+  size_t const count = max_elements < capacity ? max_elements : capacity;
+  size_t const begin = end - count;
+  size_t result = 0;
+  for (size_t position = begin; position != end; ++position) {
+    if (TryRead(position, elements[result])) {
+      ++result;
+    }
+  }
+  return result;
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_CONCURRENT_OVERWRITE_RING_INL_H_
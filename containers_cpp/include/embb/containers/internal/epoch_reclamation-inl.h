@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_EPOCH_RECLAMATION_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_EPOCH_RECLAMATION_INL_H_
+
+namespace embb {
+namespace containers {
+namespace internal {
+template< typename GuardType >
+EpochReclamationThreadEntry<GuardType>::
+EpochReclamationThreadEntry(size_t max_size_limbo_list) :
+  announced_epoch(0),
+  nesting_depth(0),
+  is_active(true) {
+  limbo_lists = static_cast<FixedSizeList< GuardType >*>(
+    embb::base::Allocation::Allocate(sizeof(FixedSizeList< GuardType >) * 3));
+
+  for (int i = 0; i != 3; ++i) {
+    new (static_cast<void*>(&limbo_lists[i]))
+      FixedSizeList< GuardType >(max_size_limbo_list);
+    limbo_epochs[i] = 0;
+  }
+}
+
+template< typename GuardType >
+EpochReclamationThreadEntry<GuardType>::~EpochReclamationThreadEntry() {
+  for (int i = 0; i != 3; ++i) {
+    limbo_lists[i].~FixedSizeList< GuardType >();
+  }
+
+  embb::base::Allocation::Free(limbo_lists);
+}
+
+template< typename GuardType >
+bool EpochReclamationThreadEntry<GuardType>::
+IsLagging(unsigned int epoch) const {
+  unsigned int announced = announced_epoch.Load();
+  return ((announced & 1u) != 0) && ((announced & ~1u) != epoch);
+}
+
+template< typename GuardType >
+bool EpochReclamationThreadEntry<GuardType>::Enter(unsigned int epoch) {
+  if (nesting_depth++ != 0) {
+    return false;
+  }
+  // Store implies a full memory barrier, so the announcement is visible
+  // before any pointer of the data structure is read.
+  announced_epoch.Store(epoch | 1u);
+  return true;
+}
+
+template< typename GuardType >
+void EpochReclamationThreadEntry<GuardType>::Leave() {
+  assert(nesting_depth > 0);
+  if (--nesting_depth == 0) {
+    announced_epoch.Store(0);
+  }
+}
+
+template< typename GuardType >
+bool EpochReclamationThreadEntry<GuardType>::IsActive() const {
+  return is_active;
+}
+
+template< typename GuardType >
+void EpochReclamationThreadEntry<GuardType>::Deactivate() {
+  is_active = false;
+  nesting_depth = 0;
+  announced_epoch.Store(0);
+}
+
+template< typename GuardType >
+FixedSizeList< GuardType >& EpochReclamationThreadEntry<GuardType>::
+GetLimboList(int pos) {
+  return limbo_lists[pos];
+}
+
+template< typename GuardType >
+unsigned int EpochReclamationThreadEntry<GuardType>::
+GetLimboEpoch(int pos) const {
+  return limbo_epochs[pos];
+}
+
+template< typename GuardType >
+void EpochReclamationThreadEntry<GuardType>::
+SetLimboEpoch(int pos, unsigned int epoch) {
+  limbo_epochs[pos] = epoch;
+}
+
+template< typename GuardType >
+unsigned int EpochReclamation< GuardType >::GetCurrentThreadIndex() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+
+  if (return_val != EMBB_SUCCESS)
+    EMBB_THROW(embb::base::ErrorException, "Could not get thread id!");
+
+  return thread_index;
+}
+
+template< typename GuardType >
+typename EpochReclamation< GuardType >::EpochReclamationThreadEntry_t &
+EpochReclamation< GuardType >::GetThreadEntryForCurrentThread() {
+  return *thread_entry_array[GetCurrentThreadIndex()];
+}
+
+template< typename GuardType >
+unsigned int EpochReclamation< GuardType >::TryAdvanceEpoch() {
+  unsigned int epoch = global_epoch;
+
+  // The epoch can only be advanced if all threads inside a critical region
+  // have observed the current epoch.
+  for (size_t i = 0; i != thread_entries; ++i) {
+    if (thread_entry_array[i]->IsLagging(epoch))
+      return epoch;
+  }
+
+  unsigned int expected = epoch;
+  if (global_epoch.CompareAndSwap(expected, epoch + 2)) {
+    return epoch + 2;
+  }
+  // Another thread advanced the epoch in the meantime
+  return expected;
+}
+
+template< typename GuardType >
+void EpochReclamation< GuardType >::
+FreeExpired(EpochReclamationThreadEntry_t& entry, unsigned int epoch) {
+  for (int pos = 0; pos != 3; ++pos) {
+    FixedSizeList< GuardType >& limbo = entry.GetLimboList(pos);
+    // Pointers retired in epoch e cannot be referenced anymore when the
+    // global epoch reached e + 2 * 2 (epochs are incremented by 2). The
+    // difference is computed modulo 2^n to cope with overflows.
+    if (limbo.GetSize() == 0 || epoch - entry.GetLimboEpoch(pos) < 4)
+      continue;
+
+    for (EMBB_CONTAINERS_CPP_DEPENDANT_TYPENAME
+      FixedSizeList< GuardType >::iterator it = limbo.begin();
+      it != limbo.end(); ++it) {
+      this->free_guard_callback(*it);
+    }
+    limbo.clear();
+  }
+}
+
+template< typename GuardType >
+int EpochReclamation< GuardType >::
+GetLimboListForEpoch(EpochReclamationThreadEntry_t& entry,
+  unsigned int epoch) {
+  for (int pos = 0; pos != 3; ++pos) {
+    if (entry.GetLimboList(pos).GetSize() != 0 &&
+      entry.GetLimboEpoch(pos) == epoch)
+      return pos;
+  }
+  // After freeing expired lists, at most the lists of the current and the
+  // previous epoch are non-empty, so there is always an empty one.
+  for (int pos = 0; pos != 3; ++pos) {
+    if (entry.GetLimboList(pos).GetSize() == 0) {
+      entry.SetLimboEpoch(pos, epoch);
+      return pos;
+    }
+  }
+  assert(false);
+  return -1;
+}
+
+template< typename GuardType >
+size_t EpochReclamation< GuardType >::GetRetiredListMaxSize() const {
+  return 3 * limbo_list_max_size;
+}
+
+template< typename GuardType >
+EpochReclamation< GuardType >::EpochReclamation(
+  embb::base::Function<void, GuardType> free_guard_callback,
+  GuardType, int guards_per_thread) :
+  global_epoch(0),
+  limbo_list_max_size(static_cast<size_t>(1.25 *
+    static_cast<double>(embb::base::Thread::GetThreadsMaxCount()) *
+    static_cast<double>(guards_per_thread)) + 1),
+  thread_entries(embb::base::Thread::GetThreadsMaxCount()),
+  free_guard_callback(free_guard_callback) {
+  thread_entry_array = static_cast<EpochReclamationThreadEntry_t**>(
+    embb::base::Allocation::Allocate(sizeof(EpochReclamationThreadEntry_t*) *
+    thread_entries));
+
+  for (size_t i = 0; i != thread_entries; ++i) {
+    thread_entry_array[i] = static_cast<EpochReclamationThreadEntry_t*>(
+      embb::base::Allocation::AllocateCacheAligned(
+      sizeof(EpochReclamationThreadEntry_t)));
+    new (static_cast<void*>(thread_entry_array[i]))
+      EpochReclamationThreadEntry_t(limbo_list_max_size);
+  }
+}
+
+template< typename GuardType >
+EpochReclamation< GuardType >::~EpochReclamation() {
+  for (size_t i = 0; i != thread_entries; ++i) {
+    thread_entry_array[i]->~EpochReclamationThreadEntry_t();
+    embb::base::Allocation::FreeAligned(thread_entry_array[i]);
+  }
+
+  embb::base::Allocation::Free(static_cast< void* >(thread_entry_array));
+}
+
+template< typename GuardType >
+void EpochReclamation< GuardType >::DeactivateCurrentThread() {
+  EpochReclamationThreadEntry_t& entry = GetThreadEntryForCurrentThread();
+
+  // Deactivating a non-active entry has no effect!
+  if (entry.IsActive()) {
+    entry.Deactivate();
+  }
+}
+
+template< typename GuardType >
+void EpochReclamation< GuardType >::EnterCriticalRegion() {
+  GetThreadEntryForCurrentThread().Enter(global_epoch);
+}
+
+template< typename GuardType >
+void EpochReclamation< GuardType >::LeaveCriticalRegion() {
+  GetThreadEntryForCurrentThread().Leave();
+}
+
+template< typename GuardType >
+void EpochReclamation< GuardType >::GuardPointer(int, GuardType) {
+  // Pointers are protected by the critical region
+}
+
+template< typename GuardType >
+void EpochReclamation< GuardType >::EnqueuePointerForDeletion(
+  GuardType guardedElement) {
+  EpochReclamationThreadEntry_t& entry = GetThreadEntryForCurrentThread();
+  unsigned int epoch = global_epoch;
+
+  for (;;) {
+    FreeExpired(entry, epoch);
+
+    FixedSizeList< GuardType >& limbo =
+      entry.GetLimboList(GetLimboListForEpoch(entry, epoch));
+
+    if (limbo.PushBack(guardedElement)) {
+      // Advance the epoch early, so that the limbo lists are recycled
+      // before they run full.
+      if (limbo.GetSize() * 2 >= limbo.GetMaxSize()) {
+        TryAdvanceEpoch();
+      }
+      return;
+    }
+
+    // The limbo list of the current epoch is full. Wait until all threads
+    // inside a critical region have observed the current epoch.
+    unsigned int new_epoch = TryAdvanceEpoch();
+    if (new_epoch == epoch) {
+      embb::base::Thread::CurrentYield();
+    }
+    epoch = new_epoch;
+  }
+}
+} // namespace internal
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_EPOCH_RECLAMATION_INL_H_
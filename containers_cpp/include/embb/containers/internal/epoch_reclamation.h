@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_EPOCH_RECLAMATION_H_
+#define EMBB_CONTAINERS_INTERNAL_EPOCH_RECLAMATION_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/thread.h>
+#include <embb/base/function.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/containers/internal/hazard_pointer.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Epoch reclamation entry for a single thread.
+ *
+ * Holds the epoch announced by the thread while it is inside a critical
+ * region and three limbo lists with the pointers this thread has retired.
+ * Each limbo list is tagged with the global epoch it was filled in.
+ *
+ * \tparam GuardType The type of guard, usually a pointer.
+ */
+template< typename GuardType >
+class EpochReclamationThreadEntry {
+ private:
+  /**
+   * Epoch announced by this thread. The lowest bit is set while the thread
+   * is inside a critical region, the remaining bits hold the observed global
+   * epoch.
+   */
+  embb::base::Atomic< unsigned int > announced_epoch;
+
+  /**
+   * Nesting depth of critical regions. Only accessed by the owning thread.
+   */
+  int nesting_depth;
+
+  /**
+   * Set to false if the thread stopped participating in epoch reclamation.
+   */
+  embb::base::Atomic< bool > is_active;
+
+  /**
+   * The limbo lists, holding retired pointers until they can be freed.
+   */
+  FixedSizeList< GuardType >* limbo_lists;
+
+  /**
+   * Epoch each limbo list was filled in.
+   */
+  unsigned int limbo_epochs[3];
+
+  /**
+   * EpochReclamationThreadEntry shall not be copied
+   */
+  EpochReclamationThreadEntry(const EpochReclamationThreadEntry&);
+
+  /**
+   * EpochReclamationThreadEntry shall not be assigned
+   */
+  EpochReclamationThreadEntry & operator= (const EpochReclamationThreadEntry&);
+
+ public:
+  /**
+   * Constructor
+   */
+  explicit EpochReclamationThreadEntry(
+    size_t max_size_limbo_list
+    /**< [IN] The capacity of each limbo list */);
+
+  /**
+   * Destructor
+   *
+   * Deallocates the limbo lists
+   */
+  ~EpochReclamationThreadEntry();
+
+  /**
+   * Checks if the thread blocks the global epoch from advancing beyond
+   * \c epoch.
+   *
+   * \return \c true if the thread is inside a critical region that started
+   *         in an epoch other than \c epoch, otherwise \c false.
+   */
+  bool IsLagging(
+    unsigned int epoch
+    /**< [IN] Current global epoch */) const;
+
+  /**
+   * Announces that the thread enters a critical region in \c epoch.
+   *
+   * \return \c true if this is the outermost critical region, otherwise
+   *         \c false.
+   */
+  bool Enter(
+    unsigned int epoch
+    /**< [IN] Current global epoch */);
+
+  /**
+   * Announces that the thread leaves a critical region.
+   */
+  void Leave();
+
+  /**
+   * Checks if the current thread participates in epoch reclamation.
+   *
+   * \return \c true if the thread is active, otherwise \c false.
+   */
+  bool IsActive() const;
+
+  /**
+   * Deactivates the current thread.
+   */
+  void Deactivate();
+
+  /**
+   * Gets the limbo list at the specified position.
+   *
+   * \return Reference to the limbo list
+   */
+  FixedSizeList< GuardType >& GetLimboList(
+    int pos
+    /**< [IN] Position of the limbo list (0, 1, or 2) */);
+
+  /**
+   * Gets the epoch the limbo list at the specified position was filled in.
+   *
+   * \return Epoch of the limbo list
+   */
+  unsigned int GetLimboEpoch(
+    int pos
+    /**< [IN] Position of the limbo list (0, 1, or 2) */) const;
+
+  /**
+   * Sets the epoch the limbo list at the specified position is filled in.
+   */
+  void SetLimboEpoch(
+    int pos,
+    /**< [IN] Position of the limbo list (0, 1, or 2) */
+    unsigned int epoch
+    /**< [IN] Epoch of the limbo list */);
+};
+
+/**
+ * Epoch-based memory reclamation as presented in:
+ *
+ * Keir Fraser. "Practical lock-freedom." PhD thesis, University of Cambridge,
+ * Technical Report UCAM-CL-TR-579 (2004).
+ *
+ * Provides the same interface as HazardPointer, so that containers can use
+ * either scheme as reclamation policy. Instead of guarding each pointer with
+ * a store followed by a re-validating load, a thread announces the global
+ * epoch once per operation when entering a critical region. Guarding a
+ * pointer is a no-op. A retired pointer is freed once the global epoch has
+ * advanced twice, which guarantees that no thread is still inside a critical
+ * region that could have read the pointer.
+ *
+ * As for hazard pointers, memory is only allocated at initialization. A
+ * thread whose limbo list is full waits until the global epoch can be
+ * advanced. Consequently, a thread that stalls inside a critical region
+ * blocks memory reclamation of all other threads. Pointers must therefore
+ * only be retired outside of critical regions.
+ */
+template< typename GuardType >
+class EpochReclamation {
+ private:
+  /**
+   * Concrete epoch reclamation entry type
+   */
+  typedef EpochReclamationThreadEntry< GuardType >
+    EpochReclamationThreadEntry_t;
+
+  /**
+   * The global epoch. Always even, the lowest bit of an announced epoch
+   * marks a thread inside a critical region.
+   */
+  embb::base::Atomic< unsigned int > global_epoch;
+
+  /**
+   * Capacity of a single limbo list
+   */
+  size_t limbo_list_max_size;
+
+  /**
+   * Number of thread entries
+   */
+  size_t thread_entries;
+
+  /**
+   * Array of pointers to thread entries. Each thread is assigned to one.
+   * The entries are allocated separately to place them in different cache
+   * lines.
+   */
+  EpochReclamationThreadEntry_t** thread_entry_array;
+
+  /**
+   * The callback that is triggered when a retired guard can be
+   * freed. Usually, the user will call a free here.
+   */
+  embb::base::Function<void, GuardType> free_guard_callback;
+
+  /**
+   * Each thread is assigned a thread index (starting with 0).
+   * Get the index of the current thread.
+   */
+  static unsigned int GetCurrentThreadIndex();
+
+  /**
+   * Gets the epoch reclamation entry for the current thread
+   *
+   * \return Epoch reclamation entry for current thread
+   */
+  EpochReclamationThreadEntry_t& GetThreadEntryForCurrentThread();
+
+  /**
+   * Tries to advance the global epoch. Fails if an active thread is inside a
+   * critical region started in an earlier epoch.
+   *
+   * \return The global epoch after the attempt
+   */
+  unsigned int TryAdvanceEpoch();
+
+  /**
+   * Frees all pointers of the limbo lists of \c entry that were retired at
+   * least two epochs before \c epoch.
+   */
+  void FreeExpired(
+    EpochReclamationThreadEntry_t& entry,
+    /**<[IN] Entry of the current thread */
+    unsigned int epoch
+    /**<[IN] Current global epoch */);
+
+  /**
+   * Gets a limbo list of \c entry that may receive pointers retired in
+   * \c epoch.
+   *
+   * \return Position of the limbo list
+   */
+  int GetLimboListForEpoch(
+    EpochReclamationThreadEntry_t& entry,
+    /**<[IN] Entry of the current thread */
+    unsigned int epoch
+    /**<[IN] Current global epoch */);
+
+ public:
+  /**
+   * Gets the maximum number of pointers retired by one thread that are not
+   * eligible for reuse
+   *
+   * \waitfree
+   */
+  size_t GetRetiredListMaxSize() const;
+
+  /**
+   * Initializes epoch reclamation
+   *
+   * \notthreadsafe
+   *
+   * \memory
+   *  - Let \c t be the number of maximal threads determined by EMBB
+   *  - Let \c g be the number of guards per thread
+   *  - Let \c x be 1.25*t*g + 1
+   *
+   * We dynamically allocate \c 3*x*t elements of size \c sizeof(void*).
+   */
+  EpochReclamation(
+    embb::base::Function<void, GuardType> free_guard_callback,
+    /**<[IN] Callback to the function that shall be called when a retired
+             guard can be deleted */
+    GuardType undefined_guard,
+    /**<[IN] The guard value denoting "not guarded" (unused) */
+    int guards_per_thread
+    /**<[IN] Number of guards per thread, determines the capacity of the
+             limbo lists */);
+
+  /**
+   * Deallocates the limbo lists. Note that no objects currently in the limbo
+   * lists are deleted. This is the responsibility of the user.
+   */
+  ~EpochReclamation();
+
+  /**
+   * Announces that the current thread stops participating in epoch
+   * reclamation. It does not block other threads from advancing the epoch
+   * anymore.
+   *
+   * \waitfree
+   */
+  void DeactivateCurrentThread();
+
+  /**
+   * Announces that the current thread starts an operation on the protected
+   * data structure. Pointers read after this call stay valid until the
+   * matching call to LeaveCriticalRegion().
+   *
+   * \waitfree
+   */
+  void EnterCriticalRegion();
+
+  /**
+   * Announces that the current thread finished an operation on the
+   * protected data structure.
+   *
+   * \waitfree
+   */
+  void LeaveCriticalRegion();
+
+  /**
+   * Does nothing, pointers are protected by the critical region.
+   */
+  void GuardPointer(int guardPosition, GuardType guardedElement);
+
+  /**
+   * Enqueue a pointer for deletion. It is added to the limbo list of the
+   * current epoch and deleted when no thread accesses it anymore. Must not be
+   * called inside a critical region.
+   */
+  void EnqueuePointerForDeletion(GuardType guardedElement);
+};
+} // namespace internal
+} // namespace containers
+} // namespace embb
+
+#include "./epoch_reclamation-inl.h"
+
+#endif  // EMBB_CONTAINERS_INTERNAL_EPOCH_RECLAMATION_H_
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_EVENT_COUNT_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_EVENT_COUNT_INL_H_
+
+#include <embb/base/c/atomic.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+inline EventCount::EventCount() :
+  waiters(0),
+  epoch(0) {
+}
+
+inline unsigned int EventCount::PrepareWait() {
+  // Read-modify-write implies a full memory barrier, so the announcement
+  // is visible before the waiter checks its condition again.
+  waiters.FetchAndAdd(1);
+  return epoch.Load();
+}
+
+inline void EventCount::CancelWait() {
+  waiters.FetchAndSub(1);
+}
+
+inline void EventCount::Wait(unsigned int key) {
+  {
+    embb::base::UniqueLock< embb::base::Mutex > lock(mutex);
+    while (epoch.Load() == key) {
+      condition.Wait(lock);
+    }
+  }
+  waiters.FetchAndSub(1);
+}
+
+inline bool EventCount::WaitUntil(unsigned int key,
+  const embb::base::Time& deadline) {
+  bool notified = true;
+  {
+    embb::base::UniqueLock< embb::base::Mutex > lock(mutex);
+    while (epoch.Load() == key) {
+      if (!condition.WaitUntil(lock, deadline)) {
+        notified = (epoch.Load() != key);
+        break;
+      }
+    }
+  }
+  waiters.FetchAndSub(1);
+  return notified;
+}
+
+inline bool EventCount::Advance() {
+  // Pairs with the barrier in PrepareWait(): either the notifier sees the
+  // waiter, or the waiter sees the condition made true by the notifier.
+  embb_atomic_memory_barrier();
+  if (waiters.Load() == 0)
+    return false;
+
+  embb::base::UniqueLock< embb::base::Mutex > lock(mutex);
+  epoch.FetchAndAdd(1);
+  return true;
+}
+
+inline void EventCount::NotifyOne() {
+  if (Advance()) {
+    condition.NotifyOne();
+  }
+}
+
+inline void EventCount::NotifyAll() {
+  if (Advance()) {
+    condition.NotifyAll();
+  }
+}
+} // namespace internal
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_EVENT_COUNT_INL_H_
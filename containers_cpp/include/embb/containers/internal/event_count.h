@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_EVENT_COUNT_H_
+#define EMBB_CONTAINERS_INTERNAL_EVENT_COUNT_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/mutex.h>
+#include <embb/base/condition_variable.h>
+#include <embb/base/time.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Event count for waiting on a condition of a lock-free data structure.
+ *
+ * A waiter announces itself by PrepareWait(), checks the condition again
+ * and, if it still does not hold, blocks in Wait() using the key obtained
+ * from PrepareWait(). Otherwise, it calls CancelWait(). A notifier first
+ * makes the condition true and then calls NotifyOne() or NotifyAll(). If
+ * there are no waiters, notifying costs a memory barrier and a load, the
+ * mutex is only acquired if a thread is (about to be) blocked.
+ *
+ * The epoch is incremented on each notification with waiters present.
+ * A waiter whose key differs from the current epoch was notified after it
+ * announced itself, so it does not block.
+ */
+class EventCount {
+ private:
+  /**
+   * Number of threads between PrepareWait() and the end of waiting
+   */
+  embb::base::Atomic< unsigned int > waiters;
+
+  /**
+   * Notification counter, only modified while holding \c mutex
+   */
+  embb::base::Atomic< unsigned int > epoch;
+
+  /**
+   * Protects blocking and waking up
+   */
+  embb::base::Mutex mutex;
+
+  /**
+   * Waiters are blocked on this condition variable
+   */
+  embb::base::ConditionVariable condition;
+
+  // Prevent copy-construction
+  EventCount(const EventCount&);
+
+  // Prevent assignment
+  EventCount& operator=(const EventCount&);
+
+  /**
+   * Increments the epoch if there are waiters.
+   *
+   * \return \c true if there are waiters, otherwise \c false
+   */
+  bool Advance();
+
+ public:
+  /**
+   * Creates an event count without waiters.
+   */
+  EventCount();
+
+  /**
+   * Announces that the calling thread is about to wait.
+   *
+   * \return Key to be passed to Wait() or WaitUntil()
+   *
+   * \waitfree
+   */
+  unsigned int PrepareWait();
+
+  /**
+   * Withdraws the announcement of PrepareWait() without waiting.
+   *
+   * \waitfree
+   */
+  void CancelWait();
+
+  /**
+   * Blocks until a notification after the corresponding PrepareWait().
+   */
+  void Wait(
+    unsigned int key
+    /**< [IN] Key returned by PrepareWait() */);
+
+  /**
+   * Blocks until a notification after the corresponding PrepareWait() or
+   * until the specified time point has passed.
+   *
+   * \return \c false if the time point has passed, otherwise \c true
+   */
+  bool WaitUntil(
+    unsigned int key,
+    /**< [IN] Key returned by PrepareWait() */
+    const embb::base::Time& deadline
+    /**< [IN] Absolute time point until which the thread maximally waits */);
+
+  /**
+   * Wakes up one waiting thread, if any.
+   */
+  void NotifyOne();
+
+  /**
+   * Wakes up all waiting threads, if any.
+   */
+  void NotifyAll();
+};
+} // namespace internal
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/event_count-inl.h>
+
+#endif  // EMBB_CONTAINERS_INTERNAL_EVENT_COUNT_H_
@@ -385,6 +385,14 @@ void HazardPointer< GuardType >::DeactivateCurrentThread() {
   }
 }
 
+template< typename GuardType >
+void HazardPointer< GuardType >::EnterCriticalRegion() {
+}
+
+template< typename GuardType >
+void HazardPointer< GuardType >::LeaveCriticalRegion() {
+}
+
 template< typename GuardType >
 void HazardPointer< GuardType >::GuardPointer(int guardPosition,
   GuardType guardedElement) {
@@ -512,6 +512,18 @@ class HazardPointer  {
    */
   void DeactivateCurrentThread();
 
+  /**
+   * Does nothing, hazard pointers protect each pointer individually. Provided
+   * for interface compatibility with EpochReclamation.
+   */
+  void EnterCriticalRegion();
+
+  /**
+   * Does nothing, guards have to be removed explicitly. Provided for
+   * interface compatibility with EpochReclamation.
+   */
+  void LeaveCriticalRegion();
+
   /**
    * Guards \c guardedElement with the guard at position \c guardPosition
    */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_INTRUSIVE_MPSC_QUEUE_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_INTRUSIVE_MPSC_QUEUE_INL_H_
+
+/*
+ * For a description of the algorithm, see Dmitry Vyukov. "Intrusive MPSC
+ * node-based queue". 1024cores.net, 2010.
+ *
+ * Producers swap their node into "head" and link the previous head to it
+ * afterwards. The consumer follows the links starting at "tail". The stub
+ * node is re-enqueued whenever the consumer is about to take the last node,
+ * such that the queue never becomes empty and "tail" stays valid.
+ */
+
+namespace embb {
+namespace containers {
+template< typename Type >
+IntrusiveMPSCQueue< Type >::IntrusiveMPSCQueue() :
+  head(&stub), tail(&stub), stub() {
+}
+
+template< typename Type >
+void IntrusiveMPSCQueue< Type >::Push(Node* node) {
+  node->next.Store(NULL);
+  Node* previous = head.Swap(node);
+  // Between the swap and this store, the queue is disconnected
+  previous->next.Store(node);
+}
+
+template< typename Type >
+void IntrusiveMPSCQueue< Type >::Enqueue(Type* element) {
+  Push(static_cast< Node* >(element));
+}
+
+template< typename Type >
+Type* IntrusiveMPSCQueue< Type >::TryDequeue() {
+  Node* current_tail = tail;
+  Node* next = current_tail->next.Load();
+  if (current_tail == &stub) {
+    if (next == NULL) {
+      return NULL;
+    }
+    // Skip the stub
+    tail = next;
+    current_tail = next;
+    next = next->next.Load();
+  }
+  if (next != NULL) {
+    tail = next;
+    return static_cast< Type* >(current_tail);
+  }
+  if (current_tail != head.Load()) {
+    // A producer has swapped in a node but not linked it yet
+    return NULL;
+  }
+  // current_tail is the last node, put the stub behind it to take it
+  Push(&stub);
+  next = current_tail->next.Load();
+  if (next != NULL) {
+    tail = next;
+    return static_cast< Type* >(current_tail);
+  }
+  return NULL;
+}
+
+template< typename Type >
+size_t IntrusiveMPSCQueue< Type >::TryDequeueBatch(Type** elements,
+  size_t max_elements) {
+  size_t count = 0;
+  while (count != max_elements) {
+    Type* element = TryDequeue();
+    if (element == NULL) {
+      break;
+    }
+    elements[count++] = element;
+  }
+  return count;
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_INTRUSIVE_MPSC_QUEUE_INL_H_
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_LOCK_FREE_BAG_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_LOCK_FREE_BAG_INL_H_
+
+#include <embb/base/internal/config.h>
+#include <embb/base/thread.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/base/c/internal/thread_index.h>
+
+#include <new>
+
+/*
+ * Each list is a stack as in LockFreeStack, see there for a description of
+ * the algorithm. All lists share the object pool and the reclamation scheme.
+ */
+
+namespace embb {
+namespace containers {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+void LockFreeBag< Type, ValuePool, ReclamationScheme >::
+DeletePointerCallback(Node* to_delete) {
+  objectPool.Free(to_delete);
+}
+
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+LockFreeBag< Type, ValuePool, ReclamationScheme >::
+LockFreeBag(size_t capacity,
+  size_t thread_cache_size) :
+capacity(capacity),
+// Disable "this is used in base member initializer" warning.
+// We explicitly want this.
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable:4355)
+#endif
+  delete_pointer_callback(*this,
+    &LockFreeBag::DeletePointerCallback),
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(pop)
+#endif
+  reclamationScheme(delete_pointer_callback, NULL, 1),
+  // Object pool, size with respect to the maximum number of retired nodes not
+  // eligible for reuse:
+  objectPool(
+  reclamationScheme.GetRetiredListMaxSize()*
+  embb::base::Thread::GetThreadsMaxCount() +
+  capacity,
+  thread_cache_size),
+  list_count(embb::base::Thread::GetThreadsMaxCount()),
+  // Round up to full cache lines to avoid false sharing between threads
+  list_stride(
+    (sizeof(embb::base::Atomic< Node* >) + EMBB_PLATFORM_CACHE_LINE_SIZE - 1) /
+    EMBB_PLATFORM_CACHE_LINE_SIZE * EMBB_PLATFORM_CACHE_LINE_SIZE /
+    sizeof(embb::base::Atomic< Node* >)) {
+  heads = static_cast< embb::base::Atomic< Node* >* >(
+    embb::base::Allocation::AllocateCacheAligned(
+    sizeof(embb::base::Atomic< Node* >) * list_stride * list_count));
+  for (unsigned int i = 0; i != list_count; ++i) {
+    new (&heads[i * list_stride]) embb::base::Atomic< Node* >(NULL);
+  }
+}
+
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+LockFreeBag< Type, ValuePool, ReclamationScheme >::~LockFreeBag() {
+  // The nodes belong to the object pool, only the heads are freed here
+  for (unsigned int i = 0; i != list_count; ++i) {
+    heads[i * list_stride].~Atomic();
+  }
+  embb::base::Allocation::FreeAligned(heads);
+}
+
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+size_t LockFreeBag< Type, ValuePool, ReclamationScheme >::GetCapacity() {
+  return capacity;
+}
+
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+unsigned int LockFreeBag< Type, ValuePool, ReclamationScheme >::GetOwnList() {
+  unsigned int thread_index;
+  if (embb_internal_thread_index(&thread_index) != EMBB_SUCCESS ||
+    thread_index >= list_count)
+    return 0;
+  return thread_index;
+}
+
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+bool LockFreeBag< Type, ValuePool, ReclamationScheme >::
+TryAdd(Type const& element) {
+  Node* new_node = objectPool.Allocate(element);
+
+  // Bag full, cannot add
+  if (new_node == NULL)
+    return false;
+
+  embb::base::Atomic< Node* >& head = heads[GetOwnList() * list_stride];
+  for (;;) {
+    Node* head_cached = head;
+    new_node->SetNext(head_cached);
+    if (head.CompareAndSwap(head_cached, new_node))
+      return true;
+  }
+}
+
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+bool LockFreeBag< Type, ValuePool, ReclamationScheme >::
+TryTakeFrom(unsigned int list, Type & element) {
+  embb::base::Atomic< Node* >& head = heads[list * list_stride];
+  Node* head_cached;
+  reclamationScheme.EnterCriticalRegion();
+  for (;;) {
+    head_cached = head;
+
+    // List empty
+    if (head_cached == NULL) {
+      reclamationScheme.LeaveCriticalRegion();
+      return false;
+    }
+
+    reclamationScheme.GuardPointer(0, head_cached);
+
+    // Check if the node is still the head, i.e., has not been retired yet
+    if (head != head_cached)
+      continue;
+
+    if (head.CompareAndSwap(head_cached, head_cached->GetNext()))
+      break;
+  }
+
+  Type data = head_cached->GetElement();
+
+  // We don't need to read from this reference anymore, unguard it
+  reclamationScheme.GuardPointer(0, NULL);
+  reclamationScheme.LeaveCriticalRegion();
+
+  reclamationScheme.EnqueuePointerForDeletion(head_cached);
+
+  element = data;
+  return true;
+}
+
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+bool LockFreeBag< Type, ValuePool, ReclamationScheme >::
+TryTake(Type & element) {
+  unsigned int own_list = GetOwnList();
+  // Start with the own list, then steal from the others
+  for (unsigned int i = 0; i != list_count; ++i) {
+    unsigned int list = own_list + i;
+    if (list >= list_count)
+      list -= list_count;
+    if (TryTakeFrom(list, element))
+      return true;
+  }
+  return false;
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_LOCK_FREE_BAG_INL_H_
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_LOCK_FREE_BITMAP_VALUE_POOL_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_LOCK_FREE_BITMAP_VALUE_POOL_INL_H_
+
+#include <embb/base/thread.h>
+#include <embb/base/c/internal/thread_index.h>
+
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace embb {
+namespace containers {
+template<typename Type, Type Undefined, class PoolAllocator,
+  class BitmapAllocator >
+size_t LockFreeBitmapValuePool<Type, Undefined, PoolAllocator,
+  BitmapAllocator>::FindFirstSet(size_t word) {
+  assert(word != 0);
+#if defined(EMBB_PLATFORM_COMPILER_GNUC)
+  return static_cast<size_t>(
+    __builtin_ctzll(static_cast<unsigned long long>(word)));
+#elif defined(EMBB_PLATFORM_COMPILER_MSVC)
+  unsigned long position;
+#if defined(_WIN64)
+  _BitScanForward64(&position, word);
+#else
+  _BitScanForward(&position, word);
+#endif
+  return static_cast<size_t>(position);
+#else
+  size_t position = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    ++position;
+  }
+  return position;
+#endif
+}
+
+template<typename Type, Type Undefined, class PoolAllocator,
+  class BitmapAllocator >
+size_t* LockFreeBitmapValuePool<Type, Undefined, PoolAllocator,
+  BitmapAllocator>::GetHint() {
+  unsigned int thread_index;
+  // Threads without index always start at the first word
+  if (embb_internal_thread_index(&thread_index) != EMBB_SUCCESS ||
+    thread_index >= hint_count)
+    return NULL;
+
+  return &hints[thread_index * HINT_STRIDE];
+}
+
+template<typename Type, Type Undefined, class PoolAllocator,
+  class BitmapAllocator >
+void LockFreeBitmapValuePool<Type, Undefined, PoolAllocator,
+  BitmapAllocator>::Free(Type element, int index) {
+  assert(element != Undefined);
+  assert(index >= 0 && index < size);
+
+  size_t word = static_cast<size_t>(index) / BITS_PER_WORD;
+  size_t bit = static_cast<size_t>(index) % BITS_PER_WORD;
+
+  // Store the element before publishing it in the bitmap
+  pool[index] = element;
+  bitmap[word] |= (static_cast<size_t>(1) << bit);
+
+  // The element is likely still in the cache of this processor, so look
+  // there first on the next allocation.
+  size_t* hint = GetHint();
+  if (hint != NULL)
+    *hint = word;
+}
+
+template<typename Type, Type Undefined, class PoolAllocator,
+  class BitmapAllocator >
+int LockFreeBitmapValuePool<Type, Undefined, PoolAllocator,
+  BitmapAllocator>::Allocate(Type & element) {
+  size_t* hint = GetHint();
+  size_t start = (hint == NULL) ? 0 : *hint;
+
+  for (size_t i = 0; i != word_count; ++i) {
+    size_t word = start + i;
+    if (word >= word_count)
+      word -= word_count;
+
+    size_t bits = bitmap[word].Load();
+
+    // A failed CAS reloads the word, i.e., another thread made progress.
+    // Only move on to the next word if this one has no free elements left.
+    while (bits != 0) {
+      size_t bit = FindFirstSet(bits);
+      if (bitmap[word].CompareAndSwap(
+        bits, bits & ~(static_cast<size_t>(1) << bit))) {
+        // When the CAS was successful, this element is ours
+        if (hint != NULL)
+          *hint = word;
+        int index = static_cast<int>(word * BITS_PER_WORD + bit);
+        element = pool[index];
+        return index;
+      }
+    }
+  }
+  return -1;
+}
+
+template<typename Type, Type Undefined, class PoolAllocator,
+  class BitmapAllocator >
+template<typename ForwardIterator>
+LockFreeBitmapValuePool<Type, Undefined, PoolAllocator, BitmapAllocator>::
+LockFreeBitmapValuePool(ForwardIterator first, ForwardIterator last) :
+  hint_count(embb::base::Thread::GetThreadsMaxCount()) {
+  size_t dist = static_cast<size_t>(std::distance(first, last));
+
+  size = static_cast<int>(dist);
+  word_count = (dist + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+  // Use the allocators to allocate the elements and the bitmap
+  pool = pool_allocator.allocate(dist);
+  bitmap = bitmap_allocator.allocate(word_count);
+
+  int i = 0;
+
+  // Store the elements of the range
+  for (ForwardIterator curIter(first); curIter != last; ++curIter) {
+    pool[i++] = *curIter;
+  }
+
+  // Mark all elements as free, the bits beyond the last element stay unset
+  for (size_t word = 0; word != word_count; ++word) {
+    size_t bits = dist - word * BITS_PER_WORD;
+    if (bits >= BITS_PER_WORD) {
+      bitmap[word] = ~static_cast<size_t>(0);
+    } else {
+      bitmap[word] = (static_cast<size_t>(1) << bits) - 1;
+    }
+  }
+
+  // Initially spread the threads evenly across the bitmap
+  hints = static_cast<size_t*>(embb::base::Allocation::AllocateCacheAligned(
+    sizeof(size_t) * HINT_STRIDE * hint_count));
+  for (unsigned int thread = 0; thread != hint_count; ++thread) {
+    hints[thread * HINT_STRIDE] = word_count * thread / hint_count;
+  }
+}
+
+template<typename Type, Type Undefined, class PoolAllocator,
+  class BitmapAllocator >
+LockFreeBitmapValuePool<Type, Undefined, PoolAllocator, BitmapAllocator>::
+~LockFreeBitmapValuePool() {
+  embb::base::Allocation::FreeAligned(hints);
+  bitmap_allocator.deallocate(bitmap, word_count);
+  pool_allocator.deallocate(pool, static_cast<size_t>(size));
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_LOCK_FREE_BITMAP_VALUE_POOL_INL_H_
@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_LOCK_FREE_HASH_MAP_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_LOCK_FREE_HASH_MAP_INL_H_
+
+#include <embb/base/internal/config.h>
+
+/*
+ * The following algorithm uses hazard pointers and a lock-free value pool for
+ * memory management. For a description of the algorithm, see
+ * Ori Shalev and Nir Shavit. "Split-ordered lists: Lock-free extensible hash
+ * tables." Journal of the ACM 53.3 (2006): 379-405.
+ * The underlying list is described in
+ * Maged M. Michael. "High performance dynamic lock-free hash tables and
+ * list-based sets." Proceedings of the fourteenth annual ACM symposium on
+ * parallel algorithms and architectures. ACM, 2002. (Figure 4, Page 6)
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+template< typename Key, typename Value >
+LockFreeHashMapNode<Key, Value>::LockFreeHashMapNode(size_t so_key) :
+  next(NULL),
+  so_key(so_key) {
+}
+
+template< typename Key, typename Value >
+LockFreeHashMapNode<Key, Value>::LockFreeHashMapNode(size_t so_key,
+  Key const& key, Value const& value) :
+  next(NULL),
+  so_key(so_key),
+  key(key),
+  value(value) {
+}
+
+template< typename Key, typename Value >
+embb::base::Atomic< LockFreeHashMapNode< Key, Value >* > &
+  LockFreeHashMapNode<Key, Value>::GetNext() {
+  return next;
+}
+
+template< typename Key, typename Value >
+size_t LockFreeHashMapNode<Key, Value>::GetSplitOrderKey() const {
+  return so_key;
+}
+
+template< typename Key, typename Value >
+bool LockFreeHashMapNode<Key, Value>::IsDummy() const {
+  return (so_key & 1) == 0;
+}
+
+template< typename Key, typename Value >
+Key const& LockFreeHashMapNode<Key, Value>::GetKey() const {
+  return key;
+}
+
+template< typename Key, typename Value >
+Value const& LockFreeHashMapNode<Key, Value>::GetValue() const {
+  return value;
+}
+} // namespace internal
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+void LockFreeHashMap<Key, Value, Hash, ValuePool>::
+DeletePointerCallback(Node* to_delete) {
+  objectPool.Free(to_delete);
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+size_t LockFreeHashMap<Key, Value, Hash, ValuePool>::
+ReverseBits(size_t value) {
+  // Swap halves, quarters, ... until single bits are swapped
+  size_t shift = sizeof(size_t) * 4;
+  size_t mask = ~static_cast<size_t>(0);
+  while (shift > 0) {
+    mask ^= (mask << shift);
+    value = ((value >> shift) & mask) | ((value << shift) & ~mask);
+    shift >>= 1;
+  }
+  return value;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+size_t LockFreeHashMap<Key, Value, Hash, ValuePool>::
+GetRegularSplitOrderKey(size_t hash_value) {
+  return ReverseBits(hash_value) | 1;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+size_t LockFreeHashMap<Key, Value, Hash, ValuePool>::
+GetDummySplitOrderKey(size_t bucket) {
+  return ReverseBits(bucket) & ~static_cast<size_t>(1);
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+bool LockFreeHashMap<Key, Value, Hash, ValuePool>::IsMarked(Node* node) {
+  return (reinterpret_cast<size_t>(node) & 1) != 0;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+typename LockFreeHashMap<Key, Value, Hash, ValuePool>::Node*
+LockFreeHashMap<Key, Value, Hash, ValuePool>::Mark(Node* node) {
+  return reinterpret_cast<Node*>(reinterpret_cast<size_t>(node) | 1);
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+typename LockFreeHashMap<Key, Value, Hash, ValuePool>::Node*
+LockFreeHashMap<Key, Value, Hash, ValuePool>::Unmark(Node* node) {
+  return reinterpret_cast<Node*>(
+    reinterpret_cast<size_t>(node) & ~static_cast<size_t>(1));
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+size_t LockFreeHashMap<Key, Value, Hash, ValuePool>::
+GetMaxBucketCount(size_t capacity) {
+  size_t count = 2;
+  while (count * MAX_LOAD_FACTOR < capacity) {
+    count <<= 1;
+  }
+  return count;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+size_t LockFreeHashMap<Key, Value, Hash, ValuePool>::
+GetParentBucket(size_t bucket) {
+  assert(bucket > 0);
+  // Clear the most significant set bit
+  size_t msb = 1;
+  while (msb <= (bucket >> 1)) {
+    msb <<= 1;
+  }
+  return bucket & ~msb;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+typename LockFreeHashMap<Key, Value, Hash, ValuePool>::Node*
+LockFreeHashMap<Key, Value, Hash, ValuePool>::GetBucket(size_t bucket) {
+  Node* head = buckets[bucket];
+  if (head == NULL) {
+    InitializeBucket(bucket);
+    head = buckets[bucket];
+    // No node left for the dummy node, the parent bucket covers all
+    // elements of this bucket as well.
+    if (head == NULL) {
+      head = GetBucket(GetParentBucket(bucket));
+    }
+  }
+  return head;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+void LockFreeHashMap<Key, Value, Hash, ValuePool>::
+InitializeBucket(size_t bucket) {
+  Node* parent = GetBucket(GetParentBucket(bucket));
+
+  Node* dummy = objectPool.Allocate(GetDummySplitOrderKey(bucket));
+  if (dummy == NULL)
+    return;
+
+  Node* result = ListInsert(parent, dummy);
+  if (result != dummy) {
+    // Another thread inserted the dummy node first. Ours was never
+    // visible to other threads, so it can be freed immediately.
+    objectPool.Free(dummy);
+  }
+
+  Node* expected = NULL;
+  buckets[bucket].CompareAndSwap(expected, result);
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+bool LockFreeHashMap<Key, Value, Hash, ValuePool>::Find(Node* head,
+  size_t so_key, Key const& key, bool is_dummy,
+  embb::base::Atomic< Node* >*& prev, Node*& cur, Node*& next) {
+  for (;;) {
+    // Dummy nodes are never removed, no need to guard head.
+    prev = &head->GetNext();
+    cur = *prev;
+    hazardPointer.GuardPointer(GUARD_CURRENT, cur);
+
+    // Check if pointer is still valid after guarding.
+    if (*prev != cur)
+      continue;
+
+    bool retry = false;
+    while (!retry) {
+      if (cur == NULL)
+        return false;
+
+      Node* cur_next = cur->GetNext();
+      next = Unmark(cur_next);
+      hazardPointer.GuardPointer(GUARD_NEXT, next);
+
+      // Check that cur was neither modified nor unlinked in the meantime.
+      if (cur->GetNext() != cur_next || *prev != cur) {
+        retry = true;
+        continue;
+      }
+
+      if (!IsMarked(cur_next)) {
+        size_t cur_so_key = cur->GetSplitOrderKey();
+        if (cur_so_key > so_key)
+          return false;
+        // Dummy nodes have even, regular nodes odd split-order keys. For the
+        // latter, the split-order key is not unique due to hash collisions.
+        if (cur_so_key == so_key && (is_dummy || cur->GetKey() == key))
+          return true;
+        prev = &cur->GetNext();
+        hazardPointer.GuardPointer(GUARD_PREVIOUS, cur);
+      } else {
+        // cur is logically deleted, try to unlink it.
+        Node* expected = cur;
+        if (prev->CompareAndSwap(expected, next)) {
+          hazardPointer.EnqueuePointerForDeletion(cur);
+        } else {
+          retry = true;
+          continue;
+        }
+      }
+      cur = next;
+      hazardPointer.GuardPointer(GUARD_CURRENT, cur);
+    }
+  }
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+typename LockFreeHashMap<Key, Value, Hash, ValuePool>::Node*
+LockFreeHashMap<Key, Value, Hash, ValuePool>::ListInsert(Node* head,
+  Node* node) {
+  embb::base::Atomic< Node* >* prev;
+  Node* cur;
+  Node* next;
+  for (;;) {
+    if (Find(head, node->GetSplitOrderKey(), node->GetKey(), node->IsDummy(),
+      prev, cur, next)) {
+      return cur;
+    }
+    node->GetNext() = cur;
+    Node* expected = cur;
+    if (prev->CompareAndSwap(expected, node))
+      return node;
+  }
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+void LockFreeHashMap<Key, Value, Hash, ValuePool>::ClearGuards() {
+  hazardPointer.GuardPointer(GUARD_NEXT, NULL);
+  hazardPointer.GuardPointer(GUARD_CURRENT, NULL);
+  hazardPointer.GuardPointer(GUARD_PREVIOUS, NULL);
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+LockFreeHashMap<Key, Value, Hash, ValuePool>::LockFreeHashMap(
+  size_t capacity,
+  size_t thread_cache_size) :
+capacity(capacity),
+max_bucket_count(GetMaxBucketCount(capacity)),
+// Disable "this is used in base member initializer" warning.
+// We explicitly want this.
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable:4355)
+#endif
+  delete_pointer_callback(*this,
+    &LockFreeHashMap::DeletePointerCallback),
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(pop)
+#endif
+  hazardPointer(delete_pointer_callback, NULL, 3),
+  // Object pool, size with respect to the maximum number of retired nodes not
+  // eligible for reuse. +1 dummy node per bucket.
+  objectPool(
+  hazardPointer.GetRetiredListMaxSize()*
+  embb::base::Thread::GetThreadsMaxCount() +
+  capacity + max_bucket_count,
+  thread_cache_size),
+  bucket_count(2),
+  element_count(0) {
+  buckets = static_cast<embb::base::Atomic< Node* >*>(
+    embb::base::Allocation::Allocate(
+    sizeof(embb::base::Atomic< Node* >) * max_bucket_count));
+  for (size_t i = 0; i != max_bucket_count; ++i) {
+    new (static_cast<void*>(&buckets[i])) embb::base::Atomic< Node* >(NULL);
+  }
+
+  // The dummy node of bucket 0 is the head of the list.
+  buckets[0] = objectPool.Allocate(GetDummySplitOrderKey(0));
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+LockFreeHashMap<Key, Value, Hash, ValuePool>::~LockFreeHashMap() {
+  // Nodes are owned by the object pool
+  for (size_t i = 0; i != max_bucket_count; ++i) {
+    buckets[i].~Atomic();
+  }
+  embb::base::Allocation::Free(buckets);
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+size_t LockFreeHashMap<Key, Value, Hash, ValuePool>::GetCapacity() {
+  return capacity;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+size_t LockFreeHashMap<Key, Value, Hash, ValuePool>::GetBucketCount() {
+  return bucket_count;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+size_t LockFreeHashMap<Key, Value, Hash, ValuePool>::GetSize() {
+  return element_count;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+bool LockFreeHashMap<Key, Value, Hash, ValuePool>::TryInsert(Key const& key,
+  Value const& value) {
+  size_t hash_value = hash(key);
+  Node* node = objectPool.Allocate(GetRegularSplitOrderKey(hash_value), key,
+    value);
+
+  // Map full, cannot insert
+  if (node == NULL)
+    return false;
+
+  size_t current_bucket_count = bucket_count;
+  Node* head = GetBucket(hash_value & (current_bucket_count - 1));
+  Node* result = ListInsert(head, node);
+  ClearGuards();
+
+  if (result != node) {
+    // Key already contained, node was never visible to other threads.
+    objectPool.Free(node);
+    return false;
+  }
+
+  // Double the number of buckets if the load factor is exceeded. New buckets
+  // are initialized lazily on first access.
+  size_t count = element_count.FetchAndAdd(1) + 1;
+  if (count > current_bucket_count * MAX_LOAD_FACTOR &&
+    current_bucket_count < max_bucket_count) {
+    bucket_count.CompareAndSwap(current_bucket_count,
+      current_bucket_count * 2);
+  }
+  return true;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+bool LockFreeHashMap<Key, Value, Hash, ValuePool>::TryFind(Key const& key,
+  Value & value) {
+  size_t hash_value = hash(key);
+  Node* head = GetBucket(hash_value & (bucket_count - 1));
+
+  embb::base::Atomic< Node* >* prev;
+  Node* cur;
+  Node* next;
+  bool found = Find(head, GetRegularSplitOrderKey(hash_value), key, false,
+    prev, cur, next);
+  if (found) {
+    // cur is guarded and its value is never modified
+    value = cur->GetValue();
+  }
+  ClearGuards();
+  return found;
+}
+
+template< typename Key, typename Value, class Hash, typename ValuePool >
+bool LockFreeHashMap<Key, Value, Hash, ValuePool>::TryErase(Key const& key) {
+  size_t hash_value = hash(key);
+  size_t so_key = GetRegularSplitOrderKey(hash_value);
+  Node* head = GetBucket(hash_value & (bucket_count - 1));
+
+  embb::base::Atomic< Node* >* prev;
+  Node* cur;
+  Node* next;
+  for (;;) {
+    if (!Find(head, so_key, key, false, prev, cur, next)) {
+      ClearGuards();
+      return false;
+    }
+
+    // Logically delete cur by marking its next pointer
+    Node* expected = next;
+    if (!cur->GetNext().CompareAndSwap(expected, Mark(next)))
+      continue;
+
+    // Try to unlink cur. If we fail, another thread will unlink it in Find.
+    expected = cur;
+    if (prev->CompareAndSwap(expected, next)) {
+      ClearGuards();
+      hazardPointer.EnqueuePointerForDeletion(cur);
+    } else {
+      Find(head, so_key, key, false, prev, cur, next);
+      ClearGuards();
+    }
+    element_count.FetchAndSub(1);
+    return true;
+  }
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_LOCK_FREE_HASH_MAP_INL_H_
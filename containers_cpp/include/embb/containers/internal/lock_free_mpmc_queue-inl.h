@@ -30,8 +30,9 @@
 #include <embb/base/internal/config.h>
 
 /*
- * The following algorithm uses hazard pointers and a lock-free value pool for
- * memory management. For a description of the algorithm, see
+ * The following algorithm uses hazard pointers (or epoch-based reclamation,
+ * depending on the reclamation scheme) and a lock-free value pool for memory
+ * management. For a description of the algorithm, see
  * Maged M. Michael and Michael L. Scott. "Simple, fast, and practical
  * non-blocking and blocking concurrent queue algorithms". Proceedings of the
  * fifteenth annual ACM symposium on principles of distributed computing.
@@ -64,19 +65,25 @@ T LockFreeMPMCQueueNode<T>::GetElement() {
 }
 } // namespace internal
 
-template< typename Type, typename ValuePool >
-void LockFreeMPMCQueue<Type, ValuePool>::
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme, class Allocator >
+void LockFreeMPMCQueue<Type, ValuePool, ReclamationScheme, Allocator>::
 DeletePointerCallback(internal::LockFreeMPMCQueueNode<Type>* to_delete) {
   objectPool.Free(to_delete);
 }
 
-template< typename Type, typename ValuePool >
-LockFreeMPMCQueue<Type, ValuePool>::~LockFreeMPMCQueue() {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme, class Allocator >
+LockFreeMPMCQueue<Type, ValuePool, ReclamationScheme, Allocator>::
+~LockFreeMPMCQueue() {
   // Nothing to do here, did not allocate anything.
 }
 
-template< typename Type, typename ValuePool >
-LockFreeMPMCQueue<Type, ValuePool>::LockFreeMPMCQueue(size_t capacity) :
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme, class Allocator >
+LockFreeMPMCQueue<Type, ValuePool, ReclamationScheme, Allocator>::
+LockFreeMPMCQueue(size_t capacity,
+  size_t thread_cache_size) :
 capacity(capacity),
 // Disable "this is used in base member initializer" warning.
 // We explicitly want this.
@@ -85,17 +92,18 @@ capacity(capacity),
 #pragma warning(disable:4355)
 #endif
 delete_pointer_callback(*this,
-  &LockFreeMPMCQueue<Type>::DeletePointerCallback),
+  &LockFreeMPMCQueue::DeletePointerCallback),
 #ifdef EMBB_PLATFORM_COMPILER_MSVC
 #pragma warning(pop)
 #endif
-  hazardPointer(delete_pointer_callback, NULL, 2),
+  reclamationScheme(delete_pointer_callback, NULL, 2),
   // Object pool, size with respect to the maximum number of retired nodes not
   // eligible for reuse. +1 for dummy node.
   objectPool(
-  hazardPointer.GetRetiredListMaxSize()*
+  reclamationScheme.GetRetiredListMaxSize()*
   embb::base::Thread::GetThreadsMaxCount() +
-  capacity + 1) {
+  capacity + 1,
+  thread_cache_size) {
   // Allocate dummy node to reduce the number of special cases to consider.
   internal::LockFreeMPMCQueueNode<Type>* dummyNode = objectPool.Allocate();
   // Initially, head and tail point to the dummy node.
@@ -103,13 +111,17 @@ delete_pointer_callback(*this,
   tail = dummyNode;
 }
 
-template< typename Type, typename ValuePool >
-size_t LockFreeMPMCQueue<Type, ValuePool>::GetCapacity() {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme, class Allocator >
+size_t LockFreeMPMCQueue<Type, ValuePool, ReclamationScheme, Allocator>::
+GetCapacity() {
   return capacity;
 }
 
-template< typename Type, typename ValuePool >
-bool LockFreeMPMCQueue<Type, ValuePool>::TryEnqueue(Type const& element) {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme, class Allocator >
+bool LockFreeMPMCQueue<Type, ValuePool, ReclamationScheme, Allocator>::
+TryEnqueue(Type const& element) {
   // Get node from the pool containing element to enqueue.
   internal::LockFreeMPMCQueueNode<Type>* node = objectPool.Allocate(element);
 
@@ -117,10 +129,11 @@ bool LockFreeMPMCQueue<Type, ValuePool>::TryEnqueue(Type const& element) {
   if (node == NULL)
     return false;
   internal::LockFreeMPMCQueueNode<Type>* my_tail;
+  reclamationScheme.EnterCriticalRegion();
   for (;;) {
     my_tail = tail;
 
-    hazardPointer.GuardPointer(0, my_tail);
+    reclamationScheme.GuardPointer(0, my_tail);
 
     // Check if pointer is still valid after guarding.
     if (my_tail != tail) {
@@ -150,29 +163,35 @@ bool LockFreeMPMCQueue<Type, ValuePool>::TryEnqueue(Type const& element) {
   // We added our node. Try to update tail pointer. Need not succeed, if we
   // fail, another thread will help us.
   tail.CompareAndSwap(my_tail, node);
+  reclamationScheme.LeaveCriticalRegion();
 
   return true;
 }
 
-template< typename Type, typename ValuePool >
-bool LockFreeMPMCQueue<Type, ValuePool>::TryDequeue(Type & element) {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme, class Allocator >
+bool LockFreeMPMCQueue<Type, ValuePool, ReclamationScheme, Allocator>::
+TryDequeue(Type & element) {
   internal::LockFreeMPMCQueueNode<Type>* my_head;
   internal::LockFreeMPMCQueueNode<Type>* my_tail;
   internal::LockFreeMPMCQueueNode<Type>* my_next;
   internal::LockFreeMPMCQueueNode<Type>* expected;
   Type data;
+  reclamationScheme.EnterCriticalRegion();
   for (;;) {
     my_head = head;
-    hazardPointer.GuardPointer(0, my_head);
+    reclamationScheme.GuardPointer(0, my_head);
     if (my_head != head) continue;
 
     my_tail = tail;
     my_next = my_head->GetNext();
-    hazardPointer.GuardPointer(1, my_next);
+    reclamationScheme.GuardPointer(1, my_next);
     if (head != my_head) continue;
 
-    if (my_next == NULL)
+    if (my_next == NULL) {
+      reclamationScheme.LeaveCriticalRegion();
       return false;
+    }
 
     if (my_head == my_tail) {
       expected = my_tail;
@@ -186,8 +205,11 @@ bool LockFreeMPMCQueue<Type, ValuePool>::TryDequeue(Type & element) {
     if (head.CompareAndSwap(expected, my_next))
       break;
   }
+  reclamationScheme.LeaveCriticalRegion();
 
-  hazardPointer.EnqueuePointerForDeletion(my_head);
+  // Retire outside of the critical region, epoch-based reclamation might
+  // wait for other threads here.
+  reclamationScheme.EnqueuePointerForDeletion(my_head);
   element = data;
   return true;
 }
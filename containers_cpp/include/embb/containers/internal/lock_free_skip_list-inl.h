@@ -0,0 +1,548 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_LOCK_FREE_SKIP_LIST_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_LOCK_FREE_SKIP_LIST_INL_H_
+
+#include <embb/base/internal/config.h>
+#include <embb/base/c/internal/thread_index.h>
+
+/*
+ * The following algorithm uses hazard pointers and a lock-free value pool for
+ * memory management. For a description of the algorithm, see
+ * Keir Fraser. "Practical lock-freedom." PhD thesis, University of
+ * Cambridge, 2004, where each level is a list as described in
+ * Maged M. Michael. "High performance dynamic lock-free hash tables and
+ * list-based sets." SPAA 2002.
+ *
+ * Reclamation: The inserter may still link a node on upper levels while it
+ * is being removed. Therefore, a node is retired only after both the inserter
+ * and the remover have released it. The remover always searches for the node
+ * after marking all levels, the inserter does so only if it finds the node
+ * deleted after it has finished linking. Either search unlinks the node on
+ * all levels.
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+template< typename Key, typename Value >
+LockFreeSkipListNode<Key, Value>::LockFreeSkipListNode() :
+  height(MAX_HEIGHT),
+  owners(0) {
+  for (int level = 0; level != MAX_HEIGHT; ++level) {
+    next[level] = NULL;
+  }
+}
+
+template< typename Key, typename Value >
+LockFreeSkipListNode<Key, Value>::LockFreeSkipListNode(
+  Key const& key, Value const& value, int height) :
+  key(key),
+  value(value),
+  height(height),
+  owners(2) {
+  for (int level = 0; level != MAX_HEIGHT; ++level) {
+    next[level] = NULL;
+  }
+}
+
+template< typename Key, typename Value >
+embb::base::Atomic< LockFreeSkipListNode< Key, Value >* > &
+  LockFreeSkipListNode<Key, Value>::GetNext(int level) {
+  assert(level >= 0 && level < height);
+  return next[level];
+}
+
+template< typename Key, typename Value >
+int LockFreeSkipListNode<Key, Value>::GetHeight() const {
+  return height;
+}
+
+template< typename Key, typename Value >
+Key const& LockFreeSkipListNode<Key, Value>::GetKey() const {
+  return key;
+}
+
+template< typename Key, typename Value >
+Value const& LockFreeSkipListNode<Key, Value>::GetValue() const {
+  return value;
+}
+
+template< typename Key, typename Value >
+bool LockFreeSkipListNode<Key, Value>::ReleaseOwner() {
+  return owners.FetchAndSub(1) == 1;
+}
+} // namespace internal
+
+template< typename Key, typename Value, typename ValuePool >
+LockFreeSkipList<Key, Value, ValuePool>::Iterator::Iterator() :
+  skip_list(NULL) {
+}
+
+template< typename Key, typename Value, typename ValuePool >
+LockFreeSkipList<Key, Value, ValuePool>::Iterator::Iterator(
+  LockFreeSkipList* skip_list, ElementType const& element) :
+  skip_list(skip_list),
+  element(element) {
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::ElementType const&
+LockFreeSkipList<Key, Value, ValuePool>::Iterator::operator*() const {
+  assert(skip_list != NULL);
+  return element;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::ElementType const*
+LockFreeSkipList<Key, Value, ValuePool>::Iterator::operator->() const {
+  assert(skip_list != NULL);
+  return &element;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::Iterator&
+LockFreeSkipList<Key, Value, ValuePool>::Iterator::operator++() {
+  assert(skip_list != NULL);
+  // Search for the successor of the current key, which might have been
+  // removed in the meantime.
+  Key key = element.first;
+  if (!skip_list->GetElement(key, true, element)) {
+    skip_list = NULL;
+  }
+  return *this;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::Iterator
+LockFreeSkipList<Key, Value, ValuePool>::Iterator::operator++(int) {
+  Iterator previous(*this);
+  ++(*this);
+  return previous;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool LockFreeSkipList<Key, Value, ValuePool>::Iterator::operator==(
+  Iterator const& other) const {
+  if (skip_list == NULL || other.skip_list == NULL)
+    return skip_list == other.skip_list;
+  return skip_list == other.skip_list &&
+    !(element.first < other.element.first) &&
+    !(other.element.first < element.first);
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool LockFreeSkipList<Key, Value, ValuePool>::Iterator::operator!=(
+  Iterator const& other) const {
+  return !(*this == other);
+}
+
+template< typename Key, typename Value, typename ValuePool >
+void LockFreeSkipList<Key, Value, ValuePool>::
+DeletePointerCallback(Node* to_delete) {
+  objectPool.Free(to_delete);
+}
+
+template< typename Key, typename Value, typename ValuePool >
+int LockFreeSkipList<Key, Value, ValuePool>::GetMaxHeight(size_t capacity) {
+  int height = 1;
+  while (height < Node::MAX_HEIGHT &&
+    (static_cast<size_t>(1) << height) < capacity) {
+    ++height;
+  }
+  return height;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool LockFreeSkipList<Key, Value, ValuePool>::IsMarked(Node* node) {
+  return (reinterpret_cast<size_t>(node) & 1) != 0;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::Node*
+LockFreeSkipList<Key, Value, ValuePool>::Mark(Node* node) {
+  return reinterpret_cast<Node*>(reinterpret_cast<size_t>(node) | 1);
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::Node*
+LockFreeSkipList<Key, Value, ValuePool>::Unmark(Node* node) {
+  return reinterpret_cast<Node*>(
+    reinterpret_cast<size_t>(node) & ~static_cast<size_t>(1));
+}
+
+template< typename Key, typename Value, typename ValuePool >
+int LockFreeSkipList<Key, Value, ValuePool>::
+GetPredecessorGuard(int level) const {
+  return 1 + level;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+int LockFreeSkipList<Key, Value, ValuePool>::
+GetSuccessorGuard(int level) const {
+  return 1 + max_height + level;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+unsigned int LockFreeSkipList<Key, Value, ValuePool>::
+GetCurrentThreadIndex() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+
+  if (return_val != EMBB_SUCCESS)
+    EMBB_THROW(embb::base::ErrorException, "Could not get thread id!");
+
+  return thread_index;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+int LockFreeSkipList<Key, Value, ValuePool>::GetRandomHeight() {
+  // Xorshift generator, each thread uses its own cache line
+  unsigned int& seed = random_seeds[GetCurrentThreadIndex() *
+    (EMBB_PLATFORM_CACHE_LINE_SIZE / sizeof(unsigned int))];
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  // Geometric distribution with p = 1/2
+  unsigned int bits = seed;
+  int height = 1;
+  while (height < max_height && (bits & 1) != 0) {
+    ++height;
+    bits >>= 1;
+  }
+  return height;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+void LockFreeSkipList<Key, Value, ValuePool>::Find(Key const& key,
+  bool after, Node** preds, Node** succs) {
+  for (;;) {
+    bool retry = false;
+    // The head is never removed, no need to guard it.
+    Node* pred = head;
+    for (int level = max_height - 1; level >= 0 && !retry; --level) {
+      // pred is guarded by the predecessor guard of an upper level
+      Node* cur = pred->GetNext(level);
+      if (IsMarked(cur)) {
+        retry = true;
+        continue;
+      }
+      hazardPointer.GuardPointer(GetSuccessorGuard(level), cur);
+
+      // Check if pointer is still valid after guarding.
+      if (pred->GetNext(level) != cur) {
+        retry = true;
+        continue;
+      }
+
+      while (cur != NULL) {
+        Node* cur_next = cur->GetNext(level);
+        Node* next = Unmark(cur_next);
+        hazardPointer.GuardPointer(GUARD_NEXT, next);
+
+        // Check that cur was neither modified nor unlinked in the meantime.
+        if (cur->GetNext(level) != cur_next || pred->GetNext(level) != cur) {
+          retry = true;
+          break;
+        }
+
+        if (!IsMarked(cur_next)) {
+          if (level > 0 && IsMarked(cur->GetNext(0))) {
+            // cur is being removed, help marking this level.
+            cur->GetNext(level).CompareAndSwap(cur_next, Mark(cur_next));
+            continue;
+          }
+          if (after ? key < cur->GetKey() : !(cur->GetKey() < key))
+            break;
+          pred = cur;
+          hazardPointer.GuardPointer(GetPredecessorGuard(level), pred);
+        } else {
+          // cur is deleted on this level, try to unlink it. It is retired
+          // by its owners.
+          Node* expected = cur;
+          if (!pred->GetNext(level).CompareAndSwap(expected, next)) {
+            retry = true;
+            break;
+          }
+        }
+        cur = next;
+        hazardPointer.GuardPointer(GetSuccessorGuard(level), cur);
+      }
+
+      preds[level] = pred;
+      succs[level] = cur;
+    }
+    if (!retry)
+      return;
+  }
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool LockFreeSkipList<Key, Value, ValuePool>::GetElement(Key const& key,
+  bool after, ElementType & element) {
+  Node* preds[Node::MAX_HEIGHT];
+  Node* succs[Node::MAX_HEIGHT];
+  Find(key, after, preds, succs);
+  Node* node = succs[0];
+  if (node != NULL) {
+    // node is guarded and its key and value are never modified
+    element.first = node->GetKey();
+    element.second = node->GetValue();
+  }
+  ClearGuards();
+  return node != NULL;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+void LockFreeSkipList<Key, Value, ValuePool>::Release(Node* node) {
+  if (node->ReleaseOwner()) {
+    hazardPointer.EnqueuePointerForDeletion(node);
+  }
+}
+
+template< typename Key, typename Value, typename ValuePool >
+void LockFreeSkipList<Key, Value, ValuePool>::ClearGuards() {
+  hazardPointer.GuardPointer(GUARD_NEXT, NULL);
+  for (int level = 0; level != max_height; ++level) {
+    hazardPointer.GuardPointer(GetPredecessorGuard(level), NULL);
+    hazardPointer.GuardPointer(GetSuccessorGuard(level), NULL);
+  }
+}
+
+template< typename Key, typename Value, typename ValuePool >
+LockFreeSkipList<Key, Value, ValuePool>::LockFreeSkipList(size_t capacity,
+  size_t thread_cache_size) :
+capacity(capacity),
+max_height(GetMaxHeight(capacity)),
+// Disable "this is used in base member initializer" warning.
+// We explicitly want this.
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable:4355)
+#endif
+  delete_pointer_callback(*this, &LockFreeSkipList::DeletePointerCallback),
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(pop)
+#endif
+  // One guard per level for predecessors and successors, one for the next
+  // node during traversal
+  hazardPointer(delete_pointer_callback, NULL, 2 * max_height + 1),
+  // Object pool, size with respect to the maximum number of retired nodes not
+  // eligible for reuse.
+  objectPool(
+  hazardPointer.GetRetiredListMaxSize()*
+  embb::base::Thread::GetThreadsMaxCount() +
+  capacity,
+  thread_cache_size),
+  head(embb::base::Allocation::New<Node>()) {
+  unsigned int thread_count = embb::base::Thread::GetThreadsMaxCount();
+  random_seeds = static_cast<unsigned int*>(
+    embb::base::Allocation::AllocateCacheAligned(
+    EMBB_PLATFORM_CACHE_LINE_SIZE * thread_count));
+  for (unsigned int i = 0; i != thread_count; ++i) {
+    random_seeds[i * (EMBB_PLATFORM_CACHE_LINE_SIZE / sizeof(unsigned int))] =
+      2463534242u + i * 2654435761u;
+  }
+}
+
+template< typename Key, typename Value, typename ValuePool >
+LockFreeSkipList<Key, Value, ValuePool>::~LockFreeSkipList() {
+  // Nodes are owned by the object pool
+  embb::base::Allocation::FreeAligned(random_seeds);
+  embb::base::Allocation::Delete(head);
+}
+
+template< typename Key, typename Value, typename ValuePool >
+size_t LockFreeSkipList<Key, Value, ValuePool>::GetCapacity() {
+  return capacity;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool LockFreeSkipList<Key, Value, ValuePool>::TryInsert(Key const& key,
+  Value const& value) {
+  int height = GetRandomHeight();
+  Node* node = objectPool.Allocate(key, value, height);
+
+  // Skiplist full, cannot insert
+  if (node == NULL)
+    return false;
+
+  Node* preds[Node::MAX_HEIGHT];
+  Node* succs[Node::MAX_HEIGHT];
+
+  // Link the node on the lowest level, which makes it visible
+  for (;;) {
+    Find(key, false, preds, succs);
+    if (succs[0] != NULL && !(key < succs[0]->GetKey())) {
+      // Key already contained, node was never visible to other threads.
+      ClearGuards();
+      objectPool.Free(node);
+      return false;
+    }
+    node->GetNext(0) = succs[0];
+    Node* expected = succs[0];
+    if (preds[0]->GetNext(0).CompareAndSwap(expected, node))
+      break;
+  }
+
+  // Link the node on the upper levels, stop if it has been removed
+  bool removed = false;
+  for (int level = 1; level < height && !removed; ++level) {
+    for (;;) {
+      Node* next = node->GetNext(level);
+      // Marking the next pointer fails if the node is being removed
+      if (IsMarked(next) || (next != succs[level] &&
+        !node->GetNext(level).CompareAndSwap(next, succs[level]))) {
+        removed = true;
+        break;
+      }
+      Node* expected = succs[level];
+      if (preds[level]->GetNext(level).CompareAndSwap(expected, node))
+        break;
+      Find(key, false, preds, succs);
+    }
+  }
+
+  // If the node has been removed concurrently, it might have been linked
+  // after the remover unlinked it.
+  if (IsMarked(node->GetNext(0))) {
+    Find(key, true, preds, succs);
+  }
+  ClearGuards();
+  Release(node);
+  return true;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool LockFreeSkipList<Key, Value, ValuePool>::TryErase(Key const& key) {
+  Node* preds[Node::MAX_HEIGHT];
+  Node* succs[Node::MAX_HEIGHT];
+  Find(key, false, preds, succs);
+  Node* node = succs[0];
+  if (node == NULL || key < node->GetKey()) {
+    ClearGuards();
+    return false;
+  }
+
+  // Logically delete node by marking its next pointer on the lowest level
+  Node* next = node->GetNext(0);
+  for (;;) {
+    if (IsMarked(next)) {
+      // Removed by another thread
+      ClearGuards();
+      return false;
+    }
+    if (node->GetNext(0).CompareAndSwap(next, Mark(next)))
+      break;
+  }
+
+  // Mark the upper levels, such that the inserter stops linking the node
+  // and other threads unlink it.
+  for (int level = node->GetHeight() - 1; level > 0; --level) {
+    next = node->GetNext(level);
+    while (!IsMarked(next) &&
+      !node->GetNext(level).CompareAndSwap(next, Mark(next))) {}
+  }
+
+  // Unlink the node on all levels. Searching behind key also passes a node
+  // with the same key that might have been inserted in the meantime.
+  Find(key, true, preds, succs);
+  ClearGuards();
+  Release(node);
+  return true;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool LockFreeSkipList<Key, Value, ValuePool>::Contains(Key const& key) {
+  Value value;
+  return TryFind(key, value);
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool LockFreeSkipList<Key, Value, ValuePool>::TryFind(Key const& key,
+  Value & value) {
+  Node* preds[Node::MAX_HEIGHT];
+  Node* succs[Node::MAX_HEIGHT];
+  Find(key, false, preds, succs);
+  Node* node = succs[0];
+  bool found = node != NULL && !(key < node->GetKey());
+  if (found) {
+    // node is guarded and its value is never modified
+    value = node->GetValue();
+  }
+  ClearGuards();
+  return found;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::Iterator
+LockFreeSkipList<Key, Value, ValuePool>::Begin() {
+  ElementType element;
+  Node* first = NULL;
+  for (;;) {
+    first = head->GetNext(0);
+    hazardPointer.GuardPointer(GetSuccessorGuard(0), first);
+
+    // Check if pointer is still valid after guarding.
+    if (head->GetNext(0) != first)
+      continue;
+
+    if (first == NULL || !IsMarked(first->GetNext(0)))
+      break;
+
+    // first is deleted, try to unlink it. Its successor cannot be unlinked
+    // before, as first's next pointer is marked.
+    Node* expected = first;
+    head->GetNext(0).CompareAndSwap(expected, Unmark(first->GetNext(0)));
+  }
+  if (first != NULL) {
+    element.first = first->GetKey();
+    element.second = first->GetValue();
+  }
+  ClearGuards();
+  return first != NULL ? Iterator(this, element) : Iterator();
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::Iterator
+LockFreeSkipList<Key, Value, ValuePool>::LowerBound(Key const& key) {
+  ElementType element;
+  if (GetElement(key, false, element))
+    return Iterator(this, element);
+  return Iterator();
+}
+
+template< typename Key, typename Value, typename ValuePool >
+typename LockFreeSkipList<Key, Value, ValuePool>::Iterator
+LockFreeSkipList<Key, Value, ValuePool>::End() {
+  return Iterator();
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_LOCK_FREE_SKIP_LIST_INL_H_
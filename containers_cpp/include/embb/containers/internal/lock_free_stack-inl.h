@@ -30,8 +30,9 @@
 #include <embb/base/internal/config.h>
 
 /*
- * The following algorithm uses hazard pointers and a lock-free value pool for
- * memory management. For a description of the algorithm, see
+ * The following algorithm uses hazard pointers (or epoch-based reclamation,
+ * depending on the reclamation scheme) and a lock-free value pool for memory
+ * management. For a description of the algorithm, see
  * Maged M. Michael. "Hazard pointers: Safe memory reclamation for lock-free
  * objects". IEEE Transactions on Parallel and Distributed Systems, 15.6 (2004):
  * 491-504.
@@ -61,14 +62,18 @@ namespace internal {
   }
 } // namespace internal
 
-template< typename Type, typename ValuePool >
-void LockFreeStack< Type, ValuePool >::
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+void LockFreeStack< Type, ValuePool, ReclamationScheme >::
 DeletePointerCallback(internal::LockFreeStackNode<Type>* to_delete) {
   objectPool.Free(to_delete);
 }
 
-template< typename Type, typename ValuePool >
-LockFreeStack< Type, ValuePool >::LockFreeStack(size_t capacity) :
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+LockFreeStack< Type, ValuePool, ReclamationScheme >::
+LockFreeStack(size_t capacity,
+  size_t thread_cache_size) :
 capacity(capacity),
 // Disable "this is used in base member initializer" warning.
 // We explicitly want this.
@@ -77,31 +82,36 @@ capacity(capacity),
 #pragma warning(disable:4355)
 #endif
   delete_pointer_callback(*this,
-    &LockFreeStack<Type>::DeletePointerCallback),
+    &LockFreeStack::DeletePointerCallback),
 #ifdef EMBB_PLATFORM_COMPILER_MSVC
 #pragma warning(pop)
 #endif
-  hazardPointer(delete_pointer_callback, NULL, 1),
+  reclamationScheme(delete_pointer_callback, NULL, 1),
   // Object pool, size with respect to the maximum number of retired nodes not
   // eligible for reuse:
   objectPool(
-  hazardPointer.GetRetiredListMaxSize()*
+  reclamationScheme.GetRetiredListMaxSize()*
   embb::base::Thread::GetThreadsMaxCount() +
-  capacity) {
+  capacity,
+  thread_cache_size) {
 }
 
-template< typename Type, typename ValuePool >
-size_t LockFreeStack< Type, ValuePool >::GetCapacity() {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+size_t LockFreeStack< Type, ValuePool, ReclamationScheme >::GetCapacity() {
   return capacity;
 }
 
-template< typename Type, typename ValuePool >
-LockFreeStack< Type, ValuePool >::~LockFreeStack() {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+LockFreeStack< Type, ValuePool, ReclamationScheme >::~LockFreeStack() {
   // Nothing to do here, did not allocate anything.
 }
 
-template< typename Type, typename ValuePool >
-bool LockFreeStack< Type, ValuePool >::TryPush(Type const& element) {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+bool LockFreeStack< Type, ValuePool, ReclamationScheme >::
+TryPush(Type const& element) {
   internal::LockFreeStackNode<Type>* newNode =
     objectPool.Allocate(element);
 
@@ -117,18 +127,23 @@ bool LockFreeStack< Type, ValuePool >::TryPush(Type const& element) {
   }
 }
 
-template< typename Type, typename ValuePool >
-bool LockFreeStack< Type, ValuePool >::TryPop(Type & element) {
+template< typename Type, typename ValuePool,
+  template< typename > class ReclamationScheme >
+bool LockFreeStack< Type, ValuePool, ReclamationScheme >::
+TryPop(Type & element) {
   internal::LockFreeStackNode<Type>* top_cached = top;
+  reclamationScheme.EnterCriticalRegion();
   for (;;) {
     top_cached = top;
 
     // Stack empty, cannot pop
-    if (top_cached == NULL)
+    if (top_cached == NULL) {
+      reclamationScheme.LeaveCriticalRegion();
       return false;
+    }
 
     // Guard top_cached
-    hazardPointer.GuardPointer(0, top_cached);
+    reclamationScheme.GuardPointer(0, top_cached);
 
     // Check if top is still top. If this is the case, it has not been
     // retired yet (because before retiring that thing, the retiring thread
@@ -144,16 +159,17 @@ bool LockFreeStack< Type, ValuePool >::TryPop(Type & element) {
       break;
     } else {
       // We continue with the next and can unguard top_cached
-      hazardPointer.GuardPointer(0, NULL);
+      reclamationScheme.GuardPointer(0, NULL);
     }
   }
 
   Type data = top_cached->GetElement();
 
   // We don't need to read from this reference anymore, unguard it
-  hazardPointer.GuardPointer(0, NULL);
+  reclamationScheme.GuardPointer(0, NULL);
+  reclamationScheme.LeaveCriticalRegion();
 
-  hazardPointer.EnqueuePointerForDeletion(top_cached);
+  reclamationScheme.EnqueuePointerForDeletion(top_cached);
 
   element = data;
   return true;
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_LOCK_FREE_UNBOUNDED_MPMC_QUEUE_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_LOCK_FREE_UNBOUNDED_MPMC_QUEUE_INL_H_
+
+#include <embb/base/internal/config.h>
+
+/*
+ * The following algorithm is a fetch-and-add based array queue in the
+ * spirit of
+ * Adam Morrison and Yehuda Afek. "Fast concurrent queues for x86
+ * processors". Proceedings of the 18th ACM SIGPLAN symposium on Principles
+ * and practice of parallel programming. ACM, 2013.
+ *
+ * Each segment is an array of cells. An enqueuer claims a cell by
+ * incrementing the enqueue index of the tail segment, writes its element
+ * and marks the cell as full. A dequeuer claims a cell by incrementing the
+ * dequeue index of the head segment and swaps the cell state to taken. If
+ * the dequeuer comes first, the enqueuer's CAS fails and it retries with
+ * the next cell. Once the indices exceed the segment size, a new segment is
+ * appended (enqueuers) or the head is advanced (dequeuers), as in the queue
+ * of Michael and Scott. Segments are guarded by the reclamation scheme and
+ * recycled via a stack of unused segments.
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+template< typename Type, size_t SegmentSize >
+LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::
+LockFreeUnboundedMPMCQueueSegment() :
+  free_next(NULL),
+  all_next(NULL) {
+  Reset();
+}
+
+template< typename Type, size_t SegmentSize >
+void LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::Reset() {
+  for (size_t i = 0; i != SegmentSize; ++i) {
+    states[i].Store(EMPTY);
+  }
+  enqueue_index.Store(0);
+  dequeue_index.Store(0);
+  next.Store(NULL);
+}
+
+template< typename Type, size_t SegmentSize >
+embb::base::Atomic< size_t > &
+  LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::GetEnqueueIndex() {
+  return enqueue_index;
+}
+
+template< typename Type, size_t SegmentSize >
+embb::base::Atomic< size_t > &
+  LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::GetDequeueIndex() {
+  return dequeue_index;
+}
+
+template< typename Type, size_t SegmentSize >
+embb::base::Atomic< LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>* > &
+  LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::GetNext() {
+  return next;
+}
+
+template< typename Type, size_t SegmentSize >
+LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>* &
+  LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::GetFreeNext() {
+  return free_next;
+}
+
+template< typename Type, size_t SegmentSize >
+LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>* &
+  LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::GetAllNext() {
+  return all_next;
+}
+
+template< typename Type, size_t SegmentSize >
+embb::base::Atomic< int > &
+  LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::GetState(
+  size_t index) {
+  return states[index];
+}
+
+template< typename Type, size_t SegmentSize >
+Type & LockFreeUnboundedMPMCQueueSegment<Type, SegmentSize>::GetElement(
+  size_t index) {
+  return elements[index];
+}
+} // namespace internal
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+void LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+DeletePointerCallback(Segment* to_delete) {
+  PushFreeSegment(to_delete);
+}
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+void LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+PushFreeSegment(Segment* segment) {
+  Segment* top = free_segments.Load();
+  do {
+    segment->GetFreeNext() = top;
+  } while (!free_segments.CompareAndSwap(top, segment));
+}
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+typename LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+Segment* LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+AllocateSegment() {
+  for (;;) {
+    Segment* top = free_segments.Load();
+    if (top == NULL)
+      break;
+
+    // A guarded segment cannot be pushed again, as only the reclamation
+    // scheme pushes segments. Hence, its free_next pointer is stable.
+    reclamationScheme.GuardPointer(GUARD_FREE, top);
+    if (top != free_segments.Load())
+      continue;
+
+    Segment* next = top->GetFreeNext();
+    if (free_segments.CompareAndSwap(top, next)) {
+      top->Reset();
+      return top;
+    }
+  }
+
+  return CreateSegment();
+}
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+typename LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+Segment* LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+CreateSegment() {
+  Segment* segment = embb::base::Allocation::New< Segment >();
+  // Register the segment for destruction
+  Segment* first = all_segments.Load();
+  do {
+    segment->GetAllNext() = first;
+  } while (!all_segments.CompareAndSwap(first, segment));
+  return segment;
+}
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+~LockFreeUnboundedMPMCQueue() {
+  // Segments in use, unused and retired ones are all in this list
+  Segment* segment = all_segments.Load();
+  while (segment != NULL) {
+    Segment* next = segment->GetAllNext();
+    embb::base::Allocation::Delete(segment);
+    segment = next;
+  }
+}
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+LockFreeUnboundedMPMCQueue(size_t capacity) :
+capacity(capacity),
+// Disable "this is used in base member initializer" warning.
+// We explicitly want this.
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable:4355)
+#endif
+delete_pointer_callback(*this,
+  &LockFreeUnboundedMPMCQueue::DeletePointerCallback),
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(pop)
+#endif
+  reclamationScheme(delete_pointer_callback, NULL, 2),
+  free_segments(NULL),
+  all_segments(NULL) {
+  // Initially, head and tail point to the same empty segment
+  Segment* segment = CreateSegment();
+  head = segment;
+  tail = segment;
+
+  // Prepare segments for the requested capacity
+  for (size_t i = 0; i != (capacity + SegmentSize - 1) / SegmentSize; ++i) {
+    PushFreeSegment(CreateSegment());
+  }
+}
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+size_t LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+GetCapacity() {
+  return capacity;
+}
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+bool LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+TryEnqueue(Type const& element) {
+  // Segment allocated by this thread but not yet appended to the queue
+  Segment* own_segment = NULL;
+  reclamationScheme.EnterCriticalRegion();
+  for (;;) {
+    Segment* my_tail = tail;
+    reclamationScheme.GuardPointer(GUARD_SEGMENT, my_tail);
+    // Check if pointer is still valid after guarding.
+    if (my_tail != tail) {
+      continue;
+    }
+
+    Segment* my_tail_next = my_tail->GetNext();
+    if (my_tail_next != NULL) {
+      // Tail lags behind, try to increase it first
+      tail.CompareAndSwap(my_tail, my_tail_next);
+      continue;
+    }
+
+    size_t index = my_tail->GetEnqueueIndex().FetchAndAdd(1);
+    if (index < SegmentSize) {
+      my_tail->GetElement(index) = element;
+      int expected = Segment::EMPTY;
+      // Fails if a dequeuer already skipped the cell
+      if (my_tail->GetState(index).CompareAndSwap(expected, Segment::FULL))
+        break;
+      continue;
+    }
+
+    // Segment is full, append a new one holding the element in its first
+    // cell. If another thread was faster, keep ours for the next attempt.
+    if (own_segment == NULL) {
+      own_segment = AllocateSegment();
+      own_segment->GetElement(0) = element;
+      own_segment->GetState(0).Store(Segment::FULL);
+      own_segment->GetEnqueueIndex().Store(1);
+    }
+    Segment* expected = NULL;
+    if (my_tail->GetNext().CompareAndSwap(expected, own_segment)) {
+      tail.CompareAndSwap(my_tail, own_segment);
+      own_segment = NULL;
+      break;
+    }
+  }
+  reclamationScheme.LeaveCriticalRegion();
+
+  // The element was stored elsewhere. Never pushed directly, see
+  // AllocateSegment().
+  if (own_segment != NULL) {
+    reclamationScheme.EnqueuePointerForDeletion(own_segment);
+  }
+  return true;
+}
+
+template< typename Type, size_t SegmentSize,
+  template< typename > class ReclamationScheme >
+bool LockFreeUnboundedMPMCQueue<Type, SegmentSize, ReclamationScheme>::
+TryDequeue(Type & element) {
+  reclamationScheme.EnterCriticalRegion();
+  for (;;) {
+    Segment* my_head = head;
+    reclamationScheme.GuardPointer(GUARD_SEGMENT, my_head);
+    if (my_head != head) continue;
+
+    if (my_head->GetDequeueIndex().Load() >=
+      my_head->GetEnqueueIndex().Load() &&
+      my_head->GetNext().Load() == NULL) {
+      // Queue is empty
+      reclamationScheme.LeaveCriticalRegion();
+      return false;
+    }
+
+    size_t index = my_head->GetDequeueIndex().FetchAndAdd(1);
+    if (index < SegmentSize) {
+      // Take the element or prevent the enqueuer from writing it
+      if (my_head->GetState(index).Swap(Segment::TAKEN) == Segment::FULL) {
+        element = my_head->GetElement(index);
+        break;
+      }
+      continue;
+    }
+
+    // Segment is exhausted, move on to the next one
+    Segment* my_next = my_head->GetNext();
+    if (my_next == NULL) {
+      reclamationScheme.LeaveCriticalRegion();
+      return false;
+    }
+
+    // The tail must not point to a retired segment
+    Segment* expected = my_head;
+    tail.CompareAndSwap(expected, my_next);
+
+    expected = my_head;
+    if (head.CompareAndSwap(expected, my_next)) {
+      // Retire outside of the critical region, epoch-based reclamation
+      // might wait for other threads here.
+      reclamationScheme.LeaveCriticalRegion();
+      reclamationScheme.EnqueuePointerForDeletion(my_head);
+      reclamationScheme.EnterCriticalRegion();
+    }
+  }
+  reclamationScheme.LeaveCriticalRegion();
+  return true;
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_LOCK_FREE_UNBOUNDED_MPMC_QUEUE_INL_H_
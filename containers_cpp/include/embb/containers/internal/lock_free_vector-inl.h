@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_LOCK_FREE_VECTOR_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_LOCK_FREE_VECTOR_INL_H_
+
+#include <embb/base/internal/config.h>
+
+#include <new>
+
+/*
+ * The vector is a simplification of the one by Dechev et al. ("Lock-free
+ * Dynamically Resizable Arrays", OPODIS 2006). As elements are never
+ * removed, no write descriptors are needed:
+ *
+ * - PushBack reserves an index by incrementing "reserved", allocates the
+ *   bucket of that index if nobody did so yet (the loser of the CAS frees
+ *   its bucket again), writes the element and sets the ready flag of the
+ *   slot.
+ * - Afterwards, the pushing thread advances "size" over all slots that are
+ *   ready. Since every thread sets its flag before reading "size", either
+ *   the thread of the preceding index sees the flag or the current thread
+ *   sees the advanced size, so "size" includes every push whose predecessors
+ *   have completed when the push returns. A stalled push only delays the
+ *   growth of "size", it never blocks other pushes.
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+template< typename Type >
+LockFreeVectorSlot< Type >::LockFreeVectorSlot() :
+  ready(false), element() {
+}
+
+template< typename Type >
+embb::base::Atomic< bool > & LockFreeVectorSlot< Type >::GetReady() {
+  return ready;
+}
+
+template< typename Type >
+Type & LockFreeVectorSlot< Type >::GetElement() {
+  return element;
+}
+} // namespace internal
+
+template< typename Type >
+size_t LockFreeVector< Type >::GetBucketSize(size_t bucket) {
+  return FIRST_BUCKET_SIZE << bucket;
+}
+
+template< typename Type >
+void LockFreeVector< Type >::Locate(size_t index, size_t & bucket,
+  size_t & position) {
+  // Bucket b holds the indices whose value plus FIRST_BUCKET_SIZE has its
+  // highest bit at position b + FIRST_BUCKET_BITS
+  size_t const shifted = index + FIRST_BUCKET_SIZE;
+  size_t high_bit;
+#if defined(EMBB_PLATFORM_COMPILER_GNUC)
+  high_bit = sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(
+    __builtin_clzll(static_cast<unsigned long long>(shifted)));
+#else
+  high_bit = FIRST_BUCKET_BITS;
+  while ((shifted >> (high_bit + 1)) != 0) {
+    high_bit++;
+  }
+#endif
+  bucket = high_bit - FIRST_BUCKET_BITS;
+  position = shifted ^ (static_cast<size_t>(1) << high_bit);
+}
+
+template< typename Type >
+typename LockFreeVector< Type >::Slot*
+LockFreeVector< Type >::AllocateBucket(size_t bucket) {
+  Slot* current = buckets[bucket].Load();
+  if (current != NULL) {
+    return current;
+  }
+  size_t const bucket_size = GetBucketSize(bucket);
+  Slot* new_bucket = static_cast< Slot* >(
+    embb::base::Allocation::Allocate(sizeof(Slot) * bucket_size));
+  for (size_t i = 0; i != bucket_size; ++i) {
+    new (&new_bucket[i]) Slot();
+  }
+  if (buckets[bucket].CompareAndSwap(current, new_bucket)) {
+    return new_bucket;
+  }
+  // Another thread installed the bucket first
+  for (size_t i = 0; i != bucket_size; ++i) {
+    new_bucket[i].~Slot();
+  }
+  embb::base::Allocation::Free(new_bucket);
+  return current;
+}
+
+template< typename Type >
+typename LockFreeVector< Type >::Slot &
+LockFreeVector< Type >::GetSlot(size_t index) {
+  size_t bucket, position;
+  Locate(index, bucket, position);
+  return AllocateBucket(bucket)[position];
+}
+
+template< typename Type >
+typename LockFreeVector< Type >::Slot &
+LockFreeVector< Type >::GetExistingSlot(size_t index) const {
+  size_t bucket, position;
+  Locate(index, bucket, position);
+  return buckets[bucket].Load()[position];
+}
+
+template< typename Type >
+LockFreeVector< Type >::LockFreeVector(size_t capacity) :
+  reserved(0), size(0) {
+  for (size_t i = 0; i != BUCKET_COUNT; ++i) {
+    buckets[i] = NULL;
+  }
+  if (capacity > 0) {
+    size_t last_bucket, position;
+    Locate(capacity - 1, last_bucket, position);
+    for (size_t i = 0; i <= last_bucket; ++i) {
+      AllocateBucket(i);
+    }
+  }
+}
+
+template< typename Type >
+LockFreeVector< Type >::~LockFreeVector() {
+  for (size_t i = 0; i != BUCKET_COUNT; ++i) {
+    Slot* bucket = buckets[i].Load();
+    if (bucket == NULL) {
+      continue;
+    }
+    size_t const bucket_size = GetBucketSize(i);
+    for (size_t j = 0; j != bucket_size; ++j) {
+      bucket[j].~Slot();
+    }
+    embb::base::Allocation::Free(bucket);
+  }
+}
+
+template< typename Type >
+size_t LockFreeVector< Type >::PushBack(Type const& element) {
+  size_t const index = reserved.FetchAndAdd(1);
+  Slot & slot = GetSlot(index);
+  slot.GetElement() = element;
+  slot.GetReady() = true;
+
+  // Advance the size over all completely written elements, including those
+  // of other threads that finished before their predecessors
+  size_t current = size.Load();
+  while (current < reserved.Load()) {
+    size_t bucket, position;
+    Locate(current, bucket, position);
+    Slot* current_bucket = buckets[bucket].Load();
+    if (current_bucket == NULL || !current_bucket[position].GetReady().Load()) {
+      break;
+    }
+    if (size.CompareAndSwap(current, current + 1)) {
+      current++;
+    }
+  }
+  return index;
+}
+
+template< typename Type >
+size_t LockFreeVector< Type >::GetSize() const {
+  return size.Load();
+}
+
+template< typename Type >
+Type & LockFreeVector< Type >::operator[](size_t index) {
+  return GetExistingSlot(index).GetElement();
+}
+
+template< typename Type >
+Type const & LockFreeVector< Type >::operator[](size_t index) const {
+  return GetExistingSlot(index).GetElement();
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_LOCK_FREE_VECTOR_INL_H_
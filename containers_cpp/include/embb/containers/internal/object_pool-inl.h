@@ -27,6 +27,10 @@
 #ifndef EMBB_CONTAINERS_INTERNAL_OBJECT_POOL_INL_H_
 #define EMBB_CONTAINERS_INTERNAL_OBJECT_POOL_INL_H_
 
+#include <embb/base/thread.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/base/c/internal/thread_index.h>
+
 namespace embb {
 namespace containers {
 template<class Type, typename ValuePool, class ObjectAllocator>
@@ -83,7 +87,7 @@ ReturningTrueIterator::operator!=(const self_type& rhs) {
 template<class Type, typename ValuePool, class ObjectAllocator>
 bool ObjectPool<Type, ValuePool, ObjectAllocator>::
 IsContained(const Type &obj) const {
-  if ((&obj < &objects[0]) || (&obj > &objects[capacity - 1])) {
+  if ((&obj < objects) || (&obj > GetObject(static_cast<int>(size) - 1))) {
     return false;
   } else {
     return true;
@@ -94,17 +98,62 @@ template<class Type, typename ValuePool, class ObjectAllocator>
 int ObjectPool<Type, ValuePool, ObjectAllocator>::
 GetIndexOfObject(const Type &obj) const {
   assert(IsContained(obj));
-  return(static_cast<int>(&obj - &objects[0]));
+  return static_cast<int>(
+    (reinterpret_cast<const char*>(&obj) -
+    reinterpret_cast<const char*>(objects)) / SLOT_SIZE);
+}
+
+template<class Type, typename ValuePool, class ObjectAllocator>
+Type* ObjectPool<Type, ValuePool, ObjectAllocator>::
+GetObject(int index) const {
+  return reinterpret_cast<Type*>(
+    reinterpret_cast<char*>(objects) + static_cast<size_t>(index) * SLOT_SIZE);
+}
+
+template<class Type, typename ValuePool, class ObjectAllocator>
+int* ObjectPool<Type, ValuePool, ObjectAllocator>::GetThreadCache() {
+  if (thread_caches == NULL)
+    return NULL;
+
+  unsigned int thread_index;
+  // Threads without index bypass the caches
+  if (embb_internal_thread_index(&thread_index) != EMBB_SUCCESS ||
+    thread_index >= thread_cache_count)
+    return NULL;
+
+  return &thread_caches[thread_index * thread_cache_stride];
 }
 
 template<class Type, typename ValuePool, class ObjectAllocator>
 Type* ObjectPool<Type, ValuePool, ObjectAllocator>::AllocateRaw() {
   bool val;
-  int allocated_index = p.Allocate(val);
+  int allocated_index;
+  int* cache = GetThreadCache();
+  if (cache == NULL) {
+    allocated_index = p.Allocate(val);
+  } else if (cache[0] > 0) {
+    allocated_index = cache[cache[0]];
+    --cache[0];
+  } else {
+    // Cache empty, take one element for the caller and refill half of the
+    // cache from the value pool.
+    allocated_index = p.Allocate(val);
+    if (allocated_index != -1) {
+      int refill = static_cast<int>(thread_cache_size / 2);
+      while (cache[0] < refill) {
+        int index = p.Allocate(val);
+        if (index == -1)
+          break;
+        ++cache[0];
+        cache[cache[0]] = index;
+      }
+    }
+  }
+
   if (allocated_index == -1) {
     return NULL;
   } else {
-    Type* ret_pointer = &(objects[allocated_index]);
+    Type* ret_pointer = GetObject(allocated_index);
 
     return ret_pointer;
   }
@@ -116,11 +165,46 @@ size_t ObjectPool<Type, ValuePool, ObjectAllocator>::GetCapacity() {
 }
 
 template<class Type, typename ValuePool, class ObjectAllocator>
-ObjectPool<Type, ValuePool, ObjectAllocator>::ObjectPool(size_t capacity) :
+void ObjectPool<Type, ValuePool, ObjectAllocator>::FlushThreadCache() {
+  int* cache = GetThreadCache();
+  if (cache == NULL)
+    return;
+
+  for (int i = 1; i <= cache[0]; ++i) {
+    p.Free(true, cache[i]);
+  }
+  cache[0] = 0;
+}
+
+template<class Type, typename ValuePool, class ObjectAllocator>
+ObjectPool<Type, ValuePool, ObjectAllocator>::ObjectPool(size_t capacity,
+  size_t thread_cache_size) :
 capacity(capacity),
-  p(ReturningTrueIterator(0), ReturningTrueIterator(capacity)) {
+  // Each thread cache may hold thread_cache_size elements that are not
+  // available to other threads, reserve them in addition to capacity.
+  size(capacity + thread_cache_size *
+    embb::base::Thread::GetThreadsMaxCount()),
+  allocated_count((size * SLOT_SIZE + sizeof(Type) - 1) / sizeof(Type)),
+  thread_cache_size(thread_cache_size),
+  thread_cache_count(embb::base::Thread::GetThreadsMaxCount()),
+  // Round up to full cache lines to avoid false sharing between threads
+  thread_cache_stride(
+    (thread_cache_size + 1 + EMBB_PLATFORM_CACHE_LINE_SIZE / sizeof(int) - 1) /
+    (EMBB_PLATFORM_CACHE_LINE_SIZE / sizeof(int)) *
+    (EMBB_PLATFORM_CACHE_LINE_SIZE / sizeof(int))),
+  thread_caches(NULL),
+  p(ReturningTrueIterator(0), ReturningTrueIterator(size)) {
   // Allocate the objects (without construction, just get the memory)
-  objects = objectAllocator.allocate(capacity);
+  objects = objectAllocator.allocate(allocated_count);
+
+  if (thread_cache_size > 0) {
+    thread_caches = static_cast<int*>(
+      embb::base::Allocation::AllocateCacheAligned(
+      sizeof(int) * thread_cache_stride * thread_cache_count));
+    for (unsigned int i = 0; i != thread_cache_count; ++i) {
+      thread_caches[i * thread_cache_stride] = 0;
+    }
+  }
 }
 
 template<class Type, typename ValuePool, class ObjectAllocator>
@@ -128,7 +212,26 @@ void ObjectPool<Type, ValuePool, ObjectAllocator>::Free(Type* obj) {
   int index = GetIndexOfObject(*obj);
   obj->~Type();
 
-  p.Free(true, index);
+  int* cache = GetThreadCache();
+  if (cache == NULL) {
+    p.Free(true, index);
+    return;
+  }
+
+  if (static_cast<size_t>(cache[0]) == thread_cache_size) {
+    // Cache full, return the older half to the value pool. The recently
+    // freed elements are more likely to be in the processor cache.
+    int flush = static_cast<int>((thread_cache_size + 1) / 2);
+    for (int i = 1; i <= flush; ++i) {
+      p.Free(true, cache[i]);
+    }
+    for (int i = flush + 1; i <= cache[0]; ++i) {
+      cache[i - flush] = cache[i];
+    }
+    cache[0] -= flush;
+  }
+  ++cache[0];
+  cache[cache[0]] = index;
 }
 
 template<class Type, typename ValuePool, class ObjectAllocator>
@@ -189,7 +292,11 @@ Type* ObjectPool<Type, ValuePool, ObjectAllocator>::Allocate(
 template<class Type, typename ValuePool, class ObjectAllocator>
 ObjectPool<Type, ValuePool, ObjectAllocator>::~ObjectPool() {
   // Deallocate the objects
-  objectAllocator.deallocate(objects, capacity);
+  objectAllocator.deallocate(objects, allocated_count);
+
+  if (thread_caches != NULL) {
+    embb::base::Allocation::FreeAligned(thread_caches);
+  }
 }
 } // namespace containers
 } // namespace embb
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_RELAXED_PRIORITY_QUEUE_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_RELAXED_PRIORITY_QUEUE_INL_H_
+
+#include <embb/base/internal/config.h>
+#include <embb/base/c/internal/thread_index.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+template< typename Key, typename Value >
+RelaxedPriorityQueueBuffer<Key, Value>::RelaxedPriorityQueueBuffer(
+  size_t capacity) :
+  locked(false),
+  capacity(capacity),
+  size(0) {
+  keys = static_cast<Key*>(
+    embb::base::Allocation::Allocate(sizeof(Key) * capacity));
+  values = static_cast<Value*>(
+    embb::base::Allocation::Allocate(sizeof(Value) * capacity));
+  for (size_t i = 0; i != capacity; ++i) {
+    new (static_cast<void*>(&keys[i])) Key();
+    new (static_cast<void*>(&values[i])) Value();
+  }
+}
+
+template< typename Key, typename Value >
+RelaxedPriorityQueueBuffer<Key, Value>::~RelaxedPriorityQueueBuffer() {
+  for (size_t i = 0; i != capacity; ++i) {
+    keys[i].~Key();
+    values[i].~Value();
+  }
+  embb::base::Allocation::Free(keys);
+  embb::base::Allocation::Free(values);
+}
+
+template< typename Key, typename Value >
+bool RelaxedPriorityQueueBuffer<Key, Value>::TryLock() {
+  bool expected = false;
+  return locked.CompareAndSwap(expected, true);
+}
+
+template< typename Key, typename Value >
+void RelaxedPriorityQueueBuffer<Key, Value>::Unlock() {
+  locked = false;
+}
+
+template< typename Key, typename Value >
+size_t RelaxedPriorityQueueBuffer<Key, Value>::GetSize() const {
+  return size;
+}
+
+template< typename Key, typename Value >
+bool RelaxedPriorityQueueBuffer<Key, Value>::IsFull() const {
+  return size == capacity;
+}
+
+template< typename Key, typename Value >
+Key const& RelaxedPriorityQueueBuffer<Key, Value>::GetMinKey() const {
+  assert(size > 0);
+  return keys[size - 1];
+}
+
+template< typename Key, typename Value >
+Key const& RelaxedPriorityQueueBuffer<Key, Value>::GetKey(
+  size_t index) const {
+  assert(index < size);
+  return keys[index];
+}
+
+template< typename Key, typename Value >
+Value const& RelaxedPriorityQueueBuffer<Key, Value>::GetValue(
+  size_t index) const {
+  assert(index < size);
+  return values[index];
+}
+
+template< typename Key, typename Value >
+void RelaxedPriorityQueueBuffer<Key, Value>::Insert(Key const& key,
+  Value const& value) {
+  assert(size < capacity);
+  // Insertion sort, the buffer is small
+  size_t index = size;
+  while (index > 0 && keys[index - 1] < key) {
+    keys[index] = keys[index - 1];
+    values[index] = values[index - 1];
+    --index;
+  }
+  keys[index] = key;
+  values[index] = value;
+  ++size;
+}
+
+template< typename Key, typename Value >
+void RelaxedPriorityQueueBuffer<Key, Value>::RemoveMin(Key & key,
+  Value & value) {
+  assert(size > 0);
+  --size;
+  key = keys[size];
+  value = values[size];
+}
+
+template< typename Key, typename Value >
+void RelaxedPriorityQueueBuffer<Key, Value>::RemoveLargest(size_t count) {
+  assert(count <= size);
+  for (size_t index = count; index != size; ++index) {
+    keys[index - count] = keys[index];
+    values[index - count] = values[index];
+  }
+  size -= count;
+}
+} // namespace internal
+
+template< typename Key, typename Value, typename ValuePool >
+unsigned int RelaxedPriorityQueue<Key, Value, ValuePool>::
+GetCurrentThreadIndex() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+
+  if (return_val != EMBB_SUCCESS)
+    EMBB_THROW(embb::base::ErrorException, "Could not get thread id!");
+
+  return thread_index;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+void RelaxedPriorityQueue<Key, Value, ValuePool>::Spill(Buffer& buffer) {
+  size_t count = (buffer.GetSize() + 1) / 2;
+  size_t moved = 0;
+  // The largest elements are at the front of the buffer
+  while (moved != count &&
+    shared_queue.TryInsert(buffer.GetKey(moved), buffer.GetValue(moved))) {
+    ++moved;
+  }
+  buffer.RemoveLargest(moved);
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool RelaxedPriorityQueue<Key, Value, ValuePool>::TrySteal(
+  unsigned int thread_index, Key & key, Value & value) {
+  for (unsigned int i = 1; i < buffer_count; ++i) {
+    Buffer& buffer = *buffers[(thread_index + i) % buffer_count];
+    // Skip buffers that are accessed by other threads
+    if (!buffer.TryLock())
+      continue;
+    bool stolen = false;
+    if (buffer.GetSize() > 0) {
+      buffer.RemoveMin(key, value);
+      stolen = true;
+    }
+    buffer.Unlock();
+    if (stolen)
+      return true;
+  }
+  return false;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+RelaxedPriorityQueue<Key, Value, ValuePool>::RelaxedPriorityQueue(
+  size_t capacity, size_t relaxation) :
+  capacity(capacity),
+  relaxation(relaxation > 0 ? relaxation : 1),
+  shared_queue(capacity),
+  buffer_count(embb::base::Thread::GetThreadsMaxCount()) {
+  buffers = static_cast<Buffer**>(
+    embb::base::Allocation::Allocate(sizeof(Buffer*) * buffer_count));
+
+  for (unsigned int i = 0; i != buffer_count; ++i) {
+    buffers[i] = static_cast<Buffer*>(
+      embb::base::Allocation::AllocateCacheAligned(sizeof(Buffer)));
+    new (static_cast<void*>(buffers[i])) Buffer(this->relaxation);
+  }
+}
+
+template< typename Key, typename Value, typename ValuePool >
+RelaxedPriorityQueue<Key, Value, ValuePool>::~RelaxedPriorityQueue() {
+  for (unsigned int i = 0; i != buffer_count; ++i) {
+    buffers[i]->~Buffer();
+    embb::base::Allocation::FreeAligned(buffers[i]);
+  }
+  embb::base::Allocation::Free(static_cast< void* >(buffers));
+}
+
+template< typename Key, typename Value, typename ValuePool >
+size_t RelaxedPriorityQueue<Key, Value, ValuePool>::GetCapacity() {
+  return capacity;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+size_t RelaxedPriorityQueue<Key, Value, ValuePool>::GetRelaxation() {
+  return relaxation;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool RelaxedPriorityQueue<Key, Value, ValuePool>::TryInsert(Key const& key,
+  Value const& value) {
+  Buffer& buffer = *buffers[GetCurrentThreadIndex()];
+
+  // Another thread is stealing from the buffer, bypass it.
+  if (!buffer.TryLock())
+    return shared_queue.TryInsert(key, value);
+
+  if (buffer.IsFull()) {
+    Spill(buffer);
+  }
+  bool result = true;
+  if (!buffer.IsFull()) {
+    buffer.Insert(key, value);
+  } else {
+    // The shared queue is full as well
+    result = shared_queue.TryInsert(key, value);
+  }
+  buffer.Unlock();
+  return result;
+}
+
+template< typename Key, typename Value, typename ValuePool >
+bool RelaxedPriorityQueue<Key, Value, ValuePool>::TryDeleteMin(Key & key,
+  Value & value) {
+  unsigned int thread_index = GetCurrentThreadIndex();
+  Buffer& buffer = *buffers[thread_index];
+
+  if (buffer.TryLock()) {
+    if (buffer.GetSize() > 0) {
+      // Prefer the shared queue only if its minimum is smaller
+      Key shared_min;
+      if (!shared_queue.TryGetMin(shared_min) ||
+        !(shared_min < buffer.GetMinKey()) ||
+        !shared_queue.TryDeleteMin(key, value)) {
+        buffer.RemoveMin(key, value);
+      }
+      buffer.Unlock();
+      return true;
+    }
+    buffer.Unlock();
+  }
+
+  if (shared_queue.TryDeleteMin(key, value))
+    return true;
+
+  return TrySteal(thread_index, key, value);
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_RELAXED_PRIORITY_QUEUE_INL_H_
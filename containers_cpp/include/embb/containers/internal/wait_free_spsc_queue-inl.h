@@ -51,7 +51,7 @@ size_t WaitFreeSPSCQueue<Type, Allocator>::GetCapacity() {
 
 template<typename Type, class Allocator>
 bool WaitFreeSPSCQueue<Type, Allocator>::TryEnqueue(Type const & element) {
-  if (head_index - tail_index == capacity)
+  if (tail_index - head_index == capacity)
     return false;
 
   queue_array[tail_index % capacity] = element;
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_WORK_STEALING_DEQUE_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_WORK_STEALING_DEQUE_INL_H_
+
+#include <cstddef>
+
+/*
+ * The following algorithm is described in:
+ * David Chase and Yossi Lev. "Dynamic circular work-stealing deque".
+ * Proceedings of the seventeenth annual ACM symposium on Parallelism in
+ * algorithms and architectures. ACM, 2005.
+ *
+ * The memory orderings follow
+ * Nhat Minh Le, Antoniu Pop, Albert Cohen, and Francesco Zappa Nardelli.
+ * "Correct and efficient work-stealing for weak memory models". Proceedings
+ * of the 18th ACM SIGPLAN symposium on Principles and practice of parallel
+ * programming. ACM, 2013.
+ * Since all atomic operations of embb::base::Atomic are sequentially
+ * consistent, no explicit fences are required.
+ *
+ * Indices grow monotonically and may wrap around, so the number of elements
+ * is computed as the signed difference of bottom and top.
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+template< typename Type >
+WorkStealingDequeArray<Type>::WorkStealingDequeArray(size_t capacity,
+  Type* elements, WorkStealingDequeArray* previous) :
+  capacity(capacity),
+  elements(elements),
+  previous(previous) {
+}
+
+template< typename Type >
+size_t WorkStealingDequeArray<Type>::GetCapacity() const {
+  return capacity;
+}
+
+template< typename Type >
+WorkStealingDequeArray<Type>* WorkStealingDequeArray<Type>::GetPrevious()
+  const {
+  return previous;
+}
+
+template< typename Type >
+Type* WorkStealingDequeArray<Type>::GetElements() const {
+  return elements;
+}
+
+template< typename Type >
+Type & WorkStealingDequeArray<Type>::Get(size_t index) {
+  return elements[index & (capacity - 1)];
+}
+
+template< typename Type >
+void WorkStealingDequeArray<Type>::Put(size_t index, Type const& element) {
+  elements[index & (capacity - 1)] = element;
+}
+} // namespace internal
+
+template< typename Type, class Allocator >
+typename WorkStealingDeque<Type, Allocator>::Array*
+WorkStealingDeque<Type, Allocator>::NewArray(size_t capacity,
+  Array* previous) {
+  Type* elements = allocator.allocate(capacity);
+  for (size_t i = 0; i != capacity; ++i) {
+    allocator.construct(elements + i, Type());
+  }
+  return embb::base::Allocation::New< Array >(capacity, elements, previous);
+}
+
+template< typename Type, class Allocator >
+typename WorkStealingDeque<Type, Allocator>::Array*
+WorkStealingDeque<Type, Allocator>::Grow(Array* current, size_t top_index,
+  size_t bottom_index) {
+  Array* grown = NewArray(current->GetCapacity() * 2, current);
+  for (size_t i = top_index; i != bottom_index; ++i) {
+    grown->Put(i, current->Get(i));
+  }
+  // Thieves still reading from the current array get valid elements, as
+  // the owner only writes to the new array from now on.
+  array.Store(grown);
+  return grown;
+}
+
+template< typename Type, class Allocator >
+WorkStealingDeque<Type, Allocator>::WorkStealingDeque(size_t capacity) :
+  top(0),
+  bottom(0) {
+  size_t array_capacity = 1;
+  while (array_capacity < capacity) {
+    array_capacity <<= 1;
+  }
+  array = NewArray(array_capacity, NULL);
+}
+
+template< typename Type, class Allocator >
+WorkStealingDeque<Type, Allocator>::~WorkStealingDeque() {
+  Array* current = array.Load();
+  while (current != NULL) {
+    Array* previous = current->GetPrevious();
+    Type* elements = current->GetElements();
+    for (size_t i = 0; i != current->GetCapacity(); ++i) {
+      allocator.destroy(elements + i);
+    }
+    allocator.deallocate(elements, current->GetCapacity());
+    embb::base::Allocation::Delete(current);
+    current = previous;
+  }
+}
+
+template< typename Type, class Allocator >
+size_t WorkStealingDeque<Type, Allocator>::GetCapacity() {
+  return array.Load()->GetCapacity();
+}
+
+template< typename Type, class Allocator >
+void WorkStealingDeque<Type, Allocator>::PushBottom(Type const& element) {
+  size_t bottom_index = bottom.Load();
+  size_t top_index = top.Load();
+  Array* current = array.Load();
+  if (bottom_index - top_index >= current->GetCapacity()) {
+    current = Grow(current, top_index, bottom_index);
+  }
+  current->Put(bottom_index, element);
+  // Publish the element to the thieves
+  bottom.Store(bottom_index + 1);
+}
+
+template< typename Type, class Allocator >
+bool WorkStealingDeque<Type, Allocator>::TryPopBottom(Type & element) {
+  size_t bottom_index = bottom.Load() - 1;
+  Array* current = array.Load();
+  // Reserve the bottommost element before reading top, thieves that read
+  // bottom afterwards do not take it.
+  bottom.Store(bottom_index);
+  size_t top_index = top.Load();
+
+  ptrdiff_t size = static_cast<ptrdiff_t>(bottom_index - top_index);
+  if (size < 0) {
+    // Deque was empty, restore bottom
+    bottom.Store(bottom_index + 1);
+    return false;
+  }
+
+  Type popped = current->Get(bottom_index);
+  if (size > 0) {
+    // More than one element, no conflict with thieves possible
+    element = popped;
+    return true;
+  }
+
+  // Last element, compete with the thieves for it
+  bool success = top.CompareAndSwap(top_index, top_index + 1);
+  bottom.Store(bottom_index + 1);
+  if (success) {
+    element = popped;
+  }
+  return success;
+}
+
+template< typename Type, class Allocator >
+bool WorkStealingDeque<Type, Allocator>::TrySteal(Type & element) {
+  size_t top_index = top.Load();
+  size_t bottom_index = bottom.Load();
+  if (static_cast<ptrdiff_t>(bottom_index - top_index) <= 0) {
+    return false;
+  }
+
+  Array* current = array.Load();
+  Type stolen = current->Get(top_index);
+  // Fails if the owner or another thief took the element
+  if (!top.CompareAndSwap(top_index, top_index + 1)) {
+    return false;
+  }
+  element = stolen;
+  return true;
+}
+} // namespace containers
+} // namespace embb
+
+#endif  // EMBB_CONTAINERS_INTERNAL_WORK_STEALING_DEQUE_INL_H_
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTRUSIVE_MPSC_QUEUE_H_
+#define EMBB_CONTAINERS_INTRUSIVE_MPSC_QUEUE_H_
+
+#include <embb/base/atomic.h>
+
+#include <stddef.h>
+
+namespace embb {
+namespace containers {
+template< typename Type >
+class IntrusiveMPSCQueue;
+
+/**
+ * Base class for elements of an IntrusiveMPSCQueue
+ *
+ * Holds the link to the next element. An element can be contained in at
+ * most one queue at a time.
+ *
+ * \ingroup CPP_CONTAINERS_QUEUES
+ */
+class IntrusiveMPSCQueueNode {
+ private:
+  /**
+   * Pointer to the next node in the queue
+   */
+  embb::base::Atomic< IntrusiveMPSCQueueNode* > next;
+
+  template< typename Type >
+  friend class IntrusiveMPSCQueue;
+
+ public:
+  /**
+   * Creates an unlinked node.
+   */
+  IntrusiveMPSCQueueNode() : next(NULL) {}
+
+  /**
+   * Creates an unlinked node, the link of \c other is not copied.
+   */
+  IntrusiveMPSCQueueNode(
+    const IntrusiveMPSCQueueNode&
+    /**< [IN] Node to copy from */) : next(NULL) {}
+
+  /**
+   * Keeps the link of this node, as it belongs to the queue.
+   *
+   * \return Reference to this node
+   */
+  IntrusiveMPSCQueueNode& operator=(
+    const IntrusiveMPSCQueueNode&
+    /**< [IN] Node to assign from */) {
+    return *this;
+  }
+};
+
+/**
+ * Intrusive queue for multiple producers and a single consumer
+ *
+ * The queue links the elements themselves instead of copying them into
+ * nodes, so it neither allocates memory nor has a capacity limit. Elements
+ * derive from IntrusiveMPSCQueueNode and remain owned by the caller.
+ *
+ * Enqueuing consists of a single atomic swap. Since only one thread
+ * dequeues, no memory reclamation scheme such as hazard pointers is needed.
+ * Dequeuing never waits for producers, but as long as a producer has
+ * swapped in its element without linking it yet, the elements behind it are
+ * not visible to the consumer.
+ *
+ * \ingroup CPP_CONTAINERS_QUEUES
+ *
+ * \see LockFreeMPMCQueue
+ *
+ * \tparam Type Type of the queue elements, must be derived from
+ *         IntrusiveMPSCQueueNode
+ */
+template< typename Type >
+class IntrusiveMPSCQueue {
+ private:
+  typedef IntrusiveMPSCQueueNode Node;
+
+  /**
+   * Most recently enqueued node, modified by the producers
+   */
+  embb::base::Atomic< Node* > head;
+
+  /**
+   * Oldest node, only accessed by the consumer
+   */
+  Node* tail;
+
+  /**
+   * Dummy node that keeps the queue non-empty
+   */
+  Node stub;
+
+  /**
+   * Links \c node at the head of the queue.
+   */
+  void Push(
+    Node* node
+    /**< [IN] Node to link */);
+
+  // Prevent copy-construction
+  IntrusiveMPSCQueue(const IntrusiveMPSCQueue&);
+
+  // Prevent assignment
+  IntrusiveMPSCQueue& operator=(const IntrusiveMPSCQueue&);
+
+ public:
+  /**
+   * Creates an empty queue.
+   *
+   * \memory No dynamic memory is allocated.
+   *
+   * \notthreadsafe
+   */
+  IntrusiveMPSCQueue();
+
+  /**
+   * Appends an element to the queue.
+   *
+   * \pre \c element is not contained in a queue.
+   *
+   * \waitfree
+   */
+  void Enqueue(
+    Type* element
+    /**< [IN] Pointer to the element, must stay valid until dequeued */);
+
+  /**
+   * Tries to remove the oldest element from the queue.
+   *
+   * \return Pointer to the element, or \c NULL if the queue is empty or the
+   *         oldest element is still being enqueued
+   *
+   * \waitfree
+   *
+   * \note Must only be called by one thread at a time.
+   */
+  Type* TryDequeue();
+
+  /**
+   * Tries to remove up to \c max_elements elements from the queue in FIFO
+   * order. Stops at the first element that cannot be dequeued.
+   *
+   * \return Number of elements stored in \c elements
+   *
+   * \waitfree
+   *
+   * \note Must only be called by one thread at a time.
+   */
+  size_t TryDequeueBatch(
+    Type** elements,
+    /**< [OUT] Array receiving the dequeued elements */
+    size_t max_elements
+    /**< [IN] Capacity of \c elements */);
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/intrusive_mpsc_queue-inl.h>
+
+#endif  // EMBB_CONTAINERS_INTRUSIVE_MPSC_QUEUE_H_
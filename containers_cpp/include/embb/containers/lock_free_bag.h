@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_BAG_H_
+#define EMBB_CONTAINERS_LOCK_FREE_BAG_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/function.h>
+
+#include <embb/containers/lock_free_stack.h>
+#include <embb/containers/lock_free_tree_value_pool.h>
+#include <embb/containers/object_pool.h>
+#include <embb/containers/internal/hazard_pointer.h>
+#include <embb/containers/internal/epoch_reclamation.h>
+
+/**
+ * \defgroup CPP_CONTAINERS_BAGS Bags
+ * Concurrent unordered collections
+ *
+ * \ingroup CPP_CONTAINERS
+ */
+
+namespace embb {
+namespace containers {
+/**
+ * Lock-free bag
+ *
+ * Unordered collection of elements. Each thread adds elements to its own
+ * list and takes elements from its own list first. Only if that list is
+ * empty, it steals from the lists of other threads. As there is no global
+ * ordering, threads adding and taking elements mostly operate on distinct
+ * cache lines, e.g., when recycling buffers.
+ *
+ * \ingroup CPP_CONTAINERS_BAGS
+ *
+ * \see LockFreeStack, LockFreeMPMCQueue
+ *
+ * \tparam Type Type of the elements
+ * \tparam ValuePool Type of the value pool used as basis for the ObjectPool
+ *         which stores the elements.
+ * \tparam ReclamationScheme Memory reclamation scheme for taken nodes,
+ *         either internal::HazardPointer (default) or
+ *         internal::EpochReclamation.
+ */
+template< typename Type,
+  typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false >,
+  template< typename > class ReclamationScheme = internal::HazardPointer >
+class LockFreeBag {
+ private:
+  /**
+   * Node of a per-thread list
+   */
+  typedef internal::LockFreeStackNode< Type > Node;
+
+  /**
+   * The capacity of the bag. It is guaranteed that the bag can hold at
+   * least as many elements, maybe more.
+   */
+  size_t capacity;
+
+  /**
+   * Callback to the method that is called by the reclamation scheme if a
+   * pointer is not hazardous anymore, i.e., can safely be reused.
+   */
+  embb::base::Function< void, Node* > delete_pointer_callback;
+
+  /**
+   * The reclamation scheme object, used for memory management.
+   */
+  ReclamationScheme< Node* > reclamationScheme;
+
+  /**
+   * The object pool, used for lock-free memory allocation.
+   */
+  ObjectPool< Node, ValuePool > objectPool;
+
+  /**
+   * Number of per-thread lists
+   */
+  unsigned int list_count;
+
+  /**
+   * Distance between the heads of two lists in \c heads, one cache line
+   */
+  size_t list_stride;
+
+  /**
+   * Heads of the per-thread lists, each on its own cache line
+   */
+  embb::base::Atomic< Node* >* heads;
+
+  /**
+   * The callback function, used to cleanup non-hazardous pointers.
+   * \see delete_pointer_callback
+   */
+  void DeletePointerCallback(Node* to_delete);
+
+  /**
+   * Returns the index of the list of the calling thread.
+   *
+   * \return List index, 0 for threads without thread index
+   */
+  unsigned int GetOwnList();
+
+  /**
+   * Tries to take an element from the specified list.
+   *
+   * \return \c true if an element could be taken, \c false if the list is
+   *         empty.
+   */
+  bool TryTakeFrom(
+    unsigned int list,
+    /**< [IN] Index of the list */
+    Type & element
+    /**< [IN, OUT] Reference to the taken element */);
+
+  // Prevent copy-construction
+  LockFreeBag(const LockFreeBag&);
+
+  // Prevent assignment
+  LockFreeBag& operator=(const LockFreeBag&);
+
+ public:
+  /**
+   * Creates a bag with the specified capacity.
+   *
+   * \memory
+   * Let \c t be the maximum number of threads and \c x be <tt>1.25*t+1</tt>.
+   * Then, <tt>x*(3*t+1)</tt> elements of size <tt>sizeof(void*)</tt>, \c x
+   * elements of size <tt>sizeof(Type)</tt>, and \c capacity elements of size
+   * <tt>sizeof(Type)</tt> are allocated. In addition, one cache line is
+   * allocated for each thread.
+   * With thread caches, <tt>t*thread_cache_size</tt> additional nodes are
+   * allocated, so the caches never reduce the capacity.
+   *
+   * \notthreadsafe
+   */
+  explicit LockFreeBag(
+    size_t capacity,
+    /**< [IN] Capacity of the bag */
+    size_t thread_cache_size = 0
+    /**< [IN] Maximum number of free nodes each thread keeps for itself,
+              see ObjectPool. 0 disables the thread caches. */);
+
+  /**
+   * Destroys the bag.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreeBag();
+
+  /**
+   * Returns the capacity of the bag.
+   *
+   * \return Number of elements the bag can hold.
+   *
+   * \waitfree
+   */
+  size_t GetCapacity();
+
+  /**
+   * Tries to add an element to the bag.
+   *
+   * \return \c true if the element could be added, \c false if the bag is
+   *         full.
+   *
+   * \lockfree
+   *
+   * \note It might be possible to add more elements to the bag than its
+   * capacity permits.
+   */
+  bool TryAdd(
+    Type const& element
+    /**< [IN] Const reference to the element that shall be added */);
+
+  /**
+   * Tries to take an arbitrary element from the bag.
+   *
+   * Elements added by the calling thread are preferred. The lists of the
+   * other threads are visited one after another, so the operation may fail
+   * if elements are added concurrently to lists already visited.
+   *
+   * \return \c true if an element could be taken, \c false if the bag is
+   *         empty.
+   *
+   * \lockfree
+   */
+  bool TryTake(
+    Type & element
+    /**< [IN, OUT] Reference to the taken element. Unchanged, if the
+                   operation was not successful. */);
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_bag-inl.h>
+
+#endif  // EMBB_CONTAINERS_LOCK_FREE_BAG_H_
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_BITMAP_VALUE_POOL_H_
+#define EMBB_CONTAINERS_LOCK_FREE_BITMAP_VALUE_POOL_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/memory_allocation.h>
+
+namespace embb {
+namespace containers {
+/**
+ * Value pool using a bitmap of free elements
+ *
+ * The pool keeps one bit per element (set if the element is free), packed
+ * into machine words, i.e., 64 elements per word on 64-bit platforms.
+ * Allocate() searches the first set bit of a word using a single processor
+ * instruction and claims it with a CAS, which makes it lock-free. Free() is
+ * wait-free. Each thread starts its search at the word it used last, so
+ * that concurrent allocators are spread across the bitmap instead of
+ * contending for the first elements.
+ *
+ * \concept{CPP_CONCEPTS_VALUE_POOL}
+ *
+ * \ingroup CPP_CONTAINERS_POOLS
+ *
+ * \see WaitFreeArrayValuePool, LockFreeTreeValuePool
+ *
+ * \tparam Type Element type
+ * \tparam Undefined Bottom element (cannot be stored in the pool)
+ * \tparam PoolAllocator Allocator used to allocate the pool array
+ * \tparam BitmapAllocator Allocator used to allocate the bitmap words
+ */
+template<typename Type,
+  Type Undefined,
+  class PoolAllocator = embb::base::Allocator< Type >,
+  class BitmapAllocator = embb::base::Allocator< embb::base::Atomic<size_t> >
+>
+class LockFreeBitmapValuePool {
+ private:
+  /**
+   * Number of elements represented by one bitmap word
+   */
+  static const size_t BITS_PER_WORD = sizeof(size_t) * 8;
+
+  /**
+   * Distance between the hints of two threads, one cache line
+   */
+  static const size_t HINT_STRIDE =
+    EMBB_PLATFORM_CACHE_LINE_SIZE / sizeof(size_t);
+
+  /**
+   * Number of elements in the pool
+   */
+  int size;
+
+  /**
+   * Number of bitmap words
+   */
+  size_t word_count;
+
+  /**
+   * The elements of the pool
+   */
+  Type* pool;
+
+  /**
+   * Bitmap of free elements, bit \c i of word \c w is set if element
+   * <tt>w*BITS_PER_WORD+i</tt> is in the pool
+   */
+  embb::base::Atomic<size_t>* bitmap;
+
+  /**
+   * Number of threads having a search hint
+   */
+  unsigned int hint_count;
+
+  /**
+   * Per-thread index of the bitmap word to start searching at, each on its
+   * own cache line
+   */
+  size_t* hints;
+
+  PoolAllocator pool_allocator;
+  BitmapAllocator bitmap_allocator;
+
+  LockFreeBitmapValuePool();
+
+  // Prevent copy-construction
+  LockFreeBitmapValuePool(const LockFreeBitmapValuePool&);
+
+  // Prevent assignment
+  LockFreeBitmapValuePool& operator=(const LockFreeBitmapValuePool&);
+
+  /**
+   * Returns the search hint of the calling thread.
+   *
+   * \return Pointer to the hint or \c NULL, if the thread has no index
+   */
+  size_t* GetHint();
+
+  /**
+   * Returns the position of the least significant set bit.
+   *
+   * \pre \c word is not zero
+   */
+  static size_t FindFirstSet(
+    size_t word
+    /**< [IN] Bitmap word */
+  );
+
+ public:
+  /**
+   * Constructs a pool and fills it with the elements in the specified range.
+   *
+   * \memory Dynamically allocates <tt>n*sizeof(Type)</tt> bytes for the
+   *         elements and <tt>ceil(n/w)*sizeof(embb::base::Atomic<size_t>)
+   *         </tt> bytes for the bitmap, where
+   *         <tt>n = std::distance(first, last)</tt> is the number of pool
+   *         elements and \c w is the number of bits of \c size_t. In
+   *         addition, one cache line is allocated for each thread.
+   *
+   * \notthreadsafe
+   *
+   * \see CPP_CONCEPTS_VALUE_POOL
+   */
+  template<typename ForwardIterator>
+  LockFreeBitmapValuePool(
+    ForwardIterator first,
+    /**< [IN] Iterator pointing to the first element of the range the pool is
+              filled with */
+    ForwardIterator last
+    /**< [IN] Iterator pointing to the last plus one element of the range the
+              pool is filled with */
+  );
+
+  /**
+   * Destructs the pool.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreeBitmapValuePool();
+
+  /**
+   * Allocates an element from the pool.
+   *
+   * \return Index of the element if the pool is not empty, otherwise \c -1.
+   *
+   * \lockfree
+   *
+   * \see CPP_CONCEPTS_VALUE_POOL
+   */
+  int Allocate(
+    Type & element
+    /**< [IN,OUT] Reference to the allocated element. Unchanged, if the
+                  operation was not successful. */
+  );
+
+  /**
+   * Returns an element to the pool.
+   *
+   * \note The element must have been allocated with Allocate().
+   *
+   * \waitfree
+   *
+   * \see CPP_CONCEPTS_VALUE_POOL
+   */
+  void Free(
+    Type element,
+    /**< [IN] Element to be returned to the pool */
+    int index
+    /**< [IN] Index of the element as obtained by Allocate() */
+  );
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_bitmap_value_pool-inl.h>
+
+#endif  // EMBB_CONTAINERS_LOCK_FREE_BITMAP_VALUE_POOL_H_
@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_HASH_MAP_H_
+#define EMBB_CONTAINERS_LOCK_FREE_HASH_MAP_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/function.h>
+
+#include <embb/containers/lock_free_tree_value_pool.h>
+#include <embb/containers/object_pool.h>
+#include <embb/containers/internal/hazard_pointer.h>
+
+/**
+ * \defgroup CPP_CONTAINERS_MAPS Maps
+ * Concurrent associative containers
+ *
+ * \ingroup CPP_CONTAINERS
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Hash map node
+ *
+ * Node of the split-ordered list, contains the key (\c key), the value
+ * (\c value), the split-order key (\c so_key), and a pointer to the next node
+ * (\c next). The lowest bit of the next pointer marks the node as logically
+ * deleted.
+ *
+ * \tparam Key Key type
+ * \tparam Value Value type
+ */
+template< typename Key, typename Value >
+class LockFreeHashMapNode {
+ private:
+  /**
+   * Pointer to the next node, lowest bit is the deletion mark
+   */
+  embb::base::Atomic< LockFreeHashMapNode< Key, Value >* > next;
+
+  /**
+   * Bit-reversed hash, determines the position in the list
+   */
+  size_t so_key;
+
+  /**
+   * The stored key
+   */
+  Key key;
+
+  /**
+   * The stored value
+   */
+  Value value;
+
+ public:
+  /**
+   * Creates a dummy node marking the start of a bucket
+   */
+  explicit LockFreeHashMapNode(
+    size_t so_key
+    /**< [IN] Split-order key of the bucket */);
+
+  /**
+   * Creates a node holding a key/value pair
+   */
+  LockFreeHashMapNode(
+    size_t so_key,
+    /**< [IN] Split-order key of the element */
+    Key const& key,
+    /**< [IN] The key of this node */
+    Value const& value
+    /**< [IN] The value of this node */);
+
+  /**
+   * Returns the next pointer
+   *
+   * \return The next pointer
+   */
+  embb::base::Atomic< LockFreeHashMapNode< Key, Value >* > & GetNext();
+
+  /**
+   * Returns the split-order key
+   */
+  size_t GetSplitOrderKey() const;
+
+  /**
+   * Returns \c true if the node is a bucket start, otherwise \c false
+   */
+  bool IsDummy() const;
+
+  /**
+   * Returns the key held by this node
+   */
+  Key const& GetKey() const;
+
+  /**
+   * Returns the value held by this node
+   */
+  Value const& GetValue() const;
+};
+} // namespace internal
+
+/**
+ * Default hash function of the lock-free hash map. Converts integral keys to
+ * \c size_t.
+ *
+ * \ingroup CPP_CONTAINERS_MAPS
+ *
+ * \tparam Key Key type, must be convertible to \c size_t
+ */
+template< typename Key >
+struct LockFreeHashMapHash {
+  /**
+   * Computes the hash of \c key.
+   *
+   * \return Hash value
+   */
+  size_t operator()(
+    Key const& key
+    /**< [IN] Key to hash */) const {
+    return static_cast<size_t>(key);
+  }
+};
+
+/**
+ * Lock-free hash map
+ *
+ * Implements a split-ordered list as presented in:
+ *
+ * Ori Shalev and Nir Shavit. "Split-ordered lists: Lock-free extensible hash
+ * tables." Journal of the ACM 53.3 (2006): 379-405.
+ *
+ * All elements are stored in a single lock-free linked list (Maged M.
+ * Michael. "High performance dynamic lock-free hash tables and list-based
+ * sets." SPAA 2002), sorted by their bit-reversed hash. Buckets are shortcuts
+ * into this list. When the load factor is exceeded, the number of buckets is
+ * doubled. The new buckets are initialized lazily on first access by
+ * splitting their parent bucket, so resizing never moves elements and never
+ * blocks concurrent operations.
+ *
+ * As the other containers, the hash map only allocates memory at
+ * construction. The bucket array is sized for \c capacity elements, and nodes
+ * are taken from an ObjectPool and reclaimed using hazard pointers.
+ *
+ * \ingroup CPP_CONTAINERS_MAPS
+ *
+ * \tparam Key Type of the keys, must be default and copy constructible and
+ *         equality comparable
+ * \tparam Value Type of the values, must be default and copy constructible
+ * \tparam Hash Hash function object type, maps keys to \c size_t
+ * \tparam ValuePool Type of the value pool used as basis for the ObjectPool
+ *         which stores the elements.
+ */
+template< typename Key,
+  typename Value,
+  class Hash = LockFreeHashMapHash< Key >,
+  typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false >
+>
+class LockFreeHashMap {
+ private:
+  /**
+   * Node type of the underlying list
+   */
+  typedef internal::LockFreeHashMapNode< Key, Value > Node;
+
+  /**
+   * Maximum average number of elements per bucket before the number of
+   * buckets is doubled
+   */
+  static const size_t MAX_LOAD_FACTOR = 2;
+
+  /**
+   * Position of the guard for the next node during traversal
+   */
+  static const int GUARD_NEXT = 0;
+
+  /**
+   * Position of the guard for the current node during traversal
+   */
+  static const int GUARD_CURRENT = 1;
+
+  /**
+   * Position of the guard for the predecessor node during traversal
+   */
+  static const int GUARD_PREVIOUS = 2;
+
+  /**
+   * The capacity of the hash map. It is guaranteed that the map can hold at
+   * least as many elements, maybe more.
+   */
+  size_t capacity;
+
+  /**
+   * Maximum number of buckets (power of two)
+   */
+  size_t max_bucket_count;
+
+  /**
+   * Hash function object
+   */
+  Hash hash;
+
+  /**
+   * Callback to the method that is called by hazard pointers if a pointer is
+   * not hazardous anymore, i.e., can safely be reused.
+   */
+  embb::base::Function < void, Node* > delete_pointer_callback;
+
+  /**
+   * The hazard pointer object, used for memory management.
+   */
+  internal::HazardPointer< Node* > hazardPointer;
+
+  /**
+   * The object pool, used for lock-free memory allocation.
+   */
+  ObjectPool< Node, ValuePool > objectPool;
+
+  /**
+   * Array of bucket start nodes, \c NULL for uninitialized buckets
+   */
+  embb::base::Atomic< Node* >* buckets;
+
+  /**
+   * Current number of buckets (power of two)
+   */
+  embb::base::Atomic< size_t > bucket_count;
+
+  /**
+   * Number of elements in the map
+   */
+  embb::base::Atomic< size_t > element_count;
+
+  /**
+   * The callback function, used to cleanup non-hazardous pointers.
+   * \see delete_pointer_callback
+   */
+  void DeletePointerCallback(Node* to_delete);
+
+  /**
+   * Reverses the bits of \c value.
+   *
+   * \return Bit-reversed value
+   */
+  static size_t ReverseBits(size_t value);
+
+  /**
+   * Computes the split-order key of an element with hash \c hash_value.
+   * The lowest bit is set, such that elements are placed behind the dummy
+   * node of their bucket.
+   */
+  static size_t GetRegularSplitOrderKey(size_t hash_value);
+
+  /**
+   * Computes the split-order key of the dummy node of \c bucket.
+   */
+  static size_t GetDummySplitOrderKey(size_t bucket);
+
+  /**
+   * Returns \c true if the deletion mark of \c node is set.
+   */
+  static bool IsMarked(Node* node);
+
+  /**
+   * Returns \c node with the deletion mark set.
+   */
+  static Node* Mark(Node* node);
+
+  /**
+   * Returns \c node with the deletion mark cleared.
+   */
+  static Node* Unmark(Node* node);
+
+  /**
+   * Computes the maximum number of buckets for \c capacity elements.
+   */
+  static size_t GetMaxBucketCount(size_t capacity);
+
+  /**
+   * Computes the bucket whose split produced \c bucket.
+   */
+  static size_t GetParentBucket(size_t bucket);
+
+  /**
+   * Gets the dummy node of \c bucket, initializes the bucket if necessary.
+   */
+  Node* GetBucket(size_t bucket);
+
+  /**
+   * Initializes \c bucket by inserting its dummy node into the list.
+   */
+  void InitializeBucket(size_t bucket);
+
+  /**
+   * Searches the list starting at \c head for the node with split-order key
+   * \c so_key and key \c key. Unlinks logically deleted nodes on the way.
+   *
+   * On return, \c prev points to the next pointer of the last node before
+   * the position of the searched node, \c cur is the searched node or its
+   * successor, and \c next is the successor of \c cur. \c prev's owner and
+   * \c cur are guarded.
+   *
+   * \return \c true if the node was found, otherwise \c false.
+   */
+  bool Find(
+    Node* head,
+    size_t so_key,
+    Key const& key,
+    bool is_dummy,
+    embb::base::Atomic< Node* >*& prev,
+    Node*& cur,
+    Node*& next);
+
+  /**
+   * Inserts \c node into the list starting at \c head.
+   *
+   * \return \c node if it could be inserted, otherwise the node with the same
+   *         key that is already contained in the list.
+   */
+  Node* ListInsert(Node* head, Node* node);
+
+  /**
+   * Removes all guards of the current thread.
+   */
+  void ClearGuards();
+
+ public:
+  /**
+   * Creates a hash map with the specified capacity.
+   *
+   * \memory
+   * Let \c t be the maximum number of threads, \c x be <tt>3.75*t+1</tt>,
+   * and \c b be the smallest power of two greater than or equal to
+   * <tt>capacity/2</tt>. Then, <tt>x*(3*t+1)</tt> elements of size
+   * <tt>sizeof(void*)</tt>, \c b elements of size <tt>sizeof(void*)</tt>,
+   * and <tt>x*t+capacity+b</tt> nodes holding a key and a value are
+   * allocated.
+   * With thread caches, <tt>t*thread_cache_size</tt> additional nodes are
+   * allocated, so the caches never reduce the capacity.
+   *
+   * \notthreadsafe
+   */
+  LockFreeHashMap(
+    size_t capacity,
+    /**< [IN] Capacity of the hash map */
+    size_t thread_cache_size = 0
+    /**< [IN] Maximum number of free nodes each thread keeps for itself,
+              see ObjectPool. 0 disables the thread caches. */);
+
+  /**
+   * Destroys the hash map.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreeHashMap();
+
+  /**
+   * Returns the capacity of the hash map.
+   *
+   * \return Number of elements the hash map can hold.
+   *
+   * \waitfree
+   */
+  size_t GetCapacity();
+
+  /**
+   * Returns the number of buckets currently in use.
+   *
+   * \return Number of buckets
+   *
+   * \waitfree
+   */
+  size_t GetBucketCount();
+
+  /**
+   * Returns the number of elements in the hash map.
+   *
+   * \return Number of elements. Only exact if there are no concurrent
+   *         insertions or removals.
+   *
+   * \waitfree
+   */
+  size_t GetSize();
+
+  /**
+   * Tries to insert a key/value pair into the hash map.
+   *
+   * \return \c true if the pair could be inserted, \c false if the key is
+   * already contained or the hash map is full.
+   *
+   * \lockfree
+   */
+  bool TryInsert(
+    Key const& key,
+    /**< [IN] Key of the element */
+    Value const& value
+    /**< [IN] Value of the element */);
+
+  /**
+   * Tries to find the value associated with a key.
+   *
+   * \return \c true if the key is contained, otherwise \c false.
+   *
+   * \lockfree
+   */
+  bool TryFind(
+    Key const& key,
+    /**< [IN] Key to search for */
+    Value & value
+    /**< [IN,OUT] Reference to the found value. Unchanged, if the operation
+                  was not successful. */);
+
+  /**
+   * Tries to remove a key and its value from the hash map.
+   *
+   * \return \c true if the key was removed, \c false if it is not contained.
+   *
+   * \lockfree
+   */
+  bool TryErase(
+    Key const& key
+    /**< [IN] Key to remove */);
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_hash_map-inl.h>
+
+#endif  // EMBB_CONTAINERS_LOCK_FREE_HASH_MAP_H_
@@ -33,6 +33,7 @@
 #include <embb/containers/lock_free_tree_value_pool.h>
 #include <embb/containers/object_pool.h>
 #include <embb/containers/internal/hazard_pointer.h>
+#include <embb/containers/internal/epoch_reclamation.h>
 
 #include <limits>
 #include <stdexcept>
@@ -102,9 +103,20 @@ class LockFreeMPMCQueueNode {
  * \tparam Type Type of the queue elements
  * \tparam ValuePool Type of the value pool used as basis for the ObjectPool
  *         which stores the elements.
+ * \tparam ReclamationScheme Memory reclamation scheme for dequeued nodes,
+ *         either internal::HazardPointer (default) or
+ *         internal::EpochReclamation. Epoch-based reclamation replaces the
+ *         memory barrier per guarded pointer by one per operation, but a
+ *         thread stalled inside an operation delays the reuse of nodes.
+ * \tparam Allocator Allocator for the queue nodes, rebound to the node type.
+ *         With embb::base::AllocatorCacheAligned, each node is placed on its
+ *         own cache line(s), which avoids false sharing between threads
+ *         working on neighboring nodes but increases the memory footprint.
  */
 template< typename Type,
-  typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false >
+  typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false >,
+  template< typename > class ReclamationScheme = internal::HazardPointer,
+  class Allocator = embb::base::Allocator< Type >
 >
 class LockFreeMPMCQueue {
  private:
@@ -117,22 +129,24 @@ class LockFreeMPMCQueue {
   // Important for initialization.
 
   /**
-   * Callback to the method that is called by hazard pointers if a pointer is
-   * not hazardous anymore, i.e., can safely be reused.
+   * Callback to the method that is called by the reclamation scheme if a
+   * pointer is not hazardous anymore, i.e., can safely be reused.
    */
   embb::base::Function < void, internal::LockFreeMPMCQueueNode<Type>* >
     delete_pointer_callback;
 
   /**
-   * The hazard pointer object, used for memory management.
+   * The reclamation scheme object, used for memory management.
    */
-  embb::containers::internal::HazardPointer
-    < internal::LockFreeMPMCQueueNode<Type>* > hazardPointer;
+  ReclamationScheme< internal::LockFreeMPMCQueueNode<Type>* >
+    reclamationScheme;
 
   /**
    * The object pool, used for lock-free memory allocation.
    */
-  ObjectPool< internal::LockFreeMPMCQueueNode<Type>, ValuePool > objectPool;
+  ObjectPool< internal::LockFreeMPMCQueueNode<Type>, ValuePool,
+    typename Allocator::template rebind<
+      internal::LockFreeMPMCQueueNode<Type> >::other > objectPool;
 
   /**
    * Atomic pointer to the head node of the queue
@@ -158,15 +172,23 @@ class LockFreeMPMCQueue {
    * Let \c t be the maximum number of threads and \c x be <tt>2.5*t+1</tt>.
    * Then, <tt>x*(3*t+1)</tt> elements of size <tt>sizeof(void*)</tt>, \c x
    * elements of size <tt>sizeof(Type)</tt>, and \c capacity+1 elements of size
-   * <tt>sizeof(Type)</tt> are allocated.
+   * <tt>sizeof(Type)</tt> are allocated. With
+   * embb::base::AllocatorCacheAligned, the elements of size
+   * <tt>sizeof(Type)</tt> are rounded up to cache lines together with their
+   * next pointer.
+   * With thread caches, <tt>t*thread_cache_size</tt> additional nodes are
+   * allocated, so the caches never reduce the capacity.
    *
    * \notthreadsafe
    *
    * \see CPP_CONCEPTS_QUEUE
    */
   LockFreeMPMCQueue(
-    size_t capacity
-    /**< [IN] Capacity of the queue */);
+    size_t capacity,
+    /**< [IN] Capacity of the queue */
+    size_t thread_cache_size = 0
+    /**< [IN] Maximum number of free nodes each thread keeps for itself,
+              see ObjectPool. 0 disables the thread caches. */);
 
   /**
    * Destroys the queue.
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_PRIORITY_QUEUE_H_
+#define EMBB_CONTAINERS_LOCK_FREE_PRIORITY_QUEUE_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/function.h>
+
+#include <embb/containers/lock_free_tree_value_pool.h>
+#include <embb/containers/lock_free_skip_list.h>
+#include <embb/containers/object_pool.h>
+#include <embb/containers/internal/hazard_pointer.h>
+
+/**
+ * \defgroup CPP_CONTAINERS_PRIORITY_QUEUES Priority Queues
+ * Concurrent priority queues
+ *
+ * \ingroup CPP_CONTAINERS
+ */
+
+namespace embb {
+namespace containers {
+/**
+ * Lock-free priority queue
+ *
+ * Implements a skiplist-based priority queue as proposed in:
+ *
+ * Nir Shavit and Itay Lotan. "Skiplist-based concurrent priority queues."
+ * IPDPS 2000.
+ *
+ * The elements are kept in a lock-free skiplist (Keir Fraser. "Practical
+ * lock-freedom." PhD thesis, University of Cambridge, 2004) sorted by key.
+ * TryDeleteMin() logically deletes the first unmarked node of the lowest
+ * level and then unlinks it from all levels. Elements with equal keys are
+ * removed in unspecified order.
+ *
+ * As the other containers, the priority queue only allocates memory at
+ * construction. Nodes are taken from an ObjectPool and reclaimed using
+ * hazard pointers.
+ *
+ * \see RelaxedPriorityQueue
+ *
+ * \ingroup CPP_CONTAINERS_PRIORITY_QUEUES
+ *
+ * \tparam Key Type of the keys (priorities), must be default and copy
+ *         constructible and less-than comparable. Smaller keys are removed
+ *         first.
+ * \tparam Value Type of the values, must be default and copy constructible
+ * \tparam ValuePool Type of the value pool used as basis for the ObjectPool
+ *         which stores the elements.
+ */
+template< typename Key,
+  typename Value,
+  typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false >
+>
+class LockFreePriorityQueue {
+ private:
+  /**
+   * Node type of the underlying skiplist
+   */
+  typedef internal::LockFreeSkipListNode< Key, Value > Node;
+
+  /**
+   * Position of the guard for the successor of the current node
+   */
+  static const int GUARD_NEXT = 0;
+
+  /**
+   * The capacity of the priority queue. It is guaranteed that the queue can
+   * hold at least as many elements, maybe more.
+   */
+  size_t capacity;
+
+  /**
+   * Number of levels used, depends on the capacity
+   */
+  int max_height;
+
+  /**
+   * Callback to the method that is called by hazard pointers if a pointer is
+   * not hazardous anymore, i.e., can safely be reused.
+   */
+  embb::base::Function < void, Node* > delete_pointer_callback;
+
+  /**
+   * The hazard pointer object, used for memory management.
+   */
+  internal::HazardPointer< Node* > hazardPointer;
+
+  /**
+   * The object pool, used for lock-free memory allocation.
+   */
+  ObjectPool< Node, ValuePool > objectPool;
+
+  /**
+   * Head of the skiplist, not part of the object pool
+   */
+  Node* head;
+
+  /**
+   * Random number generator states, one cache line per thread
+   */
+  unsigned int* random_seeds;
+
+  /**
+   * The callback function, used to cleanup non-hazardous pointers.
+   * \see delete_pointer_callback
+   */
+  void DeletePointerCallback(Node* to_delete);
+
+  /**
+   * Computes the number of levels used for \c capacity elements.
+   */
+  static int GetMaxHeight(size_t capacity);
+
+  /**
+   * Returns \c true if the deletion mark of \c node is set.
+   */
+  static bool IsMarked(Node* node);
+
+  /**
+   * Returns \c node with the deletion mark set.
+   */
+  static Node* Mark(Node* node);
+
+  /**
+   * Returns \c node with the deletion mark cleared.
+   */
+  static Node* Unmark(Node* node);
+
+  /**
+   * Returns \c true if \c node is ordered before the element with key
+   * \c key stored in node \c other. Ties are broken by the node addresses,
+   * such that each node has a unique position.
+   */
+  static bool IsBefore(Node* node, Key const& key, Node* other);
+
+  /**
+   * Returns the guard position for the predecessor on level \c level.
+   */
+  int GetPredecessorGuard(int level) const;
+
+  /**
+   * Returns the guard position for the successor on level \c level.
+   */
+  int GetSuccessorGuard(int level) const;
+
+  /**
+   * Returns the index of the current thread.
+   */
+  static unsigned int GetCurrentThreadIndex();
+
+  /**
+   * Draws a random height for a new node.
+   */
+  int GetRandomHeight();
+
+  /**
+   * Searches the position of \c node with key \c key on all levels and
+   * unlinks deleted nodes on the way.
+   *
+   * On return, \c preds and \c succs contain the predecessors and successors
+   * of the position on each level, which are guarded. If \c node is linked
+   * on a level, it is its own successor.
+   */
+  void Find(
+    Key const& key,
+    Node* node,
+    Node** preds,
+    Node** succs);
+
+  /**
+   * Gets the first node on the lowest level that is not deleted, unlinks
+   * deleted nodes in front of it. The node is guarded.
+   *
+   * \return The first node or \c NULL if the queue is empty
+   */
+  Node* FindFirst();
+
+  /**
+   * Releases \c node and retires it if no other thread owns it anymore.
+   */
+  void Release(Node* node);
+
+  /**
+   * Removes all guards of the current thread.
+   */
+  void ClearGuards();
+
+ public:
+  /**
+   * Creates a priority queue with the specified capacity.
+   *
+   * \memory
+   * Let \c t be the maximum number of threads, \c h be the number of levels
+   * (<tt>log2(capacity)</tt> limited to 16), \c g be <tt>2*h+1</tt>, and
+   * \c x be <tt>1.25*t*g+1</tt>. Then, <tt>x*(3*t+1)</tt> elements of size
+   * <tt>sizeof(void*)</tt>, \c t cache lines, and <tt>x*t+capacity+1</tt>
+   * nodes holding a key, a value, and 16 pointers are allocated.
+   * With thread caches, <tt>t*thread_cache_size</tt> additional nodes are
+   * allocated, so the caches never reduce the capacity.
+   *
+   * \notthreadsafe
+   */
+  explicit LockFreePriorityQueue(
+    size_t capacity,
+    /**< [IN] Capacity of the priority queue */
+    size_t thread_cache_size = 0
+    /**< [IN] Maximum number of free nodes each thread keeps for itself,
+              see ObjectPool. 0 disables the thread caches. */);
+
+  /**
+   * Destroys the priority queue.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreePriorityQueue();
+
+  /**
+   * Returns the capacity of the priority queue.
+   *
+   * \return Number of elements the priority queue can hold.
+   *
+   * \waitfree
+   */
+  size_t GetCapacity();
+
+  /**
+   * Tries to insert an element into the priority queue.
+   *
+   * \return \c true if the element could be inserted, \c false if the
+   * priority queue is full.
+   *
+   * \lockfree
+   */
+  bool TryInsert(
+    Key const& key,
+    /**< [IN] Key (priority) of the element */
+    Value const& value
+    /**< [IN] Value of the element */);
+
+  /**
+   * Tries to remove the element with the smallest key.
+   *
+   * \return \c true if an element could be removed, \c false if the priority
+   * queue is empty.
+   *
+   * \lockfree
+   */
+  bool TryDeleteMin(
+    Key & key,
+    /**< [IN,OUT] Reference to the key of the removed element. Unchanged, if
+                  the operation was not successful. */
+    Value & value
+    /**< [IN,OUT] Reference to the value of the removed element. Unchanged,
+                  if the operation was not successful. */);
+
+  /**
+   * Tries to get the smallest key without removing the element.
+   *
+   * \return \c true if the priority queue is not empty, otherwise \c false.
+   *
+   * \lockfree
+   */
+  bool TryGetMin(
+    Key & key
+    /**< [IN,OUT] Reference to the smallest key. Unchanged, if the operation
+                  was not successful. */);
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_priority_queue-inl.h>
+
+#endif  // EMBB_CONTAINERS_LOCK_FREE_PRIORITY_QUEUE_H_
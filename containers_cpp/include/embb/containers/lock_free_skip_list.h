@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_SKIP_LIST_H_
+#define EMBB_CONTAINERS_LOCK_FREE_SKIP_LIST_H_
+
+#include <utility>
+
+#include <embb/base/atomic.h>
+#include <embb/base/function.h>
+
+#include <embb/containers/lock_free_tree_value_pool.h>
+#include <embb/containers/object_pool.h>
+#include <embb/containers/internal/hazard_pointer.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Skiplist node
+ *
+ * Node with a tower of \c height next pointers. The lowest bit of each next
+ * pointer marks the node as deleted on the respective level. The node is
+ * reclaimed when both its inserter and its remover have released it
+ * (\c owners), as only then it is guaranteed to be unlinked on all levels.
+ *
+ * \tparam Key Key type
+ * \tparam Value Value type
+ */
+template< typename Key, typename Value >
+class LockFreeSkipListNode {
+ public:
+  /**
+   * Maximum number of levels of a skiplist
+   */
+  static const int MAX_HEIGHT = 16;
+
+ private:
+  /**
+   * The stored key
+   */
+  Key key;
+
+  /**
+   * The stored value
+   */
+  Value value;
+
+  /**
+   * Number of levels the node is linked in
+   */
+  int height;
+
+  /**
+   * Number of threads that still access the node (inserter and remover)
+   */
+  embb::base::Atomic<int> owners;
+
+  /**
+   * Next pointers, one per level
+   */
+  embb::base::Atomic< LockFreeSkipListNode< Key, Value >* > next[MAX_HEIGHT];
+
+ public:
+  /**
+   * Creates a head node, which is linked in all levels
+   */
+  LockFreeSkipListNode();
+
+  /**
+   * Creates a node holding a key/value pair
+   */
+  LockFreeSkipListNode(
+    Key const& key,
+    /**< [IN] The key of this node */
+    Value const& value,
+    /**< [IN] The value of this node */
+    int height
+    /**< [IN] Number of levels of this node */);
+
+  /**
+   * Returns the next pointer on level \c level
+   *
+   * \return The next pointer
+   */
+  embb::base::Atomic< LockFreeSkipListNode< Key, Value >* > &
+    GetNext(int level);
+
+  /**
+   * Returns the number of levels of this node
+   */
+  int GetHeight() const;
+
+  /**
+   * Returns the key held by this node
+   */
+  Key const& GetKey() const;
+
+  /**
+   * Returns the value held by this node
+   */
+  Value const& GetValue() const;
+
+  /**
+   * Releases one owner of this node.
+   *
+   * \return \c true if this was the last owner, i.e., the node can be retired
+   */
+  bool ReleaseOwner();
+};
+} // namespace internal
+
+/**
+ * Lock-free skiplist
+ *
+ * Ordered map with unique keys based on the lock-free skiplist described in:
+ *
+ * Keir Fraser. "Practical lock-freedom." PhD thesis, University of
+ * Cambridge, 2004.
+ *
+ * Each level is a lock-free list (Maged M. Michael. "High performance
+ * dynamic lock-free hash tables and list-based sets." SPAA 2002). An element
+ * is contained if its node is linked and not marked on the lowest level, the
+ * upper levels only speed up searching. Used as set, the values can be of
+ * any small type, e.g., \c bool.
+ *
+ * Iterators are weakly consistent: They hold a copy of the current element
+ * and advance to the smallest key greater than the current one that is
+ * contained at that time. Thus, they never become invalid and visit keys in
+ * ascending order, but may or may not reflect concurrent modifications.
+ *
+ * As the other containers, the skiplist only allocates memory at
+ * construction. Nodes are taken from an ObjectPool and reclaimed using
+ * hazard pointers.
+ *
+ * \ingroup CPP_CONTAINERS_MAPS
+ *
+ * \tparam Key Type of the keys, must be default and copy constructible and
+ *         less-than comparable
+ * \tparam Value Type of the values, must be default and copy constructible
+ * \tparam ValuePool Type of the value pool used as basis for the ObjectPool
+ *         which stores the elements.
+ */
+template< typename Key,
+  typename Value,
+  typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false >
+>
+class LockFreeSkipList {
+ private:
+  /**
+   * Node type of the skiplist
+   */
+  typedef internal::LockFreeSkipListNode< Key, Value > Node;
+
+ public:
+  /**
+   * Type of the elements visited by iterators
+   */
+  typedef std::pair< Key, Value > ElementType;
+
+  /**
+   * Weakly consistent forward iterator
+   *
+   * Dereferencing yields a copy of the element taken when the iterator was
+   * advanced to it.
+   */
+  class Iterator {
+   public:
+    /**
+     * Creates an iterator pointing behind the last element.
+     */
+    Iterator();
+
+    /**
+     * Returns the current element.
+     *
+     * \return Reference to the copy of the current element
+     */
+    ElementType const& operator*() const;
+
+    /**
+     * Accesses the current element.
+     *
+     * \return Pointer to the copy of the current element
+     */
+    ElementType const* operator->() const;
+
+    /**
+     * Advances to the element with the next greater key.
+     *
+     * \return Reference to this iterator
+     *
+     * \lockfree
+     */
+    Iterator& operator++();
+
+    /**
+     * Advances to the element with the next greater key.
+     *
+     * \return Copy of this iterator before advancing
+     *
+     * \lockfree
+     */
+    Iterator operator++(int);
+
+    /**
+     * Compares two iterators.
+     *
+     * \return \c true if both point behind the last element or to elements
+     *         with equal keys, otherwise \c false
+     */
+    bool operator==(
+      Iterator const& other
+      /**< [IN] Iterator to compare with */) const;
+
+    /**
+     * Compares two iterators.
+     *
+     * \return \c false if both point behind the last element or to elements
+     *         with equal keys, otherwise \c true
+     */
+    bool operator!=(
+      Iterator const& other
+      /**< [IN] Iterator to compare with */) const;
+
+   private:
+    friend class LockFreeSkipList;
+
+    /**
+     * Creates an iterator pointing to \c element.
+     */
+    Iterator(
+      LockFreeSkipList* skip_list,
+      ElementType const& element);
+
+    /**
+     * The iterated skiplist, \c NULL if behind the last element
+     */
+    LockFreeSkipList* skip_list;
+
+    /**
+     * Copy of the current element
+     */
+    ElementType element;
+  };
+
+ private:
+  /**
+   * Position of the guard for the successor of the current node
+   */
+  static const int GUARD_NEXT = 0;
+
+  /**
+   * The capacity of the skiplist. It is guaranteed that the skiplist can
+   * hold at least as many elements, maybe more.
+   */
+  size_t capacity;
+
+  /**
+   * Number of levels used, depends on the capacity
+   */
+  int max_height;
+
+  /**
+   * Callback to the method that is called by hazard pointers if a pointer is
+   * not hazardous anymore, i.e., can safely be reused.
+   */
+  embb::base::Function < void, Node* > delete_pointer_callback;
+
+  /**
+   * The hazard pointer object, used for memory management.
+   */
+  internal::HazardPointer< Node* > hazardPointer;
+
+  /**
+   * The object pool, used for lock-free memory allocation.
+   */
+  ObjectPool< Node, ValuePool > objectPool;
+
+  /**
+   * Head of the skiplist, not part of the object pool
+   */
+  Node* head;
+
+  /**
+   * Random number generator states, one cache line per thread
+   */
+  unsigned int* random_seeds;
+
+  /**
+   * The callback function, used to cleanup non-hazardous pointers.
+   * \see delete_pointer_callback
+   */
+  void DeletePointerCallback(Node* to_delete);
+
+  /**
+   * Computes the number of levels used for \c capacity elements.
+   */
+  static int GetMaxHeight(size_t capacity);
+
+  /**
+   * Returns \c true if the deletion mark of \c node is set.
+   */
+  static bool IsMarked(Node* node);
+
+  /**
+   * Returns \c node with the deletion mark set.
+   */
+  static Node* Mark(Node* node);
+
+  /**
+   * Returns \c node with the deletion mark cleared.
+   */
+  static Node* Unmark(Node* node);
+
+  /**
+   * Returns the guard position for the predecessor on level \c level.
+   */
+  int GetPredecessorGuard(int level) const;
+
+  /**
+   * Returns the guard position for the successor on level \c level.
+   */
+  int GetSuccessorGuard(int level) const;
+
+  /**
+   * Returns the index of the current thread.
+   */
+  static unsigned int GetCurrentThreadIndex();
+
+  /**
+   * Draws a random height for a new node.
+   */
+  int GetRandomHeight();
+
+  /**
+   * Searches the position of \c key on all levels and unlinks deleted nodes
+   * on the way.
+   *
+   * On return, \c preds and \c succs contain the predecessors and successors
+   * of the position on each level, which are guarded. The successors are the
+   * first nodes with a key not less than \c key or, if \c after is \c true,
+   * greater than \c key.
+   */
+  void Find(
+    Key const& key,
+    bool after,
+    Node** preds,
+    Node** succs);
+
+  /**
+   * Copies the first element with a key not less than \c key or, if
+   * \c after is \c true, greater than \c key.
+   *
+   * \return \c true if there is such an element, otherwise \c false
+   */
+  bool GetElement(
+    Key const& key,
+    bool after,
+    ElementType & element);
+
+  /**
+   * Releases \c node and retires it if no other thread owns it anymore.
+   */
+  void Release(Node* node);
+
+  /**
+   * Removes all guards of the current thread.
+   */
+  void ClearGuards();
+
+  /**
+   * Disable copy construction and assignment.
+   */
+  LockFreeSkipList(const LockFreeSkipList&);
+  LockFreeSkipList& operator=(const LockFreeSkipList&);
+
+ public:
+  /**
+   * Creates a skiplist with the specified capacity.
+   *
+   * \memory
+   * Let \c t be the maximum number of threads, \c h be the number of levels
+   * (<tt>log2(capacity)</tt> limited to 16), \c g be <tt>2*h+1</tt>, and
+   * \c x be <tt>1.25*t*g+1</tt>. Then, <tt>x*(3*t+1)</tt> elements of size
+   * <tt>sizeof(void*)</tt>, \c t cache lines, and <tt>x*t+capacity+1</tt>
+   * nodes holding a key, a value, and 16 pointers are allocated.
+   * With thread caches, <tt>t*thread_cache_size</tt> additional nodes are
+   * allocated, so the caches never reduce the capacity.
+   *
+   * \notthreadsafe
+   */
+  explicit LockFreeSkipList(
+    size_t capacity,
+    /**< [IN] Capacity of the skiplist */
+    size_t thread_cache_size = 0
+    /**< [IN] Maximum number of free nodes each thread keeps for itself,
+              see ObjectPool. 0 disables the thread caches. */);
+
+  /**
+   * Destroys the skiplist.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreeSkipList();
+
+  /**
+   * Returns the capacity of the skiplist.
+   *
+   * \return Number of elements the skiplist can hold.
+   *
+   * \waitfree
+   */
+  size_t GetCapacity();
+
+  /**
+   * Tries to insert a key/value pair into the skiplist.
+   *
+   * \return \c true if the pair could be inserted, \c false if the key is
+   * already contained or the skiplist is full.
+   *
+   * \lockfree
+   */
+  bool TryInsert(
+    Key const& key,
+    /**< [IN] Key of the element */
+    Value const& value
+    /**< [IN] Value of the element */);
+
+  /**
+   * Tries to remove a key and its value from the skiplist.
+   *
+   * \return \c true if the key was removed, \c false if it is not contained.
+   *
+   * \lockfree
+   */
+  bool TryErase(
+    Key const& key
+    /**< [IN] Key to remove */);
+
+  /**
+   * Checks whether a key is contained in the skiplist.
+   *
+   * \return \c true if the key is contained, otherwise \c false.
+   *
+   * \lockfree
+   */
+  bool Contains(
+    Key const& key
+    /**< [IN] Key to search for */);
+
+  /**
+   * Tries to find the value associated with a key.
+   *
+   * \return \c true if the key is contained, otherwise \c false.
+   *
+   * \lockfree
+   */
+  bool TryFind(
+    Key const& key,
+    /**< [IN] Key to search for */
+    Value & value
+    /**< [IN,OUT] Reference to the found value. Unchanged, if the operation
+                  was not successful. */);
+
+  /**
+   * Gets an iterator to the element with the smallest key.
+   *
+   * \return Iterator to the first element, or End() if the skiplist is
+   *         empty.
+   *
+   * \lockfree
+   */
+  Iterator Begin();
+
+  /**
+   * Gets an iterator to the element with the smallest key not less than
+   * \c key. Together with a comparison of the iterated keys, this allows to
+   * iterate over ranges.
+   *
+   * \return Iterator to the found element, or End() if there is none.
+   *
+   * \lockfree
+   */
+  Iterator LowerBound(
+    Key const& key
+    /**< [IN] Key to search for */);
+
+  /**
+   * Gets an iterator pointing behind the last element.
+   *
+   * \return Iterator pointing behind the last element
+   *
+   * \waitfree
+   */
+  Iterator End();
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_skip_list-inl.h>
+
+#endif  // EMBB_CONTAINERS_LOCK_FREE_SKIP_LIST_H_
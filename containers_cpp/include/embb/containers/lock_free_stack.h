@@ -31,6 +31,7 @@
 #include <embb/base/atomic.h>
 #include <embb/base/function.h>
 #include <embb/containers/internal/hazard_pointer.h>
+#include <embb/containers/internal/epoch_reclamation.h>
 #include <embb/containers/lock_free_tree_value_pool.h>
 
 /**
@@ -168,9 +169,13 @@ class LockFreeStackNode {
  * \tparam Type Type of the stack elements
  * \tparam ValuePool Type of the value pool used as basis for the ObjectPool
  *         which stores the elements.
+ * \tparam ReclamationScheme Memory reclamation scheme for popped nodes,
+ *         either internal::HazardPointer (default) or
+ *         internal::EpochReclamation.
  */
 template< typename Type,
-typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false > >
+typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false >,
+template< typename > class ReclamationScheme = internal::HazardPointer >
 class LockFreeStack {
  private:
   /**
@@ -180,16 +185,16 @@ class LockFreeStack {
   size_t capacity;
 
   /**
-   * Callback to the method that is called by hazard pointers if a pointer is
-   * not hazardous anymore, i.e., can safely be reused.
+   * Callback to the method that is called by the reclamation scheme if a
+   * pointer is not hazardous anymore, i.e., can safely be reused.
    */
   embb::base::Function<void, internal::LockFreeStackNode<Type>*>
     delete_pointer_callback;
 
   /**
-   * The hazard pointer object, used for memory management.
+   * The reclamation scheme object, used for memory management.
    */
-  internal::HazardPointer<internal::LockFreeStackNode<Type>*> hazardPointer;
+  ReclamationScheme<internal::LockFreeStackNode<Type>*> reclamationScheme;
 
   /**
    * The callback function, used to cleanup non-hazardous pointers.
@@ -216,14 +221,19 @@ class LockFreeStack {
    * Then, <tt>x*(3*t+1)</tt> elements of size <tt>sizeof(void*)</tt>, \c x
    * elements of size <tt>sizeof(Type)</tt>, and \c capacity elements of size
    * <tt>sizeof(Type)</tt> are allocated.
+   * With thread caches, <tt>t*thread_cache_size</tt> additional nodes are
+   * allocated, so the caches never reduce the capacity.
    *
    * \notthreadsafe
    *
    * \see CPP_CONCEPTS_STACK
    */
   LockFreeStack(
-    size_t capacity
+    size_t capacity,
     /**< [IN] Capacity of the stack */
+    size_t thread_cache_size = 0
+    /**< [IN] Maximum number of free nodes each thread keeps for itself,
+              see ObjectPool. 0 disables the thread caches. */
   );
 
   /**
@@ -39,7 +39,7 @@ namespace containers {
  *
  * \ingroup CPP_CONTAINERS_POOLS
  *
- * \see WaitFreeArrayValuePool
+ * \see WaitFreeArrayValuePool, LockFreeBitmapValuePool
  *
  * \tparam Type Element type (must support atomic operations such as \c int).
  * \tparam Undefined Bottom element (cannot be stored in the pool)
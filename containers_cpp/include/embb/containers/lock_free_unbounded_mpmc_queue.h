@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_UNBOUNDED_MPMC_QUEUE_H_
+#define EMBB_CONTAINERS_LOCK_FREE_UNBOUNDED_MPMC_QUEUE_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/function.h>
+#include <embb/base/memory_allocation.h>
+
+#include <embb/containers/internal/hazard_pointer.h>
+#include <embb/containers/internal/epoch_reclamation.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Queue segment
+ *
+ * Fixed-size array of cells and two indices, one for enqueuing and one for
+ * dequeuing. Each cell holds an element and a state that tells whether the
+ * element was already written (\c FULL) or whether a dequeuer gave up on the
+ * cell before (\c TAKEN). Segments are linked in queue order by \c next. In
+ * addition, all segments of a queue are linked by \c all_next, and unused
+ * segments by \c free_next.
+ *
+ * \tparam Type Element type
+ * \tparam SegmentSize Number of cells
+ */
+template< typename Type, size_t SegmentSize >
+class LockFreeUnboundedMPMCQueueSegment {
+ public:
+  /**
+   * Cell does not contain an element yet
+   */
+  static const int EMPTY = 0;
+
+  /**
+   * Cell contains an element
+   */
+  static const int FULL = 1;
+
+  /**
+   * Cell was consumed or skipped by a dequeuer
+   */
+  static const int TAKEN = 2;
+
+ private:
+  /**
+   * Index of the next cell to enqueue to, may exceed \c SegmentSize
+   */
+  embb::base::Atomic< size_t > enqueue_index;
+
+  /**
+   * Index of the next cell to dequeue from, may exceed \c SegmentSize
+   */
+  embb::base::Atomic< size_t > dequeue_index;
+
+  /**
+   * Pointer to the next segment in the queue
+   */
+  embb::base::Atomic< LockFreeUnboundedMPMCQueueSegment* > next;
+
+  /**
+   * Pointer to the next segment in the list of unused segments
+   */
+  LockFreeUnboundedMPMCQueueSegment* free_next;
+
+  /**
+   * Pointer to the next segment in the list of all segments
+   */
+  LockFreeUnboundedMPMCQueueSegment* all_next;
+
+  /**
+   * Cell states
+   */
+  embb::base::Atomic< int > states[SegmentSize];
+
+  /**
+   * Cell elements
+   */
+  Type elements[SegmentSize];
+
+ public:
+  /**
+   * Creates an empty segment
+   */
+  LockFreeUnboundedMPMCQueueSegment();
+
+  /**
+   * Empties the segment for reuse.
+   */
+  void Reset();
+
+  /**
+   * Returns the enqueue index
+   */
+  embb::base::Atomic< size_t > & GetEnqueueIndex();
+
+  /**
+   * Returns the dequeue index
+   */
+  embb::base::Atomic< size_t > & GetDequeueIndex();
+
+  /**
+   * Returns the next pointer
+   */
+  embb::base::Atomic< LockFreeUnboundedMPMCQueueSegment* > & GetNext();
+
+  /**
+   * Returns the next pointer in the list of unused segments
+   */
+  LockFreeUnboundedMPMCQueueSegment* & GetFreeNext();
+
+  /**
+   * Returns the next pointer in the list of all segments
+   */
+  LockFreeUnboundedMPMCQueueSegment* & GetAllNext();
+
+  /**
+   * Returns the state of the cell at position \c index
+   */
+  embb::base::Atomic< int > & GetState(
+    size_t index
+    /**< [IN] Cell index */);
+
+  /**
+   * Returns the element of the cell at position \c index
+   */
+  Type & GetElement(
+    size_t index
+    /**< [IN] Cell index */);
+};
+} // namespace internal
+
+/**
+ * Unbounded lock-free queue for multiple producers and multiple consumers
+ *
+ * In contrast to LockFreeMPMCQueue, the queue does not allocate one node per
+ * element from a pool of fixed size. Elements are stored in linked segments
+ * of \c SegmentSize cells, and producers and consumers claim cells with a
+ * single fetch-and-add. New segments are appended when the last one is
+ * full. Dequeued segments are recycled once the reclamation scheme allows
+ * it, so that memory grows with the number of elements actually held by
+ * the queue, and enqueuing never fails. Memory is only returned to the
+ * system when the queue is destroyed.
+ *
+ * \concept{CPP_CONCEPTS_QUEUE}
+ *
+ * \ingroup CPP_CONTAINERS_QUEUES
+ *
+ * \see LockFreeMPMCQueue
+ *
+ * \tparam Type Type of the queue elements, must be default constructible
+ * \tparam SegmentSize Number of elements per segment
+ * \tparam ReclamationScheme Memory reclamation scheme for dequeued segments,
+ *         either internal::HazardPointer (default) or
+ *         internal::EpochReclamation
+ */
+template< typename Type,
+  size_t SegmentSize = 64,
+  template< typename > class ReclamationScheme = internal::HazardPointer
+>
+class LockFreeUnboundedMPMCQueue {
+ private:
+  /**
+   * Concrete segment type
+   */
+  typedef internal::LockFreeUnboundedMPMCQueueSegment< Type, SegmentSize >
+    Segment;
+
+  /**
+   * Guard used for the head or tail segment
+   */
+  static const int GUARD_SEGMENT = 0;
+
+  /**
+   * Guard used when taking a segment from the list of unused segments
+   */
+  static const int GUARD_FREE = 1;
+
+  /**
+   * Number of elements the queue was prepared for at construction
+   */
+  size_t capacity;
+
+  /**
+   * Callback to the method that is called by the reclamation scheme if a
+   * segment is not accessed by any thread anymore.
+   */
+  embb::base::Function< void, Segment* > delete_pointer_callback;
+
+  /**
+   * The reclamation scheme object, used for memory management.
+   */
+  ReclamationScheme< Segment* > reclamationScheme;
+
+  /**
+   * Atomic pointer to the segment containing the head of the queue
+   */
+  embb::base::Atomic< Segment* > head;
+
+  /**
+   * Atomic pointer to the segment containing the tail of the queue
+   */
+  embb::base::Atomic< Segment* > tail;
+
+  /**
+   * Stack of unused segments. Segments are only pushed by the reclamation
+   * scheme, which prevents the ABA problem when popping them.
+   */
+  embb::base::Atomic< Segment* > free_segments;
+
+  /**
+   * List of all segments ever allocated, freed on destruction
+   */
+  embb::base::Atomic< Segment* > all_segments;
+
+  /**
+   * The callback function, used to recycle segments.
+   * \see delete_pointer_callback
+   */
+  void DeletePointerCallback(Segment* to_delete);
+
+  /**
+   * Gets an empty segment, either an unused or a newly allocated one.
+   * Must be called inside a critical region of the reclamation scheme.
+   *
+   * \return Pointer to the segment
+   */
+  Segment* AllocateSegment();
+
+  /**
+   * Allocates a new segment and adds it to the list of all segments.
+   *
+   * \return Pointer to the segment
+   */
+  Segment* CreateSegment();
+
+  /**
+   * Pushes a segment to the stack of unused segments.
+   */
+  void PushFreeSegment(
+    Segment* segment
+    /**< [IN] Unused segment */);
+
+  // Prevent copy-construction
+  LockFreeUnboundedMPMCQueue(const LockFreeUnboundedMPMCQueue&);
+
+  // Prevent assignment
+  LockFreeUnboundedMPMCQueue& operator=(const LockFreeUnboundedMPMCQueue&);
+
+ public:
+  /**
+   * Creates a queue and prepares segments for the specified number of
+   * elements. The queue can hold more elements than \c capacity, further
+   * segments are allocated on demand.
+   *
+   * \memory Allocates <tt>ceil(capacity/SegmentSize)+1</tt> segments of
+   *         about <tt>SegmentSize*(sizeof(Type)+sizeof(int))</tt> bytes and
+   *         the memory required by the reclamation scheme for two guards
+   *         per thread. Additional segments are allocated by TryEnqueue().
+   *
+   * \notthreadsafe
+   *
+   * \see CPP_CONCEPTS_QUEUE
+   */
+  explicit LockFreeUnboundedMPMCQueue(
+    size_t capacity = 0
+    /**< [IN] Number of elements to prepare segments for */);
+
+  /**
+   * Destroys the queue.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreeUnboundedMPMCQueue();
+
+  /**
+   * Returns the capacity the queue was created with.
+   *
+   * \return Number of elements the queue holds without allocating memory
+   *
+   * \waitfree
+   */
+  size_t GetCapacity();
+
+  /**
+   * Enqueues an element into the queue.
+   *
+   * \return Always \c true, the queue is never full.
+   *
+   * \throws embb::base::NoMemoryException if a new segment is required and
+   *         not enough memory is available
+   *
+   * \lockfree
+   *
+   * \memory Allocates a new segment if the last segment is full and no
+   *         unused segment is available.
+   *
+   * \see CPP_CONCEPTS_QUEUE
+   */
+  bool TryEnqueue(
+    Type const& element
+    /**< [IN] Const reference to the element that shall be enqueued */);
+
+  /**
+   * Tries to dequeue an element from the queue.
+   *
+   * \return \c true if an element could be dequeued, \c false if the queue is
+   * empty.
+   *
+   * \lockfree
+   *
+   * \see CPP_CONCEPTS_QUEUE
+   */
+  bool TryDequeue(
+    Type & element
+    /**< [IN, OUT] Reference to the dequeued element.
+                   Unchanged, if the operation
+                   was not successful. */);
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_unbounded_mpmc_queue-inl.h>
+
+#endif  // EMBB_CONTAINERS_LOCK_FREE_UNBOUNDED_MPMC_QUEUE_H_
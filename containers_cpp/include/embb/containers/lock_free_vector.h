@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_VECTOR_H_
+#define EMBB_CONTAINERS_LOCK_FREE_VECTOR_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/memory_allocation.h>
+
+/**
+ * \defgroup CPP_CONTAINERS_VECTORS Vectors
+ * Concurrent random-access sequences
+ *
+ * \ingroup CPP_CONTAINERS
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Vector slot
+ *
+ * Contains the element (\c element) and a flag telling whether the element
+ * was completely written (\c ready).
+ *
+ * \tparam Type Element type
+ */
+template< typename Type >
+class LockFreeVectorSlot {
+ private:
+  /**
+   * Set after the element was written
+   */
+  embb::base::Atomic< bool > ready;
+
+  /**
+   * The stored element
+   */
+  Type element;
+
+ public:
+  /**
+   * Creates an empty slot
+   */
+  LockFreeVectorSlot();
+
+  /**
+   * Returns the ready flag
+   */
+  embb::base::Atomic< bool > & GetReady();
+
+  /**
+   * Returns the element held by this slot
+   */
+  Type & GetElement();
+};
+} // namespace internal
+
+/**
+ * Lock-free vector with append-only growth
+ *
+ * Elements are stored in buckets of exponentially increasing size, bucket
+ * \c b holding <tt>FIRST_BUCKET_SIZE*2^b</tt> elements, as proposed by
+ * Dechev et al. Buckets are never moved, so the address of an element
+ * remains valid until the vector is destroyed, and elements can be read
+ * while other threads append.
+ *
+ * PushBack() reserves an index with a single fetch-and-add. The size of the
+ * vector only covers elements whose push and all preceding pushes have
+ * completed, so that all elements below GetSize() can be read.
+ *
+ * \ingroup CPP_CONTAINERS_VECTORS
+ *
+ * \tparam Type Type of the elements, must be default constructible and
+ *         assignable
+ */
+template< typename Type >
+class LockFreeVector {
+ private:
+  /**
+   * Concrete slot type
+   */
+  typedef internal::LockFreeVectorSlot< Type > Slot;
+
+  /**
+   * Logarithm of the size of the first bucket
+   */
+  static const size_t FIRST_BUCKET_BITS = 3;
+
+  /**
+   * Size of the first bucket
+   */
+  static const size_t FIRST_BUCKET_SIZE =
+    static_cast<size_t>(1) << FIRST_BUCKET_BITS;
+
+  /**
+   * Number of buckets, such that every index of type \c size_t fits
+   */
+  static const size_t BUCKET_COUNT = sizeof(size_t) * 8 - FIRST_BUCKET_BITS;
+
+  /**
+   * Number of indices handed out by PushBack()
+   */
+  embb::base::Atomic< size_t > reserved;
+
+  /**
+   * Length of the prefix of completely written elements
+   */
+  embb::base::Atomic< size_t > size;
+
+  /**
+   * Pointers to the buckets, allocated on demand
+   */
+  embb::base::Atomic< Slot* > buckets[BUCKET_COUNT];
+
+  /**
+   * Returns the number of slots of the specified bucket
+   */
+  static size_t GetBucketSize(
+    size_t bucket
+    /**< [IN] Bucket index */);
+
+  /**
+   * Returns the slot at the specified index, allocating its bucket if
+   * necessary.
+   */
+  Slot & GetSlot(
+    size_t index
+    /**< [IN] Element index */);
+
+  /**
+   * Returns the slot at the specified index, its bucket must exist.
+   */
+  Slot & GetExistingSlot(
+    size_t index
+    /**< [IN] Element index */) const;
+
+  /**
+   * Allocates the specified bucket if it does not exist yet.
+   *
+   * \return Pointer to the bucket
+   */
+  Slot* AllocateBucket(
+    size_t bucket
+    /**< [IN] Bucket index */);
+
+  /**
+   * Computes bucket and position within the bucket of an element index.
+   */
+  static void Locate(
+    size_t index,
+    /**< [IN] Element index */
+    size_t & bucket,
+    /**< [OUT] Bucket index */
+    size_t & position
+    /**< [OUT] Position within the bucket */);
+
+  // Prevent copy-construction
+  LockFreeVector(const LockFreeVector&);
+
+  // Prevent assignment
+  LockFreeVector& operator=(const LockFreeVector&);
+
+ public:
+  /**
+   * Creates an empty vector.
+   *
+   * \memory Allocates the buckets required for \c capacity elements, i.e.,
+   *         at most about <tt>2*capacity</tt> elements of type \c Type
+   *         and a flag each. Further buckets are allocated by PushBack().
+   *
+   * \notthreadsafe
+   */
+  explicit LockFreeVector(
+    size_t capacity = 0
+    /**< [IN] Number of elements to allocate memory for */);
+
+  /**
+   * Destroys the vector.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreeVector();
+
+  /**
+   * Appends an element to the vector.
+   *
+   * \return Index of the element
+   *
+   * \throws embb::base::NoMemoryException if a new bucket is required and
+   *         not enough memory is available
+   *
+   * \lockfree
+   */
+  size_t PushBack(
+    Type const& element
+    /**< [IN] Const reference to the element that shall be appended */);
+
+  /**
+   * Returns the number of elements that can be read.
+   *
+   * A push is included as soon as it and all pushes that reserved a lower
+   * index have completed. Pushes still in progress are not included.
+   *
+   * \return Size of the vector
+   *
+   * \waitfree
+   */
+  size_t GetSize() const;
+
+  /**
+   * Returns the element at the specified index.
+   *
+   * \pre \c index is lower than GetSize() or was returned by a completed
+   *      PushBack().
+   *
+   * \return Reference to the element
+   *
+   * \waitfree
+   */
+  Type & operator[](
+    size_t index
+    /**< [IN] Index of the element */);
+
+  /**
+   * Returns the element at the specified index.
+   *
+   * \pre \c index is lower than GetSize() or was returned by a completed
+   *      PushBack().
+   *
+   * \return Const reference to the element
+   *
+   * \waitfree
+   */
+  Type const & operator[](
+    size_t index
+    /**< [IN] Index of the element */) const;
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_vector-inl.h>
+
+#endif  // EMBB_CONTAINERS_LOCK_FREE_VECTOR_H_
@@ -28,6 +28,7 @@
 #define EMBB_CONTAINERS_OBJECT_POOL_H_
 
 #include <embb/base/atomic.h>
+#include <embb/base/memory_allocation.h>
 #include <embb/containers/wait_free_array_value_pool.h>
 
 #include <limits>
@@ -35,6 +36,27 @@
 
 namespace embb {
 namespace containers {
+namespace internal {
+/**
+ * Distance in bytes between two objects of an object pool
+ *
+ * Objects are stored densely unless they are allocated with
+ * embb::base::AllocatorCacheAligned, in which case each object is padded to
+ * a multiple of the cache line size so that objects used by different
+ * threads never share a cache line.
+ */
+template< class Type, class ObjectAllocator >
+struct ObjectPoolSlotSize {
+  static const size_t value = sizeof(Type);
+};
+
+template< class Type >
+struct ObjectPoolSlotSize< Type, embb::base::AllocatorCacheAligned<Type> > {
+  static const size_t value =
+    (sizeof(Type) + EMBB_PLATFORM_CACHE_LINE_SIZE - 1) /
+    EMBB_PLATFORM_CACHE_LINE_SIZE * EMBB_PLATFORM_CACHE_LINE_SIZE;
+};
+} // namespace internal
 
 /**
  * \defgroup CPP_CONTAINERS_POOLS Pools
@@ -46,12 +68,27 @@ namespace containers {
 /**
  * Pool for thread-safe management of arbitrary objects.
  *
+ * Optionally, each thread keeps a small cache (magazine) of free elements
+ * in front of the value pool. Allocations and deallocations are then served
+ * from this cache without synchronization. Only if it runs empty or full,
+ * half of its capacity is taken from or returned to the value pool. To keep
+ * the capacity guarantee, the pool holds additional elements for the
+ * caches.
+ *
+ * The caches are disabled by default, as they cost memory for each thread
+ * and a lookup of the thread index on every operation. The containers
+ * built on ObjectPool enable them via the \c thread_cache_size argument of
+ * their constructors.
+ *
  * \ingroup CPP_CONTAINERS_POOLS
  *
  * \tparam Type Element type
  * \tparam ValuePool Type of the underlying value pool, determines whether
  *         the object pool is wait-free or lock-free
- * \tparam ObjectAllocator Type of allocator used to allocate objects
+ * \tparam ObjectAllocator Type of allocator used to allocate objects. With
+ *         embb::base::AllocatorCacheAligned, each object occupies its own
+ *         cache line(s), which avoids false sharing between objects used by
+ *         different threads at the expense of memory.
  */
 template<class Type,
   typename ValuePool    =
@@ -64,6 +101,12 @@ class ObjectPool {
    */
   ObjectAllocator objectAllocator;
 
+  /**
+   * Distance in bytes between two objects
+   */
+  static const size_t SLOT_SIZE =
+    internal::ObjectPoolSlotSize< Type, ObjectAllocator >::value;
+
   /**
    * Array holding the allocated object
    */
@@ -74,6 +117,41 @@ class ObjectPool {
    */
   size_t capacity;
 
+  /**
+   * Number of elements in the pool, including those reserved for the
+   * thread caches
+   */
+  size_t size;
+
+  /**
+   * Number of elements of type \c Type allocated for the objects including
+   * padding
+   */
+  size_t allocated_count;
+
+  /**
+   * Maximum number of elements in each thread cache, 0 if caching is
+   * disabled
+   */
+  size_t thread_cache_size;
+
+  /**
+   * Number of thread caches, i.e., the maximum number of threads
+   */
+  unsigned int thread_cache_count;
+
+  /**
+   * Distance between the thread caches in \c thread_caches, multiple of a
+   * cache line
+   */
+  size_t thread_cache_stride;
+
+  /**
+   * Thread caches. Each cache starts with the number of cached elements,
+   * followed by the indices of the cached elements.
+   */
+  int* thread_caches;
+
   /**
    * Underlying value pool
    */
@@ -107,19 +185,45 @@ class ObjectPool {
 
   bool IsContained(const Type &obj) const;
   int GetIndexOfObject(const Type &obj) const;
+  Type* GetObject(int index) const;
   Type* AllocateRaw();
 
+  /**
+   * Returns the cache of the current thread, or \c NULL if caching is
+   * disabled or the thread has no index.
+   */
+  int* GetThreadCache();
+
+  /**
+   * Disable copy construction and assignment.
+   */
+  ObjectPool(const ObjectPool&);
+  ObjectPool& operator=(const ObjectPool&);
+
  public:
+  /**
+   * Default maximum number of elements in each thread cache, i.e., caching
+   * is disabled by default
+   */
+  static const size_t DEFAULT_THREAD_CACHE_SIZE = 0;
+
   /**
    * Constructs an object pool with capacity \c capacity.
    *
-   * \memory Allocates \c capacity elements of type \c Type.
+   * \memory Let \c t be the maximum number of threads. Allocates
+   * <tt>capacity+t*thread_cache_size</tt> elements of type \c Type, each
+   * rounded up to cache lines if \c ObjectAllocator is
+   * embb::base::AllocatorCacheAligned, and
+   * <tt>t*(thread_cache_size+1)</tt> integers, rounded up to cache lines.
    *
    * \notthreadsafe
    */
-  ObjectPool(
-    size_t capacity
+  explicit ObjectPool(
+    size_t capacity,
     /**< [IN] Number of elements the pool can hold */
+    size_t thread_cache_size = DEFAULT_THREAD_CACHE_SIZE
+    /**< [IN] Maximum number of free elements each thread keeps for itself.
+              0 disables the thread caches. */
   );
 
   /**
@@ -138,6 +242,20 @@ class ObjectPool {
    */
   size_t GetCapacity();
 
+  /**
+   * Returns the elements cached by the current thread to the underlying
+   * value pool.
+   *
+   * Threads should call this before they exit. Thread indices are not
+   * reused, so the elements cached by an exited thread stay unused for the
+   * lifetime of the pool. Since they are reserved in addition to the
+   * capacity, this does not affect the capacity guarantee.
+   *
+   * If the underlying value pool is wait-free/lock-free, this operation is
+   * also wait-free/lock-free, respectively.
+   */
+  void FlushThreadCache();
+
  /**
   * Returns an element to the pool.
   *
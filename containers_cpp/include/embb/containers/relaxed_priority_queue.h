@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_RELAXED_PRIORITY_QUEUE_H_
+#define EMBB_CONTAINERS_RELAXED_PRIORITY_QUEUE_H_
+
+#include <embb/base/atomic.h>
+
+#include <embb/containers/lock_free_priority_queue.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Thread-local buffer of the relaxed priority queue
+ *
+ * Holds up to \c capacity elements sorted by descending key, such that the
+ * smallest element is removed from the end. The owning thread and stealing
+ * threads acquire the buffer using TryLock(), which never waits.
+ *
+ * \tparam Key Key type
+ * \tparam Value Value type
+ */
+template< typename Key, typename Value >
+class RelaxedPriorityQueueBuffer {
+ private:
+  /**
+   * Flag indicating that a thread currently accesses the buffer
+   */
+  embb::base::Atomic<bool> locked;
+
+  /**
+   * Maximum number of elements in the buffer
+   */
+  size_t capacity;
+
+  /**
+   * Current number of elements in the buffer
+   */
+  size_t size;
+
+  /**
+   * Keys, sorted descending
+   */
+  Key* keys;
+
+  /**
+   * Values belonging to the keys
+   */
+  Value* values;
+
+  /**
+   * Disable copy construction and assignment.
+   */
+  RelaxedPriorityQueueBuffer(const RelaxedPriorityQueueBuffer&);
+  RelaxedPriorityQueueBuffer& operator=(const RelaxedPriorityQueueBuffer&);
+
+ public:
+  /**
+   * Creates an empty buffer
+   */
+  explicit RelaxedPriorityQueueBuffer(
+    size_t capacity
+    /**< [IN] Maximum number of elements in the buffer */);
+
+  /**
+   * Destroys the buffer
+   */
+  ~RelaxedPriorityQueueBuffer();
+
+  /**
+   * Tries to acquire the buffer.
+   *
+   * \return \c true if the buffer was acquired, \c false if another thread
+   * currently accesses it.
+   */
+  bool TryLock();
+
+  /**
+   * Releases the buffer.
+   */
+  void Unlock();
+
+  /**
+   * Returns the number of elements in the buffer
+   */
+  size_t GetSize() const;
+
+  /**
+   * Returns \c true if the buffer cannot take more elements
+   */
+  bool IsFull() const;
+
+  /**
+   * Returns the smallest key. The buffer must not be empty.
+   */
+  Key const& GetMinKey() const;
+
+  /**
+   * Returns the key at \c index, where keys are sorted descending
+   */
+  Key const& GetKey(size_t index) const;
+
+  /**
+   * Returns the value at \c index
+   */
+  Value const& GetValue(size_t index) const;
+
+  /**
+   * Inserts an element. The buffer must not be full.
+   */
+  void Insert(
+    Key const& key,
+    /**< [IN] Key of the element */
+    Value const& value
+    /**< [IN] Value of the element */);
+
+  /**
+   * Removes the element with the smallest key. The buffer must not be empty.
+   */
+  void RemoveMin(
+    Key & key,
+    /**< [OUT] Key of the removed element */
+    Value & value
+    /**< [OUT] Value of the removed element */);
+
+  /**
+   * Removes the \c count elements with the largest keys.
+   */
+  void RemoveLargest(
+    size_t count
+    /**< [IN] Number of elements to remove */);
+};
+} // namespace internal
+
+/**
+ * Relaxed priority queue
+ *
+ * Trades strict ordering for throughput in the spirit of the k-LSM priority
+ * queue presented in:
+ *
+ * Martin Wimmer, Jakob Gruber, Jesper Larsson Traeff, and Philippas Tsigas.
+ * "The lock-free k-LSM relaxed priority queue." PPoPP 2015.
+ *
+ * Each thread owns a sorted buffer of up to \c relaxation elements in front
+ * of a shared LockFreePriorityQueue. Insertions go to the buffer of the
+ * calling thread. If it is full, its larger half is moved into the shared
+ * queue. TryDeleteMin() removes the smaller of the buffer's and the shared
+ * queue's minimum. Only if both are empty, elements are stolen from the
+ * buffers of other threads.
+ *
+ * Hence, the removed element is among the <tt>relaxation*(t-1)+1</tt>
+ * smallest elements, where \c t is the number of threads. Operations on the
+ * local buffer need no synchronization except for an uncontended flag.
+ *
+ * \see LockFreePriorityQueue
+ *
+ * \ingroup CPP_CONTAINERS_PRIORITY_QUEUES
+ *
+ * \tparam Key Type of the keys (priorities), must be default and copy
+ *         constructible, assignable, and less-than comparable. Smaller keys
+ *         are removed first.
+ * \tparam Value Type of the values, must be default and copy constructible
+ *         and assignable
+ * \tparam ValuePool Type of the value pool used as basis for the ObjectPool
+ *         of the shared queue.
+ */
+template< typename Key,
+  typename Value,
+  typename ValuePool = embb::containers::LockFreeTreeValuePool < bool, false >
+>
+class RelaxedPriorityQueue {
+ private:
+  /**
+   * Thread-local buffer type
+   */
+  typedef internal::RelaxedPriorityQueueBuffer< Key, Value > Buffer;
+
+  /**
+   * Capacity of the shared queue
+   */
+  size_t capacity;
+
+  /**
+   * Capacity of the thread-local buffers
+   */
+  size_t relaxation;
+
+  /**
+   * The shared priority queue
+   */
+  LockFreePriorityQueue< Key, Value, ValuePool > shared_queue;
+
+  /**
+   * Number of thread-local buffers, i.e., the maximum number of threads
+   */
+  unsigned int buffer_count;
+
+  /**
+   * Thread-local buffers, each aligned to a cache line
+   */
+  Buffer** buffers;
+
+  /**
+   * Returns the index of the current thread.
+   */
+  static unsigned int GetCurrentThreadIndex();
+
+  /**
+   * Moves the larger half of \c buffer into the shared queue, as far as the
+   * shared queue is not full.
+   */
+  void Spill(Buffer& buffer);
+
+  /**
+   * Tries to remove the smallest element from the buffer of another thread.
+   *
+   * \return \c true if an element was removed, otherwise \c false
+   */
+  bool TrySteal(unsigned int thread_index, Key & key, Value & value);
+
+  /**
+   * Disable copy construction and assignment.
+   */
+  RelaxedPriorityQueue(const RelaxedPriorityQueue&);
+  RelaxedPriorityQueue& operator=(const RelaxedPriorityQueue&);
+
+ public:
+  /**
+   * Creates a relaxed priority queue with the specified capacity.
+   *
+   * \memory
+   * Allocates a LockFreePriorityQueue with the given capacity and, for each
+   * of the \c t threads, a buffer of \c relaxation keys and values.
+   *
+   * \notthreadsafe
+   */
+  explicit RelaxedPriorityQueue(
+    size_t capacity,
+    /**< [IN] Capacity of the shared priority queue */
+    size_t relaxation = 16
+    /**< [IN] Capacity of the thread-local buffers. Larger values increase
+              throughput but weaken the ordering. */);
+
+  /**
+   * Destroys the priority queue.
+   *
+   * \notthreadsafe
+   */
+  ~RelaxedPriorityQueue();
+
+  /**
+   * Returns the capacity of the priority queue.
+   *
+   * \return Number of elements the priority queue can hold at least. The
+   *         thread-local buffers may hold additional elements.
+   *
+   * \waitfree
+   */
+  size_t GetCapacity();
+
+  /**
+   * Returns the capacity of the thread-local buffers.
+   *
+   * \return Capacity of the thread-local buffers
+   *
+   * \waitfree
+   */
+  size_t GetRelaxation();
+
+  /**
+   * Tries to insert an element into the priority queue.
+   *
+   * \return \c true if the element could be inserted, \c false if the
+   * priority queue is full.
+   *
+   * \lockfree
+   */
+  bool TryInsert(
+    Key const& key,
+    /**< [IN] Key (priority) of the element */
+    Value const& value
+    /**< [IN] Value of the element */);
+
+  /**
+   * Tries to remove an element with a small key.
+   *
+   * \return \c true if an element could be removed, \c false if the priority
+   * queue is empty. May also return \c false if the remaining elements are
+   * held in buffers of other threads that are accessed concurrently.
+   *
+   * \lockfree
+   */
+  bool TryDeleteMin(
+    Key & key,
+    /**< [IN,OUT] Reference to the key of the removed element. Unchanged, if
+                  the operation was not successful. */
+    Value & value
+    /**< [IN,OUT] Reference to the value of the removed element. Unchanged,
+                  if the operation was not successful. */);
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/relaxed_priority_queue-inl.h>
+
+#endif  // EMBB_CONTAINERS_RELAXED_PRIORITY_QUEUE_H_
@@ -105,7 +105,7 @@ namespace containers {
  *
  * \ingroup CPP_CONTAINERS_POOLS
  *
- * \see LockFreeTreeValuePool
+ * \see LockFreeTreeValuePool, LockFreeBitmapValuePool
  *
  * \tparam Type Element type (must support atomic operations such as \c int).
  * \tparam Undefined Bottom element (cannot be stored in the pool)
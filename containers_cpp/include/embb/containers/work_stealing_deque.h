@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_WORK_STEALING_DEQUE_H_
+#define EMBB_CONTAINERS_WORK_STEALING_DEQUE_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/memory_allocation.h>
+
+/**
+ * \defgroup CPP_CONTAINERS_DEQUES Deques
+ * Concurrent double-ended queues
+ *
+ * \ingroup CPP_CONTAINERS
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+/**
+ * Circular array of a work-stealing deque
+ *
+ * The capacity is a power of two, indices are taken modulo the capacity.
+ * When growing, the old array is kept (\c previous), since thieves might
+ * still read from it.
+ *
+ * \tparam Type Element type
+ */
+template< typename Type >
+class WorkStealingDequeArray {
+ private:
+  /**
+   * Number of elements, a power of two
+   */
+  size_t capacity;
+
+  /**
+   * The elements
+   */
+  Type* elements;
+
+  /**
+   * The array this one replaced, or \c NULL
+   */
+  WorkStealingDequeArray* previous;
+
+ public:
+  /**
+   * Creates an array using the specified memory.
+   */
+  WorkStealingDequeArray(
+    size_t capacity,
+    /**< [IN] Number of elements, must be a power of two */
+    Type* elements,
+    /**< [IN] Memory for \c capacity constructed elements */
+    WorkStealingDequeArray* previous
+    /**< [IN] The array replaced by this one, or \c NULL */);
+
+  /**
+   * Returns the number of elements
+   */
+  size_t GetCapacity() const;
+
+  /**
+   * Returns the array this one replaced
+   */
+  WorkStealingDequeArray* GetPrevious() const;
+
+  /**
+   * Returns the elements
+   */
+  Type* GetElements() const;
+
+  /**
+   * Returns the element at the specified (unbounded) index
+   */
+  Type & Get(
+    size_t index
+    /**< [IN] Index, taken modulo the capacity */);
+
+  /**
+   * Stores an element at the specified (unbounded) index
+   */
+  void Put(
+    size_t index,
+    /**< [IN] Index, taken modulo the capacity */
+    Type const& element
+    /**< [IN] Element to store */);
+};
+} // namespace internal
+
+/**
+ * Work-stealing deque
+ *
+ * Double-ended queue with one owner thread and any number of thieves. The
+ * owner pushes and pops elements at the bottom in LIFO order, thieves take
+ * elements from the top in FIFO order. Push and pop at the bottom only
+ * synchronize with thieves if the deque holds at most one element. If the
+ * deque is full, the owner replaces the circular array by one of twice the
+ * size, without blocking concurrent thieves.
+ *
+ * A thief may read an element while the owner overwrites it, in which case
+ * the stolen copy is discarded. Thus, the element type should be cheap to
+ * copy and copying must not have side effects, as for pointers to tasks.
+ *
+ * \ingroup CPP_CONTAINERS_DEQUES
+ *
+ * \tparam Type Type of the elements
+ * \tparam Allocator Allocator used to allocate the circular arrays
+ */
+template< typename Type,
+  class Allocator = embb::base::Allocator< Type > >
+class WorkStealingDeque {
+ private:
+  /**
+   * Concrete array type
+   */
+  typedef internal::WorkStealingDequeArray< Type > Array;
+
+  /**
+   * Index of the topmost element, only incremented
+   */
+  embb::base::Atomic< size_t > top;
+
+  /**
+   * Index one past the bottommost element
+   */
+  embb::base::Atomic< size_t > bottom;
+
+  /**
+   * The current circular array
+   */
+  embb::base::Atomic< Array* > array;
+
+  /**
+   * Allocator for the elements of the circular arrays
+   */
+  Allocator allocator;
+
+  /**
+   * Allocates an array and constructs its elements.
+   *
+   * \return Pointer to the new array
+   */
+  Array* NewArray(
+    size_t capacity,
+    /**< [IN] Number of elements, a power of two */
+    Array* previous
+    /**< [IN] Array replaced by the new one, or \c NULL */);
+
+  /**
+   * Replaces the current array by one of twice the size and copies the
+   * elements between \c top and \c bottom. Called by the owner only.
+   *
+   * \return Pointer to the new array
+   */
+  Array* Grow(
+    Array* current,
+    /**< [IN] The current array */
+    size_t top_index,
+    /**< [IN] Index of the topmost element */
+    size_t bottom_index
+    /**< [IN] Index one past the bottommost element */);
+
+  // Prevent copy-construction
+  WorkStealingDeque(const WorkStealingDeque&);
+
+  // Prevent assignment
+  WorkStealingDeque& operator=(const WorkStealingDeque&);
+
+ public:
+  /**
+   * Creates an empty deque.
+   *
+   * \memory Allocates \c capacity elements rounded up to the next power of
+   *         two. Replaced arrays are kept until the deque is destroyed, so
+   *         at most twice the memory of the largest array is used.
+   *
+   * \notthreadsafe
+   */
+  explicit WorkStealingDeque(
+    size_t capacity = 64
+    /**< [IN] Initial capacity of the deque */);
+
+  /**
+   * Destroys the deque.
+   *
+   * \notthreadsafe
+   */
+  ~WorkStealingDeque();
+
+  /**
+   * Returns the capacity of the current array.
+   *
+   * \return Number of elements the deque can hold without growing
+   *
+   * \waitfree
+   */
+  size_t GetCapacity();
+
+  /**
+   * Pushes an element to the bottom of the deque. Grows the deque if it is
+   * full.
+   *
+   * \note Must only be called by the owner of the deque.
+   *
+   * \throws embb::base::NoMemoryException if the deque has to grow and not
+   *         enough memory is available
+   *
+   * \waitfree
+   */
+  void PushBottom(
+    Type const& element
+    /**< [IN] Const reference to the element that shall be pushed */);
+
+  /**
+   * Tries to pop the element at the bottom of the deque.
+   *
+   * \return \c true if an element could be popped, \c false if the deque is
+   *         empty or the last element was stolen concurrently.
+   *
+   * \note Must only be called by the owner of the deque.
+   *
+   * \waitfree
+   */
+  bool TryPopBottom(
+    Type & element
+    /**< [IN, OUT] Reference to the popped element. Unchanged, if the
+                   operation was not successful. */);
+
+  /**
+   * Tries to steal the element at the top of the deque.
+   *
+   * \return \c true if an element could be stolen, \c false if the deque is
+   *         empty or another thread took the element concurrently.
+   *
+   * \waitfree
+   */
+  bool TrySteal(
+    Type & element
+    /**< [IN, OUT] Reference to the stolen element. Unchanged, if the
+                   operation was not successful. */);
+};
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/work_stealing_deque-inl.h>
+
+#endif  // EMBB_CONTAINERS_WORK_STEALING_DEQUE_H_
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./bag_test.h"
+
+#include <embb/base/thread.h>
+#include <embb/base/c/internal/thread_index.h>
+#include <algorithm>
+
+namespace embb {
+namespace containers {
+namespace test {
+BagTest::BagTest() :
+  n_threads(static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads())),
+  n_elements_per_thread(100),
+  bag(NULL),
+  thread_local_vectors(NULL) {
+  CreateUnit("BagTestSingleThread").
+    Pre(&BagTest::BagTestSingleThread_Pre, this).
+    Add(&BagTest::BagTestSingleThread_ThreadMethod, this).
+    Post(&BagTest::BagTest_Post, this);
+
+  // Each thread adds its own elements and takes the same number of
+  // elements, possibly stolen from other threads.
+  CreateUnit("BagTestMultipleThreads").
+    Pre(&BagTest::BagTestMultipleThreads_Pre, this).
+    Add(&BagTest::BagTestMultipleThreads_ThreadMethod, this,
+    static_cast<size_t>(n_threads),
+    static_cast<size_t>(partest::TestSuite::GetDefaultNumIterations())).
+    Post(&BagTest::BagTestMultipleThreads_Post, this);
+}
+
+void BagTest::BagTestSingleThread_Pre() {
+  bag = new Bag_t(static_cast<size_t>(n_elements_per_thread));
+}
+
+void BagTest::BagTestSingleThread_ThreadMethod() {
+  int element = -1;
+  PT_EXPECT(!bag->TryTake(element));
+  PT_EXPECT_EQ(element, -1);
+
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    PT_ASSERT(bag->TryAdd(i));
+  }
+
+  ::std::vector<int> taken;
+  while (bag->TryTake(element)) {
+    taken.push_back(element);
+  }
+  PT_ASSERT_EQ(taken.size(), static_cast<size_t>(n_elements_per_thread));
+  ::std::sort(taken.begin(), taken.end());
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    PT_EXPECT_EQ(taken[static_cast<size_t>(i)], i);
+  }
+}
+
+void BagTest::BagTestMultipleThreads_Pre() {
+  embb_internal_thread_index_reset();
+  bag = new Bag_t(static_cast<size_t>(n_threads * n_elements_per_thread));
+  thread_local_vectors =
+    new ::std::vector<int>[static_cast<size_t>(n_threads)];
+}
+
+void BagTest::BagTestMultipleThreads_ThreadMethod() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+  PT_ASSERT(return_val == EMBB_SUCCESS);
+  PT_ASSERT_LT(thread_index, static_cast<unsigned int>(n_threads));
+
+  ::std::vector<int>& taken = thread_local_vectors[thread_index];
+  int offset = static_cast<int>(thread_index) * n_elements_per_thread;
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    PT_ASSERT(bag->TryAdd(offset + i));
+  }
+  // Each thread takes at most as many elements as it added, so the bag is
+  // never empty here. TryTake might still fail if elements are added to
+  // lists it already visited, retry in that case.
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    int element;
+    while (!bag->TryTake(element)) {
+      embb::base::Thread::CurrentYield();
+    }
+    taken.push_back(element);
+  }
+}
+
+void BagTest::BagTestMultipleThreads_Post() {
+  ::std::vector<int> taken;
+  for (int t = 0; t != n_threads; ++t) {
+    taken.insert(taken.end(), thread_local_vectors[t].begin(),
+      thread_local_vectors[t].end());
+  }
+  delete[] thread_local_vectors;
+  thread_local_vectors = NULL;
+
+  // Every element was taken exactly once in each iteration
+  int iterations = static_cast<int>(
+    partest::TestSuite::GetDefaultNumIterations());
+  PT_ASSERT_EQ(taken.size(),
+    static_cast<size_t>(n_threads * n_elements_per_thread * iterations));
+  ::std::sort(taken.begin(), taken.end());
+  for (size_t i = 0; i != taken.size(); ++i) {
+    PT_EXPECT_EQ(taken[i],
+      static_cast<int>(i) / iterations);
+  }
+  int element;
+  PT_EXPECT(!bag->TryTake(element));
+  BagTest_Post();
+}
+
+void BagTest::BagTest_Post() {
+  delete bag;
+  bag = NULL;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
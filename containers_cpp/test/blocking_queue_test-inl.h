@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_BLOCKING_QUEUE_TEST_INL_H_
+#define CONTAINERS_CPP_TEST_BLOCKING_QUEUE_TEST_INL_H_
+
+#include <embb/base/duration.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+template<typename Queue_t, bool MultipleProducersConsumers>
+BlockingQueueTest<Queue_t, MultipleProducersConsumers>::BlockingQueueTest() :
+  n_threads(MultipleProducersConsumers ? 4 : 2),
+  n_elements_per_producer(1000),
+  queue(NULL) {
+  CreateUnit("BlockingQueueTestTimeout").
+    Pre(&BlockingQueueTest::BlockingQueueTestTimeout_Pre, this).
+    Add(&BlockingQueueTest::BlockingQueueTestTimeout_ThreadMethod, this).
+    Post(&BlockingQueueTest::BlockingQueueTest_Post, this);
+
+  // Half of the threads produce, the other half consumes. The queue is
+  // small, so that both producers and consumers have to wait.
+  CreateUnit("BlockingQueueTestProducerConsumer").
+    Pre(&BlockingQueueTest::BlockingQueueTestProducerConsumer_Pre, this).
+    Add(&BlockingQueueTest::BlockingQueueTestProducerConsumer_ThreadMethod,
+    this, static_cast<size_t>(n_threads), static_cast<size_t>(1)).
+    Post(&BlockingQueueTest::BlockingQueueTestProducerConsumer_Post, this);
+}
+
+template<typename Queue_t, bool MultipleProducersConsumers>
+void BlockingQueueTest<Queue_t, MultipleProducersConsumers>::
+BlockingQueueTestTimeout_Pre() {
+  queue = new Queue_t(static_cast<size_t>(QUEUE_SIZE));
+}
+
+template<typename Queue_t, bool MultipleProducersConsumers>
+void BlockingQueueTest<Queue_t, MultipleProducersConsumers>::
+BlockingQueueTestTimeout_ThreadMethod() {
+  const embb::base::Duration<embb::base::Milliseconds> timeout(10);
+  int element = -1;
+
+  // Nothing to dequeue
+  PT_EXPECT(!queue->Dequeue(element, timeout));
+  PT_EXPECT_EQ(element, -1);
+
+  // Fill the queue, it might hold more elements than its capacity
+  int size = 0;
+  while (queue->TryEnqueue(size)) {
+    ++size;
+  }
+  PT_ASSERT_GE(size, static_cast<int>(QUEUE_SIZE));
+  PT_EXPECT(!queue->Enqueue(size, timeout));
+
+  // Elements are available, so neither variant has to wait
+  queue->Dequeue(element);
+  PT_EXPECT_EQ(element, 0);
+  for (int i = 1; i != size; ++i) {
+    PT_EXPECT(queue->Dequeue(element, timeout));
+    PT_EXPECT_EQ(element, i);
+  }
+  PT_EXPECT(!queue->Dequeue(element, timeout));
+}
+
+template<typename Queue_t, bool MultipleProducersConsumers>
+void BlockingQueueTest<Queue_t, MultipleProducersConsumers>::
+BlockingQueueTestProducerConsumer_Pre() {
+  queue = new Queue_t(static_cast<size_t>(QUEUE_SIZE));
+  next_thread_id = 0;
+  produced_sum = 0;
+  consumed_sum = 0;
+}
+
+template<typename Queue_t, bool MultipleProducersConsumers>
+void BlockingQueueTest<Queue_t, MultipleProducersConsumers>::
+BlockingQueueTestProducerConsumer_ThreadMethod() {
+  int thread_id = next_thread_id.FetchAndAdd(1);
+  int sum = 0;
+  if (thread_id % 2 == 0) {
+    for (int i = 1; i <= n_elements_per_producer; ++i) {
+      int element = thread_id * n_elements_per_producer + i;
+      queue->Enqueue(element);
+      sum += element;
+    }
+    produced_sum.FetchAndAdd(sum);
+  } else {
+    for (int i = 0; i != n_elements_per_producer; ++i) {
+      int element;
+      queue->Dequeue(element);
+      sum += element;
+    }
+    consumed_sum.FetchAndAdd(sum);
+  }
+}
+
+template<typename Queue_t, bool MultipleProducersConsumers>
+void BlockingQueueTest<Queue_t, MultipleProducersConsumers>::
+BlockingQueueTestProducerConsumer_Post() {
+  PT_EXPECT_EQ(produced_sum.Load(), consumed_sum.Load());
+  int element;
+  PT_EXPECT(!queue->TryDequeue(element));
+  BlockingQueueTest_Post();
+}
+
+template<typename Queue_t, bool MultipleProducersConsumers>
+void BlockingQueueTest<Queue_t, MultipleProducersConsumers>::
+BlockingQueueTest_Post() {
+  delete queue;
+  queue = NULL;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
+
+#endif  // CONTAINERS_CPP_TEST_BLOCKING_QUEUE_TEST_INL_H_
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_BLOCKING_QUEUE_TEST_H_
+#define CONTAINERS_CPP_TEST_BLOCKING_QUEUE_TEST_H_
+
+#include <partest/partest.h>
+#include <embb/base/atomic.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+template<typename Queue_t, bool MultipleProducersConsumers = false>
+class BlockingQueueTest : public partest::TestCase {
+ private:
+  /// Capacity of the queue, small to let producers wait
+  static const int QUEUE_SIZE = 4;
+
+  int n_threads;
+  int n_elements_per_producer;
+  Queue_t* queue;
+  embb::base::Atomic<int> next_thread_id;
+  embb::base::Atomic<int> produced_sum;
+  embb::base::Atomic<int> consumed_sum;
+
+  void BlockingQueueTestTimeout_Pre();
+  void BlockingQueueTestTimeout_ThreadMethod();
+  void BlockingQueueTestProducerConsumer_Pre();
+  void BlockingQueueTestProducerConsumer_ThreadMethod();
+  void BlockingQueueTestProducerConsumer_Post();
+  void BlockingQueueTest_Post();
+
+ public:
+  /**
+   * Adds test methods.
+   */
+  BlockingQueueTest();
+};
+} // namespace test
+} // namespace containers
+} // namespace embb
+
+#include "./blocking_queue_test-inl.h"
+
+#endif  // CONTAINERS_CPP_TEST_BLOCKING_QUEUE_TEST_H_
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./hash_map_test.h"
+
+#include <embb/base/c/internal/thread_index.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+HashMapTest::HashMapTest() :
+  n_threads(static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads())),
+  n_elements_per_thread(200),
+  map(NULL) {
+  CreateUnit("HashMapTestSingleThread").
+    Pre(&HashMapTest::HashMapTestSingleThread_Pre, this).
+    Add(&HashMapTest::HashMapTestSingleThread_ThreadMethod, this).
+    Post(&HashMapTest::HashMapTest_Post, this);
+
+  // Each thread inserts, finds, and erases its own keys, while reading the
+  // keys of the other threads. Keys of all threads hash to common buckets.
+  CreateUnit("HashMapTestMultipleThreads").
+    Pre(&HashMapTest::HashMapTestMultipleThreads_Pre, this).
+    Add(&HashMapTest::HashMapTestMultipleThreads_ThreadMethod, this,
+    static_cast<size_t>(n_threads),
+    static_cast<size_t>(partest::TestSuite::GetDefaultNumIterations())).
+    Post(&HashMapTest::HashMapTest_Post, this);
+}
+
+void HashMapTest::HashMapTestSingleThread_Pre() {
+  map = new Map_t(static_cast<size_t>(n_elements_per_thread));
+}
+
+void HashMapTest::HashMapTestSingleThread_ThreadMethod() {
+  size_t initial_bucket_count = map->GetBucketCount();
+
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    PT_ASSERT(map->TryInsert(i, i * 3));
+  }
+  PT_EXPECT_EQ(map->GetSize(), static_cast<size_t>(n_elements_per_thread));
+
+  // Inserting exceeds the load factor, buckets must have been split
+  PT_EXPECT_GT(map->GetBucketCount(), initial_bucket_count);
+
+  // Keys are unique
+  PT_EXPECT(!map->TryInsert(0, 1));
+  PT_EXPECT(!map->TryInsert(n_elements_per_thread - 1, 1));
+
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    int value = -1;
+    PT_ASSERT(map->TryFind(i, value));
+    PT_EXPECT_EQ(value, i * 3);
+  }
+
+  int value = -1;
+  PT_EXPECT(!map->TryFind(n_elements_per_thread, value));
+  PT_EXPECT_EQ(value, -1);
+
+  // Erase every second element
+  for (int i = 0; i < n_elements_per_thread; i += 2) {
+    PT_ASSERT(map->TryErase(i));
+  }
+  PT_EXPECT(!map->TryErase(0));
+
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    PT_EXPECT_EQ(map->TryFind(i, value), (i % 2) != 0);
+  }
+
+  for (int i = 1; i < n_elements_per_thread; i += 2) {
+    PT_ASSERT(map->TryErase(i));
+  }
+  PT_EXPECT_EQ(map->GetSize(), static_cast<size_t>(0));
+}
+
+void HashMapTest::HashMapTestMultipleThreads_Pre() {
+  embb_internal_thread_index_reset();
+  map = new Map_t(static_cast<size_t>(n_elements_per_thread * n_threads));
+}
+
+void HashMapTest::HashMapTestMultipleThreads_ThreadMethod() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+  PT_ASSERT(EMBB_SUCCESS == return_val);
+
+  int offset = static_cast<int>(thread_index) * n_elements_per_thread;
+
+  for (int i = offset; i != offset + n_elements_per_thread; ++i) {
+    PT_ASSERT(map->TryInsert(i, -i));
+  }
+
+  for (int i = 0; i != n_elements_per_thread * n_threads; ++i) {
+    int value = 1;
+    if (map->TryFind(i, value)) {
+      // Whoever inserted the key, the value must match
+      PT_ASSERT_EQ(value, -i);
+    }
+  }
+
+  for (int i = offset; i != offset + n_elements_per_thread; ++i) {
+    int value = 1;
+    PT_ASSERT(map->TryFind(i, value));
+    PT_ASSERT_EQ(value, -i);
+    PT_ASSERT(map->TryErase(i));
+    PT_ASSERT(!map->TryFind(i, value));
+  }
+}
+
+void HashMapTest::HashMapTest_Post() {
+  PT_EXPECT_EQ(map->GetSize(), static_cast<size_t>(0));
+  delete map;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
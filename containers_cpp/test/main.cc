@@ -26,10 +26,15 @@
 
 #include <embb/containers/lock_free_tree_value_pool.h>
 #include <embb/containers/wait_free_array_value_pool.h>
+#include <embb/containers/lock_free_bitmap_value_pool.h>
 #include <embb/containers/wait_free_spsc_queue.h>
 #include <embb/containers/object_pool.h>
 #include <embb/containers/lock_free_stack.h>
 #include <embb/containers/lock_free_mpmc_queue.h>
+#include <embb/containers/lock_free_unbounded_mpmc_queue.h>
+#include <embb/containers/lock_free_priority_queue.h>
+#include <embb/containers/relaxed_priority_queue.h>
+#include <embb/containers/blocking_queue.h>
 #include <embb/base/c/memory_allocation.h>
 
 #include <partest/partest.h>
@@ -40,6 +45,15 @@
 #include "./stack_test.h"
 #include "./hazard_pointer_test.h"
 #include "./object_pool_test.h"
+#include "./hash_map_test.h"
+#include "./priority_queue_test.h"
+#include "./skip_list_test.h"
+#include "./blocking_queue_test.h"
+#include "./work_stealing_deque_test.h"
+#include "./bag_test.h"
+#include "./vector_test.h"
+#include "./mpsc_queue_test.h"
+#include "./ring_test.h"
 
 #define COMMA ,
 
@@ -47,14 +61,31 @@ using embb::containers::WaitFreeArrayValuePool;
 using embb::containers::LockFreeTreeValuePool;
 using embb::containers::WaitFreeSPSCQueue;
 using embb::containers::LockFreeMPMCQueue;
+using embb::containers::LockFreeUnboundedMPMCQueue;
 using embb::containers::LockFreeStack;
 using embb::containers::LockFreeTreeValuePool;
 using embb::containers::WaitFreeArrayValuePool;
+using embb::containers::LockFreeBitmapValuePool;
 using embb::containers::test::PoolTest;
 using embb::containers::test::HazardPointerTest;
 using embb::containers::test::QueueTest;
 using embb::containers::test::StackTest;
 using embb::containers::test::ObjectPoolTest;
+using embb::containers::internal::EpochReclamation;
+using embb::containers::test::HashMapTest;
+using embb::containers::LockFreePriorityQueue;
+using embb::containers::RelaxedPriorityQueue;
+using embb::containers::test::PriorityQueueTest;
+using embb::containers::test::SkipListTest;
+using embb::containers::BlockingQueue;
+using embb::containers::test::BlockingQueueTest;
+using embb::containers::test::WorkStealingDequeTest;
+using embb::containers::test::BagTest;
+using embb::containers::test::VectorTest;
+using embb::containers::test::MPSCQueueTest;
+using embb::containers::test::RingTest;
+using embb::containers::internal::HazardPointer;
+using embb::base::AllocatorCacheAligned;
 
 PT_MAIN("Data Structures C++") {
   unsigned int max_threads = static_cast<unsigned int>(
@@ -63,13 +94,47 @@ PT_MAIN("Data Structures C++") {
 
   PT_RUN(PoolTest< WaitFreeArrayValuePool<int COMMA -1> >);
   PT_RUN(PoolTest< LockFreeTreeValuePool<int COMMA -1> >);
+  PT_RUN(PoolTest< LockFreeBitmapValuePool<int COMMA -1> >);
   PT_RUN(HazardPointerTest);
   PT_RUN(QueueTest< WaitFreeSPSCQueue< ::std::pair<size_t COMMA int> > >);
   PT_RUN(QueueTest< LockFreeMPMCQueue< ::std::pair<size_t COMMA int> >
     COMMA true COMMA true >);
+  PT_RUN(QueueTest< LockFreeMPMCQueue< ::std::pair<size_t COMMA int>
+    COMMA LockFreeTreeValuePool<bool COMMA false> COMMA EpochReclamation >
+    COMMA true COMMA true >);
+  PT_RUN(QueueTest< LockFreeMPMCQueue< ::std::pair<size_t COMMA int>
+    COMMA LockFreeTreeValuePool<bool COMMA false> COMMA HazardPointer
+    COMMA AllocatorCacheAligned<int> > COMMA true COMMA true >);
+  PT_RUN(QueueTest< LockFreeUnboundedMPMCQueue< ::std::pair<size_t COMMA int> >
+    COMMA true COMMA true >);
+  PT_RUN(QueueTest< LockFreeUnboundedMPMCQueue< ::std::pair<size_t COMMA int>
+    COMMA 4 COMMA EpochReclamation > COMMA true COMMA true >);
+  PT_RUN(QueueTest< BlockingQueue< ::std::pair<size_t COMMA int> >
+    COMMA true COMMA true >);
+  PT_RUN(BlockingQueueTest< BlockingQueue<int COMMA WaitFreeSPSCQueue<int> > >);
+  PT_RUN(BlockingQueueTest< BlockingQueue<int> COMMA true >);
+  PT_RUN(MPSCQueueTest);
+  PT_RUN(RingTest);
   PT_RUN(StackTest< LockFreeStack<int> >);
+  PT_RUN(StackTest< LockFreeStack<int COMMA
+    LockFreeTreeValuePool<bool COMMA false> COMMA EpochReclamation> >);
+  PT_RUN(StackTest< LockFreeStack<int> COMMA 16 >);
   PT_RUN(ObjectPoolTest< LockFreeTreeValuePool<bool COMMA false > >);
   PT_RUN(ObjectPoolTest< WaitFreeArrayValuePool<bool COMMA false> >);
+  PT_RUN(ObjectPoolTest< LockFreeBitmapValuePool<bool COMMA false> >);
+  PT_RUN(ObjectPoolTest< LockFreeTreeValuePool<bool COMMA false> COMMA 16 >);
+  PT_RUN(ObjectPoolTest< WaitFreeArrayValuePool<bool COMMA false> COMMA 16 >);
+  PT_RUN(ObjectPoolTest< LockFreeBitmapValuePool<bool COMMA false> COMMA 16 >);
+  PT_RUN(ObjectPoolTest< LockFreeTreeValuePool<bool COMMA false> COMMA 16
+    COMMA AllocatorCacheAligned<embb::containers::test::ObjectPoolTestStruct>
+    >);
+  PT_RUN(HashMapTest);
+  PT_RUN(PriorityQueueTest< LockFreePriorityQueue<int COMMA int> >);
+  PT_RUN(PriorityQueueTest< RelaxedPriorityQueue<int COMMA int> >);
+  PT_RUN(SkipListTest);
+  PT_RUN(WorkStealingDequeTest);
+  PT_RUN(BagTest);
+  PT_RUN(VectorTest);
 
   PT_EXPECT(embb_get_bytes_allocated() == 0);
 }
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./mpsc_queue_test.h"
+
+#include <embb/base/thread.h>
+#include <vector>
+
+namespace embb {
+namespace containers {
+namespace test {
+MPSCQueueTest::MPSCQueueTest() :
+  n_threads(static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads())),
+  n_elements_per_producer(10000),
+  queue(NULL),
+  elements(NULL) {
+  if (n_threads < 2) {
+    n_threads = 2;
+  }
+
+  CreateUnit("MPSCQueueTestSingleThread").
+    Pre(&MPSCQueueTest::MPSCQueueTestSingleThread_Pre, this).
+    Add(&MPSCQueueTest::MPSCQueueTestSingleThread_ThreadMethod, this).
+    Post(&MPSCQueueTest::MPSCQueueTest_Post, this);
+
+  // One consumer, all other threads produce. The consumer has to receive
+  // the elements of each producer in order.
+  CreateUnit("MPSCQueueTestMultipleProducers").
+    Pre(&MPSCQueueTest::MPSCQueueTestMultipleProducers_Pre, this).
+    Add(&MPSCQueueTest::MPSCQueueTestMultipleProducers_ThreadMethod,
+    this, static_cast<size_t>(n_threads), static_cast<size_t>(1)).
+    Post(&MPSCQueueTest::MPSCQueueTest_Post, this);
+}
+
+void MPSCQueueTest::MPSCQueueTestSingleThread_Pre() {
+  queue = new Queue_t;
+  elements = new MPSCQueueTestElement[static_cast<size_t>(
+    n_elements_per_producer)];
+}
+
+void MPSCQueueTest::MPSCQueueTestSingleThread_ThreadMethod() {
+  PT_EXPECT(queue->TryDequeue() == NULL);
+
+  // Alternate between a single element and several elements in the queue,
+  // such that the stub is passed in both states
+  for (int i = 0; i != n_elements_per_producer; ++i) {
+    elements[i].sequence = i;
+  }
+  for (int i = 0; i != 10; ++i) {
+    queue->Enqueue(&elements[i]);
+    PT_ASSERT(queue->TryDequeue() == &elements[i]);
+    PT_EXPECT(queue->TryDequeue() == NULL);
+  }
+  for (int i = 0; i != n_elements_per_producer; ++i) {
+    queue->Enqueue(&elements[i]);
+  }
+  for (int i = 0; i != n_elements_per_producer / 2; ++i) {
+    MPSCQueueTestElement* element = queue->TryDequeue();
+    PT_ASSERT(element != NULL);
+    PT_EXPECT_EQ(element->sequence, i);
+  }
+
+  // Drain the rest in batches
+  MPSCQueueTestElement* batch[64];
+  int next = n_elements_per_producer / 2;
+  size_t count;
+  while ((count = queue->TryDequeueBatch(batch, 64)) != 0) {
+    for (size_t i = 0; i != count; ++i) {
+      PT_EXPECT_EQ(batch[i]->sequence, next++);
+    }
+  }
+  PT_EXPECT_EQ(next, n_elements_per_producer);
+  PT_EXPECT(queue->TryDequeue() == NULL);
+
+  // Elements can be enqueued again after they were dequeued
+  queue->Enqueue(&elements[0]);
+  PT_EXPECT(queue->TryDequeue() == &elements[0]);
+}
+
+void MPSCQueueTest::MPSCQueueTestMultipleProducers_Pre() {
+  queue = new Queue_t;
+  next_thread_id = 0;
+  elements = new MPSCQueueTestElement[static_cast<size_t>(
+    (n_threads - 1) * n_elements_per_producer)];
+}
+
+void MPSCQueueTest::MPSCQueueTestMultipleProducers_ThreadMethod() {
+  int thread_id = next_thread_id.FetchAndAdd(1);
+  if (thread_id == 0) {
+    ::std::vector<int> expected(static_cast<size_t>(n_threads), 0);
+    int remaining = (n_threads - 1) * n_elements_per_producer;
+    MPSCQueueTestElement* batch[16];
+    while (remaining != 0) {
+      size_t count = queue->TryDequeueBatch(batch, 16);
+      if (count == 0) {
+        embb::base::Thread::CurrentYield();
+      }
+      for (size_t i = 0; i != count; ++i) {
+        int producer = batch[i]->producer;
+        PT_ASSERT(producer > 0 && producer < n_threads);
+        PT_EXPECT_EQ(batch[i]->sequence,
+          expected[static_cast<size_t>(producer)]++);
+      }
+      remaining -= static_cast<int>(count);
+    }
+    PT_EXPECT(queue->TryDequeue() == NULL);
+  } else {
+    MPSCQueueTestElement* own_elements =
+      &elements[(thread_id - 1) * n_elements_per_producer];
+    for (int i = 0; i != n_elements_per_producer; ++i) {
+      own_elements[i].producer = thread_id;
+      own_elements[i].sequence = i;
+      queue->Enqueue(&own_elements[i]);
+    }
+  }
+}
+
+void MPSCQueueTest::MPSCQueueTest_Post() {
+  delete queue;
+  queue = NULL;
+  delete[] elements;
+  elements = NULL;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
@@ -33,15 +33,16 @@
 namespace embb {
 namespace containers {
 namespace test {
-template<typename ValuePool>
-ObjectPoolTest<ValuePool>::ObjectPoolTest() :
+template<typename ValuePool, size_t ThreadCacheSize,
+  class ObjectAllocator>
+ObjectPoolTest<ValuePool, ThreadCacheSize, ObjectAllocator>::ObjectPoolTest() :
 number_threads_(static_cast<int>
   (partest::TestSuite::GetDefaultNumThreads())),
 number_iterations_(static_cast<int>
   (partest::TestSuite::GetDefaultNumIterations())),
 allocations_per_thread(100),
 allocations(allocations_per_thread*number_threads_),
-objectPool(static_cast<size_t>(allocations)) {
+objectPool(static_cast<size_t>(allocations), ThreadCacheSize) {
   CreateUnit("ParallelObjectPoolTest").
     Pre(&ObjectPoolTest::ParallelObjectPoolTest_Pre, this).
     Add(&ObjectPoolTest::ParallelObjectPoolTest_ThreadMethod, this,
@@ -50,13 +51,17 @@ objectPool(static_cast<size_t>(allocations)) {
     Post(&ObjectPoolTest::ParallelObjectPoolTest_Post, this);
 }
 
-template<typename ValuePool>
-void ObjectPoolTest<ValuePool>::ParallelObjectPoolTest_Pre() {
+template<typename ValuePool, size_t ThreadCacheSize,
+  class ObjectAllocator>
+void ObjectPoolTest<ValuePool, ThreadCacheSize, ObjectAllocator>::
+ParallelObjectPoolTest_Pre() {
   embb_internal_thread_index_reset();
 }
 
-template<typename ValuePool>
-void ObjectPoolTest<ValuePool>::ParallelObjectPoolTest_Post() {
+template<typename ValuePool, size_t ThreadCacheSize,
+  class ObjectAllocator>
+void ObjectPoolTest<ValuePool, ThreadCacheSize, ObjectAllocator>::
+ParallelObjectPoolTest_Post() {
   //everything should be freed, we should be able to allocate everything...
   ::std::vector<ObjectPoolTestStruct*> allocated;
 
@@ -66,16 +71,29 @@ void ObjectPoolTest<ValuePool>::ParallelObjectPoolTest_Post() {
     allocated.push_back(objectPool.Allocate(i));
   }
 
+  // Without thread caches, the capacity is exact
+  if (ThreadCacheSize == 0) {
+    PT_EXPECT(objectPool.Allocate(-1) == NULL);
+  }
+
   for (unsigned int i = 0;
     i != static_cast<unsigned int>(allocated.size()); ++i) {
     // check that objects are disjoint
     PT_ASSERT(static_cast<unsigned int>(allocated[i]->GetThreadId()) == i);
+    // Padded objects start at cache line boundaries
+    if (embb::containers::internal::ObjectPoolSlotSize<ObjectPoolTestStruct,
+      ObjectAllocator>::value % EMBB_PLATFORM_CACHE_LINE_SIZE == 0) {
+      PT_EXPECT_EQ(reinterpret_cast<size_t>(allocated[i]) %
+        EMBB_PLATFORM_CACHE_LINE_SIZE, static_cast<size_t>(0));
+    }
     objectPool.Free(allocated[i]);
   }
 }
 
-template<typename ValuePool>
-void ObjectPoolTest<ValuePool>::ParallelObjectPoolTest_ThreadMethod() {
+template<typename ValuePool, size_t ThreadCacheSize,
+  class ObjectAllocator>
+void ObjectPoolTest<ValuePool, ThreadCacheSize, ObjectAllocator>::
+ParallelObjectPoolTest_ThreadMethod() {
   unsigned int thread_index;
 
   int return_val = embb_internal_thread_index(&thread_index);
@@ -98,6 +116,9 @@ void ObjectPoolTest<ValuePool>::ParallelObjectPoolTest_ThreadMethod() {
       static_cast<int>(thread_index));
     objectPool.Free(allocated[i]);
   }
+
+  // Return the cached elements before the thread exits
+  objectPool.FlushThreadCache();
 }
 } // namespace test
 } // namespace containers
@@ -42,14 +42,18 @@ class ObjectPoolTestStruct {
   int GetThreadId() const;
 };
 
-template<typename ValuePool>
+template<typename ValuePool,
+  size_t ThreadCacheSize = embb::containers::ObjectPool<ObjectPoolTestStruct,
+    ValuePool>::DEFAULT_THREAD_CACHE_SIZE,
+  class ObjectAllocator = embb::base::Allocator<ObjectPoolTestStruct> >
 class ObjectPoolTest : public partest::TestCase {
  private:
   int number_threads_;
   int number_iterations_;
   int allocations_per_thread;
   int allocations;
-  embb::containers::ObjectPool<ObjectPoolTestStruct, ValuePool> objectPool;
+  embb::containers::ObjectPool<ObjectPoolTestStruct, ValuePool,
+    ObjectAllocator> objectPool;
 
   void ParallelObjectPoolTest_Pre();
   void ParallelObjectPoolTest_Post();
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_PRIORITY_QUEUE_TEST_INL_H_
+#define CONTAINERS_CPP_TEST_PRIORITY_QUEUE_TEST_INL_H_
+
+#include <vector>
+#include <algorithm>
+
+#include <embb/base/c/internal/thread_index.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+template<typename PriorityQueue_t>
+PriorityQueueTest<PriorityQueue_t>::PriorityQueueTest() :
+  n_threads(static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads())),
+  n_elements_per_thread(200),
+  queue(NULL),
+  thread_local_vectors(NULL) {
+  CreateUnit("PriorityQueueTestSingleThread").
+    Pre(&PriorityQueueTest::PriorityQueueTestSingleThread_Pre, this).
+    Add(&PriorityQueueTest::PriorityQueueTestSingleThread_ThreadMethod, this).
+    Post(&PriorityQueueTest::PriorityQueueTestSingleThread_Post, this);
+
+  // Each thread inserts its elements and then removes as many elements as it
+  // inserted, possibly ones of other threads.
+  CreateUnit("PriorityQueueTestMultipleThreads").
+    Pre(&PriorityQueueTest::PriorityQueueTestMultipleThreads_Pre, this).
+    Add(&PriorityQueueTest::PriorityQueueTestMultipleThreads_ThreadMethod,
+    this, static_cast<size_t>(n_threads)).
+    Post(&PriorityQueueTest::PriorityQueueTestMultipleThreads_Post, this);
+}
+
+template<typename PriorityQueue_t>
+int PriorityQueueTest<PriorityQueue_t>::GetKey(int value) {
+  return (value * 7919) % 97;
+}
+
+template<typename PriorityQueue_t>
+void PriorityQueueTest<PriorityQueue_t>::PriorityQueueTestSingleThread_Pre() {
+  embb_internal_thread_index_reset();
+  queue = new PriorityQueue_t(static_cast<size_t>(n_elements_per_thread));
+}
+
+template<typename PriorityQueue_t>
+void PriorityQueueTest<PriorityQueue_t>::
+PriorityQueueTestSingleThread_ThreadMethod() {
+  int key = -1;
+  int value = -1;
+  PT_EXPECT(!queue->TryDeleteMin(key, value));
+
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    PT_ASSERT(queue->TryInsert(GetKey(i), i));
+  }
+
+  // Without concurrent operations, the order is exact
+  std::vector<bool> removed(static_cast<size_t>(n_elements_per_thread),
+    false);
+  int previous_key = -1;
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    PT_ASSERT(queue->TryDeleteMin(key, value));
+    PT_ASSERT(value >= 0 && value < n_elements_per_thread);
+    PT_EXPECT_EQ(key, GetKey(value));
+    PT_EXPECT(!removed[static_cast<size_t>(value)]);
+    PT_EXPECT_GE(key, previous_key);
+    removed[static_cast<size_t>(value)] = true;
+    previous_key = key;
+  }
+  PT_EXPECT(!queue->TryDeleteMin(key, value));
+}
+
+template<typename PriorityQueue_t>
+void PriorityQueueTest<PriorityQueue_t>::
+PriorityQueueTestSingleThread_Post() {
+  delete queue;
+}
+
+template<typename PriorityQueue_t>
+void PriorityQueueTest<PriorityQueue_t>::
+PriorityQueueTestMultipleThreads_Pre() {
+  embb_internal_thread_index_reset();
+  queue = new PriorityQueue_t(
+    static_cast<size_t>(n_elements_per_thread * n_threads));
+  thread_local_vectors =
+    new std::vector<int>[static_cast<unsigned int>(n_threads)];
+}
+
+template<typename PriorityQueue_t>
+void PriorityQueueTest<PriorityQueue_t>::
+PriorityQueueTestMultipleThreads_ThreadMethod() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+  PT_ASSERT(EMBB_SUCCESS == return_val);
+
+  int offset = static_cast<int>(thread_index) * n_elements_per_thread;
+  for (int i = offset; i != offset + n_elements_per_thread; ++i) {
+    PT_ASSERT(queue->TryInsert(GetKey(i), i));
+  }
+
+  // There are always more insertions than removals, but relaxed queues may
+  // fail if the remaining elements are in use by other threads.
+  std::vector<int>& removed = thread_local_vectors[thread_index];
+  while (removed.size() != static_cast<size_t>(n_elements_per_thread)) {
+    int key;
+    int value;
+    if (queue->TryDeleteMin(key, value)) {
+      PT_ASSERT_EQ(key, GetKey(value));
+      removed.push_back(value);
+    }
+  }
+}
+
+template<typename PriorityQueue_t>
+void PriorityQueueTest<PriorityQueue_t>::
+PriorityQueueTestMultipleThreads_Post() {
+  // Each element must have been removed exactly once
+  std::vector<int> removed;
+  for (int i = 0; i != n_threads; ++i) {
+    removed.insert(removed.end(), thread_local_vectors[i].begin(),
+      thread_local_vectors[i].end());
+  }
+  std::sort(removed.begin(), removed.end());
+  PT_ASSERT_EQ(removed.size(),
+    static_cast<size_t>(n_elements_per_thread * n_threads));
+  for (size_t i = 0; i != removed.size(); ++i) {
+    PT_ASSERT_EQ(removed[i], static_cast<int>(i));
+  }
+
+  int key;
+  int value;
+  PT_EXPECT(!queue->TryDeleteMin(key, value));
+
+  delete[] thread_local_vectors;
+  delete queue;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
+
+#endif  // CONTAINERS_CPP_TEST_PRIORITY_QUEUE_TEST_INL_H_
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./ring_test.h"
+
+#include <embb/base/thread.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+RingTest::RingTest() :
+  n_threads(static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads())),
+  n_entries_per_writer(20000),
+  ring(NULL) {
+  if (n_threads < 2) {
+    n_threads = 2;
+  }
+
+  CreateUnit("RingTestSingleThread").
+    Pre(&RingTest::RingTestSingleThread_Pre, this).
+    Add(&RingTest::RingTestSingleThread_ThreadMethod, this).
+    Post(&RingTest::RingTest_Post, this);
+
+  CreateUnit("RingTestWrapAround").
+    Add(&RingTest::RingTestWrapAround_ThreadMethod, this);
+
+  // One reader takes snapshots while all other threads write. Every entry
+  // read has to be consistent and the entries of each writer have to
+  // appear in order.
+  CreateUnit("RingTestMultipleThreads").
+    Pre(&RingTest::RingTestMultipleThreads_Pre, this).
+    Add(&RingTest::RingTestMultipleThreads_ThreadMethod,
+    this, static_cast<size_t>(n_threads), static_cast<size_t>(1)).
+    Post(&RingTest::RingTest_Post, this);
+}
+
+RingTestEntry RingTest::MakeEntry(int writer, int sequence) {
+  RingTestEntry entry;
+  entry.writer = writer;
+  entry.sequence = sequence;
+  entry.check = writer * 7919 + sequence;
+  return entry;
+}
+
+bool RingTest::IsConsistent(RingTestEntry const& entry) {
+  return entry.check == entry.writer * 7919 + entry.sequence;
+}
+
+void RingTest::RingTestSingleThread_Pre() {
+  // Rounded up to 16
+  ring = new Ring_t(10);
+}
+
+void RingTest::RingTestSingleThread_ThreadMethod() {
+  const size_t capacity = 16;
+  PT_ASSERT_EQ(ring->GetCapacity(), capacity);
+
+  RingTestEntry snapshot[32];
+  RingTestEntry entry = MakeEntry(-1, -1);
+  PT_EXPECT_EQ(ring->Snapshot(snapshot, 32), static_cast<size_t>(0));
+  PT_EXPECT(!ring->TryRead(0, entry));
+  PT_EXPECT_EQ(entry.sequence, -1);
+
+  for (int i = 0; i != 5; ++i) {
+    PT_EXPECT_EQ(ring->Write(MakeEntry(0, i)), static_cast<size_t>(i));
+  }
+  PT_ASSERT_EQ(ring->Snapshot(snapshot, 32), static_cast<size_t>(5));
+  for (int i = 0; i != 5; ++i) {
+    PT_EXPECT_EQ(snapshot[i].sequence, i);
+  }
+
+  // Overwrite the oldest entries
+  for (int i = 5; i != 40; ++i) {
+    ring->Write(MakeEntry(0, i));
+  }
+  PT_EXPECT_EQ(ring->GetWritePosition(), static_cast<size_t>(40));
+  PT_ASSERT_EQ(ring->Snapshot(snapshot, 32), capacity);
+  for (size_t i = 0; i != capacity; ++i) {
+    PT_EXPECT_EQ(snapshot[i].sequence, static_cast<int>(40 - capacity + i));
+  }
+  PT_ASSERT_EQ(ring->Snapshot(snapshot, 4), static_cast<size_t>(4));
+  PT_EXPECT_EQ(snapshot[0].sequence, 36);
+  PT_EXPECT_EQ(snapshot[3].sequence, 39);
+
+  PT_EXPECT(!ring->TryRead(10, entry));
+  PT_EXPECT(ring->TryRead(30, entry));
+  PT_EXPECT_EQ(entry.sequence, 30);
+  PT_EXPECT(!ring->TryRead(40, entry));
+}
+
+void RingTest::RingTestWrapAround_ThreadMethod() {
+  const size_t capacity = 16;
+  // Start shortly before the stamps (2*p) and the positions wrap around
+  const size_t max_position = ~static_cast<size_t>(0);
+  const size_t first_positions[] = { max_position / 2 - 20, max_position - 20 };
+
+  for (int start = 0; start != 2; ++start) {
+    size_t first = first_positions[start];
+    Ring_t wrapping_ring(capacity, first);
+    RingTestEntry snapshot[32];
+    RingTestEntry entry = MakeEntry(-1, -1);
+    PT_EXPECT_EQ(wrapping_ring.Snapshot(snapshot, 32), static_cast<size_t>(0));
+    PT_EXPECT(!wrapping_ring.TryRead(first, entry));
+
+    for (int i = 0; i != 40; ++i) {
+      PT_EXPECT_EQ(wrapping_ring.Write(MakeEntry(0, i)),
+        first + static_cast<size_t>(i));
+    }
+    PT_EXPECT_EQ(wrapping_ring.GetWritePosition(), first + 40);
+
+    // No write may have been dropped after the wrap-around
+    PT_ASSERT_EQ(wrapping_ring.Snapshot(snapshot, 32), capacity);
+    for (size_t i = 0; i != capacity; ++i) {
+      PT_EXPECT_EQ(snapshot[i].sequence, static_cast<int>(40 - capacity + i));
+    }
+    PT_EXPECT(wrapping_ring.TryRead(first + 39, entry));
+    PT_EXPECT_EQ(entry.sequence, 39);
+    PT_EXPECT(!wrapping_ring.TryRead(first + 10, entry));
+    PT_EXPECT(!wrapping_ring.TryRead(first + 40, entry));
+  }
+}
+
+void RingTest::RingTestMultipleThreads_Pre() {
+  ring = new Ring_t(64);
+  next_thread_id = 0;
+  n_writers_done = 0;
+}
+
+void RingTest::RingTestMultipleThreads_ThreadMethod() {
+  int thread_id = next_thread_id.FetchAndAdd(1);
+  if (thread_id == 0) {
+    RingTestEntry snapshot[64];
+    bool writers_done;
+    do {
+      writers_done = n_writers_done.Load() == n_threads - 1;
+      size_t count = ring->Snapshot(snapshot, 64);
+      int last_sequence[64];
+      for (int i = 0; i != n_threads && i != 64; ++i) {
+        last_sequence[i] = -1;
+      }
+      for (size_t i = 0; i != count; ++i) {
+        PT_ASSERT(IsConsistent(snapshot[i]));
+        int writer = snapshot[i].writer;
+        PT_ASSERT(writer > 0 && writer < n_threads);
+        if (writer < 64) {
+          PT_EXPECT_GT(snapshot[i].sequence, last_sequence[writer]);
+          last_sequence[writer] = snapshot[i].sequence;
+        }
+      }
+      if (writers_done) {
+        // All writes have completed. Writes may only be dropped if the ring
+        // wrapped around during a write, which leaves most slots intact.
+        PT_EXPECT_GT(count, static_cast<size_t>(0));
+      }
+    } while (!writers_done);
+  } else {
+    for (int i = 0; i != n_entries_per_writer; ++i) {
+      ring->Write(MakeEntry(thread_id, i));
+    }
+    n_writers_done.FetchAndAdd(1);
+  }
+}
+
+void RingTest::RingTest_Post() {
+  delete ring;
+  ring = NULL;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
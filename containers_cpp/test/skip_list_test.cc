@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./skip_list_test.h"
+
+#include <embb/base/c/internal/thread_index.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+SkipListTest::SkipListTest() :
+  n_threads(static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads())),
+  n_elements_per_thread(200),
+  skip_list(NULL) {
+  CreateUnit("SkipListTestSingleThread").
+    Pre(&SkipListTest::SkipListTestSingleThread_Pre, this).
+    Add(&SkipListTest::SkipListTestSingleThread_ThreadMethod, this).
+    Post(&SkipListTest::SkipListTest_Post, this);
+
+  // Each thread inserts, finds, and erases its own keys, which are
+  // interleaved with the keys of the other threads, while iterating over
+  // all keys.
+  CreateUnit("SkipListTestMultipleThreads").
+    Pre(&SkipListTest::SkipListTestMultipleThreads_Pre, this).
+    Add(&SkipListTest::SkipListTestMultipleThreads_ThreadMethod, this,
+    static_cast<size_t>(n_threads),
+    static_cast<size_t>(partest::TestSuite::GetDefaultNumIterations())).
+    Post(&SkipListTest::SkipListTest_Post, this);
+}
+
+void SkipListTest::SkipListTestSingleThread_Pre() {
+  skip_list = new SkipList_t(static_cast<size_t>(n_elements_per_thread));
+}
+
+void SkipListTest::SkipListTestSingleThread_ThreadMethod() {
+  PT_EXPECT(skip_list->Begin() == skip_list->End());
+
+  // Insert even keys in descending order
+  for (int i = n_elements_per_thread - 1; i >= 0; --i) {
+    PT_ASSERT(skip_list->TryInsert(2 * i, i));
+  }
+
+  // Keys are unique
+  PT_EXPECT(!skip_list->TryInsert(0, 1));
+  PT_EXPECT(!skip_list->TryInsert(2 * (n_elements_per_thread - 1), 1));
+
+  for (int i = 0; i != 2 * n_elements_per_thread; ++i) {
+    int value = -1;
+    PT_EXPECT_EQ(skip_list->Contains(i), i % 2 == 0);
+    PT_EXPECT_EQ(skip_list->TryFind(i, value), i % 2 == 0);
+    if (i % 2 == 0) {
+      PT_EXPECT_EQ(value, i / 2);
+    }
+  }
+
+  // Iteration visits keys in ascending order
+  int count = 0;
+  for (SkipList_t::Iterator it = skip_list->Begin(); it != skip_list->End();
+    ++it) {
+    PT_EXPECT_EQ(it->first, 2 * count);
+    PT_EXPECT_EQ(it->second, count);
+    ++count;
+  }
+  PT_EXPECT_EQ(count, n_elements_per_thread);
+
+  // Lower bound of an odd key is the next even key
+  PT_EXPECT_EQ(skip_list->LowerBound(5)->first, 6);
+  PT_EXPECT_EQ(skip_list->LowerBound(6)->first, 6);
+  PT_EXPECT(skip_list->LowerBound(2 * n_elements_per_thread) ==
+    skip_list->End());
+
+  // Erase every second element
+  for (int i = 0; i < n_elements_per_thread; i += 2) {
+    PT_ASSERT(skip_list->TryErase(2 * i));
+  }
+  PT_EXPECT(!skip_list->TryErase(0));
+  PT_EXPECT(!skip_list->TryErase(1));
+  PT_EXPECT_EQ(skip_list->Begin()->first, 2);
+  PT_EXPECT_EQ(skip_list->LowerBound(4)->first, 6);
+
+  // Range iteration over [10, 30)
+  count = 0;
+  for (SkipList_t::Iterator it = skip_list->LowerBound(10);
+    it != skip_list->End() && it->first < 30; it++) {
+    PT_EXPECT_EQ(it->first, 10 + 4 * count);
+    ++count;
+  }
+  PT_EXPECT_EQ(count, 5);
+
+  for (int i = 1; i < n_elements_per_thread; i += 2) {
+    PT_ASSERT(skip_list->TryErase(2 * i));
+  }
+  PT_EXPECT(skip_list->Begin() == skip_list->End());
+}
+
+void SkipListTest::SkipListTestMultipleThreads_Pre() {
+  embb_internal_thread_index_reset();
+  skip_list = new SkipList_t(
+    static_cast<size_t>(n_elements_per_thread * n_threads));
+}
+
+void SkipListTest::SkipListTestMultipleThreads_ThreadMethod() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+  PT_ASSERT(EMBB_SUCCESS == return_val);
+
+  int offset = static_cast<int>(thread_index);
+
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    int key = i * n_threads + offset;
+    PT_ASSERT(skip_list->TryInsert(key, -key));
+  }
+
+  // Iterators are weakly consistent, but keys are strictly ascending and
+  // the own keys are always visited.
+  int previous_key = -1;
+  int own_keys = 0;
+  for (SkipList_t::Iterator it = skip_list->Begin(); it != skip_list->End();
+    ++it) {
+    PT_ASSERT_GT(it->first, previous_key);
+    PT_ASSERT_EQ(it->second, -it->first);
+    if (it->first % n_threads == offset) {
+      ++own_keys;
+    }
+    previous_key = it->first;
+  }
+  PT_ASSERT_EQ(own_keys, n_elements_per_thread);
+
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    int key = i * n_threads + offset;
+    int value = 1;
+    PT_ASSERT(skip_list->TryFind(key, value));
+    PT_ASSERT_EQ(value, -key);
+    PT_ASSERT(skip_list->TryErase(key));
+    PT_ASSERT(!skip_list->Contains(key));
+  }
+}
+
+void SkipListTest::SkipListTest_Post() {
+  PT_EXPECT(skip_list->Begin() == skip_list->End());
+  delete skip_list;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
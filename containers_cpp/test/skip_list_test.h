@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_SKIP_LIST_TEST_H_
+#define CONTAINERS_CPP_TEST_SKIP_LIST_TEST_H_
+
+#include <partest/partest.h>
+#include <embb/containers/lock_free_skip_list.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+class SkipListTest : public partest::TestCase {
+ private:
+  typedef embb::containers::LockFreeSkipList<int, int> SkipList_t;
+
+  int n_threads;
+  int n_elements_per_thread;
+  SkipList_t* skip_list;
+
+  void SkipListTestSingleThread_Pre();
+  void SkipListTestSingleThread_ThreadMethod();
+  void SkipListTestMultipleThreads_Pre();
+  void SkipListTestMultipleThreads_ThreadMethod();
+  void SkipListTest_Post();
+
+ public:
+  /**
+   * Adds test methods.
+   */
+  SkipListTest();
+};
+} // namespace test
+} // namespace containers
+} // namespace embb
+
+#endif  // CONTAINERS_CPP_TEST_SKIP_LIST_TEST_H_
@@ -33,14 +33,16 @@
 namespace embb {
 namespace containers {
 namespace test {
-template<typename Stack_t>
-StackTest<Stack_t>::StackTest() :
+template<typename Stack_t, size_t ThreadCacheSize>
+StackTest<Stack_t, ThreadCacheSize>::StackTest() :
 n_threads(static_cast<int>
   (partest::TestSuite::GetDefaultNumThreads())),
   n_iterations(200),
   n_stack_elements_per_thread(100),
   n_stack_elements(n_stack_elements_per_thread*n_threads),
-  stack(static_cast<size_t>(n_stack_elements)),
+  // All threads push until the stack is full, which must succeed even if
+  // the other threads' caches hold free nodes
+  stack(static_cast<size_t>(n_stack_elements), ThreadCacheSize),
   stackSize(0) {
   CreateUnit("StackTestThreadsPushAndPopToGlobalStack").
   Pre(&StackTest::StackTest1_Pre, this).
@@ -50,8 +52,8 @@ n_threads(static_cast<int>
   Post(&StackTest::StackTest1_Post, this);
 }
 
-template<typename Stack_t>
-void StackTest<Stack_t>::StackTest1_Pre() {
+template<typename Stack_t, size_t ThreadCacheSize>
+void StackTest<Stack_t, ThreadCacheSize>::StackTest1_Pre() {
   embb_internal_thread_index_reset();
   thread_local_vectors =
     new std::vector<int>[static_cast<unsigned int>(n_threads)];
@@ -67,8 +69,8 @@ void StackTest<Stack_t>::StackTest1_Pre() {
   }
 }
 
-template<typename Stack_t>
-void StackTest<Stack_t>::StackTest1_Post() {
+template<typename Stack_t, size_t ThreadCacheSize>
+void StackTest<Stack_t, ThreadCacheSize>::StackTest1_Post() {
   std::vector<int> produced;
   for (int i = 0; i != n_threads; ++i) {
     std::vector<int>& loc_elements = thread_local_vectors[i];
@@ -92,8 +94,8 @@ void StackTest<Stack_t>::StackTest1_Post() {
   delete[] thread_local_vectors;
 }
 
-template<typename Stack_t>
-void StackTest<Stack_t>::StackTest1_ThreadMethod() {
+template<typename Stack_t, size_t ThreadCacheSize>
+void StackTest<Stack_t, ThreadCacheSize>::StackTest1_ThreadMethod() {
   unsigned int thread_index;
   int return_val = embb_internal_thread_index(&thread_index);
 
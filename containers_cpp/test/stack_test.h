@@ -33,7 +33,7 @@
 namespace embb {
 namespace containers {
 namespace test {
-template<typename Stack_t>
+template<typename Stack_t, size_t ThreadCacheSize = 0>
 class StackTest : public partest::TestCase {
  private:
   int n_threads;
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./vector_test.h"
+
+#include <embb/base/c/internal/thread_index.h>
+#include <algorithm>
+#include <vector>
+
+namespace embb {
+namespace containers {
+namespace test {
+VectorTest::VectorTest() :
+  n_threads(static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads())),
+  n_elements_per_thread(1000),
+  vector(NULL) {
+  CreateUnit("VectorTestSingleThread").
+    Pre(&VectorTest::VectorTestSingleThread_Pre, this).
+    Add(&VectorTest::VectorTestSingleThread_ThreadMethod, this).
+    Post(&VectorTest::VectorTest_Post, this);
+
+  // Each thread appends its own elements while reading the elements
+  // appended so far.
+  CreateUnit("VectorTestMultipleThreads").
+    Pre(&VectorTest::VectorTestMultipleThreads_Pre, this).
+    Add(&VectorTest::VectorTestMultipleThreads_ThreadMethod, this,
+    static_cast<size_t>(n_threads),
+    static_cast<size_t>(partest::TestSuite::GetDefaultNumIterations())).
+    Post(&VectorTest::VectorTestMultipleThreads_Post, this);
+}
+
+void VectorTest::VectorTestSingleThread_Pre() {
+  vector = new Vector_t(4);
+}
+
+void VectorTest::VectorTestSingleThread_ThreadMethod() {
+  PT_EXPECT_EQ(vector->GetSize(), static_cast<size_t>(0));
+
+  PT_ASSERT_EQ(vector->PushBack(0), static_cast<size_t>(0));
+  int* first = &(*vector)[0];
+
+  for (int i = 1; i != n_elements_per_thread; ++i) {
+    PT_ASSERT_EQ(vector->PushBack(i), static_cast<size_t>(i));
+    PT_ASSERT_EQ(vector->GetSize(), static_cast<size_t>(i + 1));
+  }
+  // Growing must not move elements
+  PT_EXPECT(first == &(*vector)[0]);
+
+  Vector_t const& const_vector = *vector;
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    PT_EXPECT_EQ(const_vector[static_cast<size_t>(i)], i);
+  }
+}
+
+void VectorTest::VectorTestMultipleThreads_Pre() {
+  embb_internal_thread_index_reset();
+  vector = new Vector_t();
+}
+
+void VectorTest::VectorTestMultipleThreads_ThreadMethod() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+  PT_ASSERT(return_val == EMBB_SUCCESS);
+  PT_ASSERT_LT(thread_index, static_cast<unsigned int>(n_threads));
+
+  // Elements are positive, default constructed ones are zero
+  int offset = static_cast<int>(thread_index) * n_elements_per_thread + 1;
+  int max_element = n_threads * n_elements_per_thread;
+  for (int i = 0; i != n_elements_per_thread; ++i) {
+    size_t index = vector->PushBack(offset + i);
+    PT_ASSERT_EQ((*vector)[index], offset + i);
+
+    // All elements below the size have been written
+    size_t size = vector->GetSize();
+    if (size > 0) {
+      int element = (*vector)[size - 1];
+      PT_EXPECT(element > 0 && element <= max_element);
+    }
+  }
+}
+
+void VectorTest::VectorTestMultipleThreads_Post() {
+  int iterations = static_cast<int>(
+    partest::TestSuite::GetDefaultNumIterations());
+  size_t size = static_cast<size_t>(
+    n_threads * n_elements_per_thread * iterations);
+  PT_ASSERT_EQ(vector->GetSize(), size);
+
+  // Every element was appended once in each iteration
+  ::std::vector<int> elements;
+  for (size_t i = 0; i != size; ++i) {
+    elements.push_back((*vector)[i]);
+  }
+  ::std::sort(elements.begin(), elements.end());
+  for (size_t i = 0; i != size; ++i) {
+    PT_EXPECT_EQ(elements[i], static_cast<int>(i) / iterations + 1);
+  }
+  VectorTest_Post();
+}
+
+void VectorTest::VectorTest_Post() {
+  delete vector;
+  vector = NULL;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./work_stealing_deque_test.h"
+
+#include <embb/base/thread.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+WorkStealingDequeTest::WorkStealingDequeTest() :
+  n_threads(static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads())),
+  n_elements(20000),
+  deque(NULL),
+  taken(NULL) {
+  if (n_threads < 2) {
+    n_threads = 2;
+  }
+
+  CreateUnit("WorkStealingDequeTestSingleThread").
+    Pre(&WorkStealingDequeTest::WorkStealingDequeTestSingleThread_Pre, this).
+    Add(&WorkStealingDequeTest::WorkStealingDequeTestSingleThread_ThreadMethod,
+    this).
+    Post(&WorkStealingDequeTest::WorkStealingDequeTest_Post, this);
+
+  // One owner pushes and pops, all other threads steal. Every element has
+  // to be taken exactly once.
+  CreateUnit("WorkStealingDequeTestStress").
+    Pre(&WorkStealingDequeTest::WorkStealingDequeTestStress_Pre, this).
+    Add(&WorkStealingDequeTest::WorkStealingDequeTestStress_ThreadMethod,
+    this, static_cast<size_t>(n_threads), static_cast<size_t>(1)).
+    Post(&WorkStealingDequeTest::WorkStealingDequeTestStress_Post, this);
+}
+
+void WorkStealingDequeTest::WorkStealingDequeTestSingleThread_Pre() {
+  // Small initial capacity, such that the deque has to grow
+  deque = new Deque_t(2);
+}
+
+void WorkStealingDequeTest::WorkStealingDequeTestSingleThread_ThreadMethod() {
+  int element = -1;
+  PT_EXPECT(!deque->TryPopBottom(element));
+  PT_EXPECT(!deque->TrySteal(element));
+  PT_EXPECT_EQ(element, -1);
+
+  const int size = 100;
+  for (int i = 0; i != size; ++i) {
+    deque->PushBottom(i);
+  }
+  PT_EXPECT_GE(deque->GetCapacity(), static_cast<size_t>(size));
+
+  // Owner takes elements in LIFO order, thieves in FIFO order
+  for (int i = 0; i != size / 2; ++i) {
+    PT_ASSERT(deque->TryPopBottom(element));
+    PT_EXPECT_EQ(element, size - 1 - i);
+    PT_ASSERT(deque->TrySteal(element));
+    PT_EXPECT_EQ(element, i);
+  }
+  PT_EXPECT(!deque->TryPopBottom(element));
+  PT_EXPECT(!deque->TrySteal(element));
+
+  // Indices keep growing, reuse the deque after it was emptied
+  deque->PushBottom(size);
+  PT_EXPECT(deque->TrySteal(element));
+  PT_EXPECT_EQ(element, size);
+  PT_EXPECT(!deque->TryPopBottom(element));
+}
+
+void WorkStealingDequeTest::WorkStealingDequeTestStress_Pre() {
+  deque = new Deque_t(2);
+  next_thread_id = 0;
+  n_taken = 0;
+  taken = new embb::base::Atomic<int>[n_elements];
+  for (int i = 0; i != n_elements; ++i) {
+    taken[i] = 0;
+  }
+}
+
+void WorkStealingDequeTest::Take(int element) {
+  PT_ASSERT(element >= 0 && element < n_elements);
+  PT_EXPECT_EQ(taken[element].FetchAndAdd(1), 0);
+  n_taken.FetchAndAdd(1);
+}
+
+void WorkStealingDequeTest::WorkStealingDequeTestStress_ThreadMethod() {
+  int element;
+  if (next_thread_id.FetchAndAdd(1) == 0) {
+    // Owner, push in bursts and pop some of the elements
+    int next = 0;
+    while (next != n_elements) {
+      for (int i = 0; i != 8 && next != n_elements; ++i) {
+        deque->PushBottom(next++);
+      }
+      for (int i = 0; i != 3; ++i) {
+        if (deque->TryPopBottom(element)) {
+          Take(element);
+        }
+      }
+    }
+    while (deque->TryPopBottom(element)) {
+      Take(element);
+    }
+  } else {
+    while (n_taken.Load() != n_elements) {
+      if (deque->TrySteal(element)) {
+        Take(element);
+      } else {
+        embb::base::Thread::CurrentYield();
+      }
+    }
+  }
+}
+
+void WorkStealingDequeTest::WorkStealingDequeTestStress_Post() {
+  PT_EXPECT_EQ(n_taken.Load(), n_elements);
+  for (int i = 0; i != n_elements; ++i) {
+    PT_EXPECT_EQ(taken[i].Load(), 1);
+  }
+  delete[] taken;
+  taken = NULL;
+  WorkStealingDequeTest_Post();
+}
+
+void WorkStealingDequeTest::WorkStealingDequeTest_Post() {
+  delete deque;
+  deque = NULL;
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
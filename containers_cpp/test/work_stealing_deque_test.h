@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_WORK_STEALING_DEQUE_TEST_H_
+#define CONTAINERS_CPP_TEST_WORK_STEALING_DEQUE_TEST_H_
+
+#include <partest/partest.h>
+#include <embb/base/atomic.h>
+#include <embb/containers/work_stealing_deque.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+class WorkStealingDequeTest : public partest::TestCase {
+ private:
+  typedef embb::containers::WorkStealingDeque<int> Deque_t;
+
+  int n_threads;
+  int n_elements;
+  Deque_t* deque;
+  embb::base::Atomic<int> next_thread_id;
+  embb::base::Atomic<int> n_taken;
+  embb::base::Atomic<int>* taken;
+
+  void WorkStealingDequeTestSingleThread_Pre();
+  void WorkStealingDequeTestSingleThread_ThreadMethod();
+  void WorkStealingDequeTestStress_Pre();
+  void WorkStealingDequeTestStress_ThreadMethod();
+  void WorkStealingDequeTestStress_Post();
+  void WorkStealingDequeTest_Post();
+
+  /**
+   * Marks an element as taken, checks that it was not taken before.
+   */
+  void Take(int element);
+
+ public:
+  /**
+   * Adds test methods.
+   */
+  WorkStealingDequeTest();
+};
+} // namespace test
+} // namespace containers
+} // namespace embb
+
+#endif  // CONTAINERS_CPP_TEST_WORK_STEALING_DEQUE_TEST_H_
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <dataflow_cpp_benchmark_token.h>
+
+#include <iostream>
+#include <vector>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/function.h>
+#include <embb/base/c/memory_allocation.h>
+#include <embb/base/c/time.h>
+
+#include <embb/dataflow/dataflow.h>
+
+namespace {
+
+typedef embb::dataflow::Network<4> TokenNetwork;
+
+typedef std::vector<int> Buffer;
+typedef embb::dataflow::SharedToken<Buffer> SharedBuffer;
+
+/**
+ * Source and sinks for the throughput measurement, parameterized by the
+ * token type.
+ */
+template <typename Token>
+class Stream {
+ public:
+  static size_t payload_size;
+  static int remaining;
+
+  static bool Produce(Token & out) {
+    Fill(out);
+    return --remaining > 0;
+  }
+  static void Consume(Token const & /*in*/) {}
+
+ private:
+  static void Fill(Buffer & out) {
+    out.resize(payload_size);
+  }
+  static void Fill(SharedBuffer & out) {
+    out.Emplace().resize(payload_size);
+  }
+};
+
+template <typename Token>
+size_t Stream<Token>::payload_size;
+
+template <typename Token>
+int Stream<Token>::remaining;
+
+/**
+ * Runs \c tokens tokens of \c payload_size integers from one source to two
+ * sinks and returns the number of tokens per second.
+ */
+template <typename Token>
+double MeasureThroughput(size_t payload_size, int tokens) {
+  typedef typename TokenNetwork::template Source<Token> SourceType;
+  typedef typename TokenNetwork::template Sink<Token> SinkType;
+  TokenNetwork network;
+  SourceType source(embb::base::MakeFunction(Stream<Token>::Produce));
+  SinkType sink1(embb::base::MakeFunction(Stream<Token>::Consume));
+  SinkType sink2(embb::base::MakeFunction(Stream<Token>::Consume));
+  Stream<Token>::payload_size = payload_size;
+  Stream<Token>::remaining = tokens;
+
+  source.template GetOutput<0>() >> sink1.template GetInput<0>();
+  source.template GetOutput<0>() >> sink2.template GetInput<0>();
+  network.Add(source);
+  network.Add(sink1);
+  network.Add(sink2);
+
+  embb_time_t start, end;
+  embb_time_now(&start);
+  network();
+  embb_time_now(&end);
+  double seconds =
+    static_cast<double>(end.seconds - start.seconds) +
+    (static_cast<double>(end.nanoseconds) -
+    static_cast<double>(start.nanoseconds)) / 1e9;
+  return static_cast<double>(tokens) / seconds;
+}
+
+} // namespace
+
+TokenBenchmark::TokenBenchmark() {
+  CreateUnit("dataflow_cpp token throughput")
+    .Add(&TokenBenchmark::BenchmarkThroughput, this);
+}
+
+void TokenBenchmark::BenchmarkThroughput() {
+  embb::mtapi::Node::Initialize(1, 1);
+  std::cout << "  Tokens/s from one source to two sinks:" << std::endl;
+  for (size_t size = 1; size <= (size_t(1) << 18); size <<= 6) {
+    const int tokens = 256;
+    double by_value = MeasureThroughput<Buffer>(size, tokens);
+    double shared = MeasureThroughput<SharedBuffer>(size, tokens);
+    std::cout << "  " << size * sizeof(int) << " bytes: " <<
+      static_cast<unsigned long>(by_value) << " by value, " <<
+      static_cast<unsigned long>(shared) << " shared" << std::endl;
+  }
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
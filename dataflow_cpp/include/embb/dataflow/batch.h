@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_DATAFLOW_BATCH_H_
+#define EMBB_DATAFLOW_BATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include <embb/base/function.h>
+
+namespace embb {
+namespace dataflow {
+
+/**
+ * \defgroup CPP_DATAFLOW_BATCH Batches
+ * Micro-batched execution of dataflow networks.
+ *
+ * A network processes one token per clock, and every process invocation is
+ * a task of its own. Using Batch as port type lets each clock carry up to
+ * a fixed number of values, which amortizes the scheduling cost per value
+ * and lets process functions work on contiguous spans. Existing functions
+ * that handle a single value are lifted to batches by BatchSource,
+ * BatchProcess and BatchSink.
+ *
+ * \ingroup CPP_DATAFLOW
+ */
+
+/**
+ * Sequence of values processed as one token.
+ *
+ * The values are stored contiguously. A batch produced into an input slot
+ * keeps the storage of the previous batch in that slot, so no memory is
+ * allocated per clock once all slots are in use.
+ *
+ * \tparam Type Type of the values
+ * \ingroup CPP_DATAFLOW_BATCH
+ */
+template <typename Type>
+class Batch {
+ public:
+  /**
+   * Creates an empty batch.
+   */
+  Batch() {}
+
+  /**
+   * Returns the number of values in the batch.
+   *
+   * \return Number of values
+   */
+  size_t GetSize() const {
+    return values_.size();
+  }
+
+  /**
+   * Checks whether the batch contains no values.
+   *
+   * \return \c true if the batch is empty, otherwise \c false
+   */
+  bool IsEmpty() const {
+    return values_.empty();
+  }
+
+  /**
+   * Returns the first of the contiguously stored values.
+   *
+   * \pre The batch is not empty.
+   * \return Pointer to the first value
+   */
+  Type const * GetData() const {
+    return &values_[0];
+  }
+
+  /**
+   * Returns the first of the contiguously stored values.
+   *
+   * \pre The batch is not empty.
+   * \return Pointer to the first value
+   */
+  Type * GetData() {
+    return &values_[0];
+  }
+
+  /**
+   * Returns the value at \c index.
+   *
+   * \pre \c index is smaller than GetSize().
+   * \return Reference to the value
+   */
+  Type const & operator [] (
+    size_t index
+    /**< [IN] Index of the value */
+    ) const {
+    return values_[index];
+  }
+
+  /**
+   * Returns the value at \c index.
+   *
+   * \pre \c index is smaller than GetSize().
+   * \return Reference to the value
+   */
+  Type & operator [] (
+    size_t index
+    /**< [IN] Index of the value */
+    ) {
+    return values_[index];
+  }
+
+  /**
+   * Appends a default-constructed value.
+   *
+   * \return Reference to the new value, to be filled in place
+   */
+  Type & Append() {
+    values_.push_back(Type());
+    return values_.back();
+  }
+
+  /**
+   * Appends a copy of \c value.
+   */
+  void Append(
+    Type const & value
+    /**< [IN] Value to append */
+    ) {
+    values_.push_back(value);
+  }
+
+  /**
+   * Sets the number of values, default-constructing new ones.
+   */
+  void Resize(
+    size_t size
+    /**< [IN] New number of values */
+    ) {
+    values_.resize(size);
+  }
+
+  /**
+   * Removes all values but keeps the storage.
+   */
+  void Clear() {
+    values_.clear();
+  }
+
+ private:
+  std::vector<Type> values_;
+};
+
+/**
+ * Lifts a source function that emits a single value to batches.
+ *
+ * Each call of Run() calls the wrapped function until the batch is full or
+ * the function returns \c false. Use
+ * <tt>embb::base::MakeFunction(adapter, &BatchSource<Type>::Run)</tt> as
+ * function of a source with a Batch<Type> output.
+ *
+ * \tparam Type Type of the values
+ * \ingroup CPP_DATAFLOW_BATCH
+ */
+template <typename Type>
+class BatchSource {
+ public:
+  /**
+   * Function type of the wrapped source function.
+   */
+  typedef embb::base::Function<bool, Type &> FunctionType;
+
+  /**
+   * Creates an adapter emitting up to \c batch_size values per clock.
+   */
+  BatchSource(
+    FunctionType function,
+    /**< [IN] Source function emitting a single value */
+    size_t batch_size
+    /**< [IN] Maximum number of values per batch, at least 1 */
+    ) : function_(function), batch_size_(batch_size) {}
+
+  /**
+   * Fills \c out with the values of up to \c batch_size calls of the
+   * wrapped function.
+   *
+   * \return \c false if the wrapped function returned \c false, otherwise
+   *         \c true
+   */
+  bool Run(
+    Batch<Type> & out
+    /**< [OUT] Batch to fill */
+    ) {
+    out.Clear();
+    bool result = true;
+    while (result && out.GetSize() < batch_size_) {
+      result = function_(out.Append());
+    }
+    return result;
+  }
+
+ private:
+  FunctionType function_;
+  size_t batch_size_;
+};
+
+/**
+ * Lifts a process function with one input and one output to batches.
+ *
+ * Run() applies the wrapped function to each value of the input batch.
+ * Use <tt>embb::base::MakeFunction(adapter, &BatchProcess<I, O>::Run)</tt>
+ * as function of a process with a Batch<I> input and a Batch<O> output.
+ *
+ * \tparam I Type of the input values
+ * \tparam O Type of the output values
+ * \ingroup CPP_DATAFLOW_BATCH
+ */
+template <typename I, typename O>
+class BatchProcess {
+ public:
+  /**
+   * Function type of the wrapped process function.
+   */
+  typedef embb::base::Function<void, I const &, O &> FunctionType;
+
+  /**
+   * Creates an adapter for \c function.
+   */
+  explicit BatchProcess(
+    FunctionType function
+    /**< [IN] Process function handling a single value */
+    ) : function_(function) {}
+
+  /**
+   * Applies the wrapped function to each value of \c in.
+   */
+  void Run(
+    Batch<I> const & in,
+    /**< [IN] Input values */
+    Batch<O> & out
+    /**< [OUT] One output value per input value */
+    ) {
+    out.Resize(in.GetSize());
+    for (size_t ii = 0; ii < in.GetSize(); ii++) {
+      function_(in[ii], out[ii]);
+    }
+  }
+
+ private:
+  FunctionType function_;
+};
+
+/**
+ * Lifts a sink function with one input to batches.
+ *
+ * Run() calls the wrapped function for each value of the input batch, in
+ * order. Use <tt>embb::base::MakeFunction(adapter, &BatchSink<Type>::Run)
+ * </tt> as function of a sink with a Batch<Type> input.
+ *
+ * \tparam Type Type of the values
+ * \ingroup CPP_DATAFLOW_BATCH
+ */
+template <typename Type>
+class BatchSink {
+ public:
+  /**
+   * Function type of the wrapped sink function.
+   */
+  typedef embb::base::Function<void, Type const &> FunctionType;
+
+  /**
+   * Creates an adapter for \c function.
+   */
+  explicit BatchSink(
+    FunctionType function
+    /**< [IN] Sink function handling a single value */
+    ) : function_(function) {}
+
+  /**
+   * Calls the wrapped function for each value of \c in.
+   */
+  void Run(
+    Batch<Type> const & in
+    /**< [IN] Values to consume */
+    ) {
+    for (size_t ii = 0; ii < in.GetSize(); ii++) {
+      function_(in[ii]);
+    }
+  }
+
+ private:
+  FunctionType function_;
+};
+
+} // namespace dataflow
+} // namespace embb
+
+#endif // EMBB_DATAFLOW_BATCH_H_
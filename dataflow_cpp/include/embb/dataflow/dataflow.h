@@ -36,5 +36,7 @@
 #define EMBB_DATAFLOW_TRACE_SIGNAL_HISTORY 0
 
 #include <embb/dataflow/network.h>
+#include <embb/dataflow/batch.h>
+#include <embb/dataflow/shared_token.h>
 
 #endif // EMBB_DATAFLOW_DATAFLOW_H_
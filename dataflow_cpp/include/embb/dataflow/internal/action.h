@@ -58,6 +58,10 @@ class Action {
 
   int GetClock() const { return clock_; }
 
+  embb::mtapi::ExecutionPolicy const & GetPolicy() const {
+    return node_->GetPolicy();
+  }
+
  private:
   Node * node_;
   int clock_;
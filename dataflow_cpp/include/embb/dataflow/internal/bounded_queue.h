@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_DATAFLOW_INTERNAL_BOUNDED_QUEUE_H_
+#define EMBB_DATAFLOW_INTERNAL_BOUNDED_QUEUE_H_
+
+#include <embb/base/atomic.h>
+
+#include <embb/dataflow/internal/slot_array.h>
+
+namespace embb {
+namespace dataflow {
+namespace internal {
+
+/**
+ * Bounded lock-free multi-producer multi-consumer queue on a ring of cells.
+ * Each cell carries a sequence number telling whether it is ready to be
+ * written or read at a given position. Unlike the queues of the containers
+ * library, it needs no memory reclamation and thus no thread indices, so
+ * it can be used from any thread.
+ */
+template <typename Type>
+class BoundedQueue {
+ public:
+  /**
+   * Creates a queue holding up to \c capacity elements, rounded up to the
+   * next power of two.
+   */
+  explicit BoundedQueue(unsigned int capacity) {
+    unsigned int size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    cells_.Resize(static_cast<int>(size));
+    for (unsigned int ii = 0; ii < size; ii++) {
+      cells_[static_cast<int>(ii)].sequence = ii;
+    }
+    mask_ = size - 1;
+    enqueue_pos_ = 0;
+    dequeue_pos_ = 0;
+  }
+
+  unsigned int GetCapacity() const {
+    return mask_ + 1;
+  }
+
+  bool TryEnqueue(Type const & element) {
+    unsigned int pos = enqueue_pos_;
+    Cell * cell;
+    for (;;) {
+      cell = &cells_[static_cast<int>(pos & mask_)];
+      const int diff = static_cast<int>(cell->sequence - pos);
+      if (diff == 0) {
+        if (enqueue_pos_.CompareAndSwap(pos, pos + 1))
+          break;
+      } else if (diff < 0) {
+        // The cell still holds the element of the previous round
+        return false;
+      } else {
+        pos = enqueue_pos_;
+      }
+    }
+    cell->value = element;
+    cell->sequence = pos + 1;
+    return true;
+  }
+
+  bool TryDequeue(Type & element) {
+    unsigned int pos = dequeue_pos_;
+    Cell * cell;
+    for (;;) {
+      cell = &cells_[static_cast<int>(pos & mask_)];
+      const int diff = static_cast<int>(cell->sequence - (pos + 1));
+      if (diff == 0) {
+        if (dequeue_pos_.CompareAndSwap(pos, pos + 1))
+          break;
+      } else if (diff < 0) {
+        // The cell has not been written in this round yet
+        return false;
+      } else {
+        pos = dequeue_pos_;
+      }
+    }
+    element = cell->value;
+    cell->value = Type();
+    cell->sequence = pos + mask_ + 1;
+    return true;
+  }
+
+ private:
+  struct Cell {
+    embb::base::Atomic<unsigned int> sequence;
+    Type value;
+  };
+
+  SlotArray<Cell> cells_;
+  unsigned int mask_;
+  embb::base::Atomic<unsigned int> enqueue_pos_;
+  embb::base::Atomic<unsigned int> dequeue_pos_;
+};
+
+} // namespace internal
+} // namespace dataflow
+} // namespace embb
+
+#endif // EMBB_DATAFLOW_INTERNAL_BOUNDED_QUEUE_H_
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_DATAFLOW_INTERNAL_CLOCK_COUNTDOWN_H_
+#define EMBB_DATAFLOW_INTERNAL_CLOCK_COUNTDOWN_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/mutex.h>
+#include <embb/base/condition_variable.h>
+
+#include <embb/dataflow/internal/clock_listener.h>
+#include <embb/dataflow/internal/slot_array.h>
+
+namespace embb {
+namespace dataflow {
+namespace internal {
+
+/**
+ * Per-slot countdown of the nodes that still have to report a clock. Each
+ * report via OnClock() decrements the counter of its clock, and Wait()
+ * blocks until the counter of a clock has reached zero.
+ */
+class ClockCountdown : public ClockListener {
+ public:
+  ClockCountdown() {}
+
+  void SetSlices(int slices) {
+    count_.Resize(slices);
+  }
+
+  void Set(int clock, int count) {
+    count_[clock] = count;
+  }
+
+  /**
+   * Counts down \c clock and wakes up waiting threads when it is complete.
+   * \return Number of reports still expected for \c clock.
+   */
+  int CountDown(int clock) {
+    const int count = --count_[clock];
+    if (count < 0)
+      EMBB_THROW(embb::base::ErrorException,
+        "More nodes than expected signaled reception of given clock.")
+    if (count == 0) {
+      // Taking the lock orders the notification after the check in Wait()
+      embb::base::LockGuard<embb::base::Mutex> lock(mutex_);
+      done_.NotifyAll();
+    }
+    return count;
+  }
+
+  virtual void OnClock(int clock) {
+    CountDown(clock);
+  }
+
+  void Wait(int clock) {
+    if (count_[clock] == 0)
+      return;
+    embb::base::UniqueLock<embb::base::Mutex> lock(mutex_);
+    while (count_[clock] > 0) {
+      done_.Wait(lock);
+    }
+  }
+
+ private:
+  SlotArray< embb::base::Atomic<int> > count_;
+  embb::base::Mutex mutex_;
+  embb::base::ConditionVariable done_;
+};
+
+} // namespace internal
+} // namespace dataflow
+} // namespace embb
+
+#endif // EMBB_DATAFLOW_INTERNAL_CLOCK_COUNTDOWN_H_
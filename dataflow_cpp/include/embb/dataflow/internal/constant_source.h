@@ -30,20 +30,25 @@
 #include <embb/dataflow/internal/signal.h>
 #include <embb/dataflow/internal/node.h>
 #include <embb/dataflow/internal/outputs.h>
+#include <embb/dataflow/internal/action.h>
+#include <embb/dataflow/internal/clock_listener.h>
+#include <embb/dataflow/internal/slot_array.h>
 
 namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <int Slices, typename Type>
+template <typename Type>
 class ConstantSource
   : public Node {
  public:
-  typedef Outputs<Slices, Type> OutputsType;
+  typedef Outputs<Type> OutputsType;
 
  private:
   OutputsType outputs_;
   Type value_;
+  SlotArray<Action> action_;
+  ClockListener * listener_;
 
  public:
   explicit ConstantSource(Type value) : value_(value) {}
@@ -52,13 +57,30 @@ class ConstantSource
     return outputs_.Size() > 0;
   }
 
+  void SetListener(ClockListener * listener) {
+    listener_ = listener;
+  }
+
   virtual void Run(int clock) {
-    GetOutput<0>().Send(Signal<Type>(clock, value_));
+    const ProfileMark mark = ProfileBegin();
+    GetOutput<0>().Send(clock, value_);
+    ProfileEnd(clock, mark, false);
+    listener_->OnClock(clock);
+  }
+
+  virtual void GetConsumers(std::vector<Node*> & consumers) {
+    outputs_.GetConsumers(consumers);
+  }
+
+  virtual void SetSlices(int slices) {
+    Node::SetSlices(slices);
+    outputs_.SetSlices(slices);
+    action_.Resize(slices);
   }
 
-  virtual bool Start(int clock) {
-    Run(clock);
-    return true;
+  virtual void Start(int clock) {
+    action_[clock] = Action(this, clock);
+    sched_->Spawn(action_[clock]);
   }
 
   OutputsType & GetOutputs() {
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_DATAFLOW_INTERNAL_EXTERNAL_SOURCE_H_
+#define EMBB_DATAFLOW_INTERNAL_EXTERNAL_SOURCE_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/mutex.h>
+#include <embb/base/condition_variable.h>
+
+#include <embb/dataflow/internal/signal.h>
+#include <embb/dataflow/internal/node.h>
+#include <embb/dataflow/internal/outputs.h>
+#include <embb/dataflow/internal/action.h>
+#include <embb/dataflow/internal/clock_listener.h>
+#include <embb/dataflow/internal/slot_array.h>
+#include <embb/dataflow/internal/bounded_queue.h>
+
+namespace embb {
+namespace dataflow {
+namespace internal {
+
+/**
+ * Source emitting values pushed from arbitrary threads. Values are passed
+ * through a bounded lock-free queue, the mutex and condition variables are
+ * only used to block pushers on a full queue and the network on an empty
+ * one.
+ */
+template <typename Type>
+class ExternalSource
+  : public Node {
+ public:
+  typedef Outputs<Type> OutputsType;
+
+  explicit ExternalSource(unsigned int capacity)
+    : queue_(capacity), closed_(false), stopped_(false), pushers_waiting_(0),
+      popper_waiting_(0), not_done_(true) {}
+
+  virtual bool HasOutputs() const {
+    return outputs_.Size() > 0;
+  }
+
+  void SetListener(ClockListener * listener) {
+    listener_ = listener;
+  }
+
+  bool TryPush(Type const & value) {
+    if (!Enqueue(value))
+      return false;
+    if (popper_waiting_ > 0) {
+      embb::base::LockGuard<embb::base::Mutex> lock(mutex_);
+      not_empty_.NotifyAll();
+    }
+    return true;
+  }
+
+  bool Push(Type const & value) {
+    if (TryPush(value))
+      return true;
+    embb::base::UniqueLock<embb::base::Mutex> lock(mutex_);
+    // Announce the wait before retrying, so that a concurrent Pop() either
+    // makes room before the retry or notifies afterwards
+    ++pushers_waiting_;
+    bool result;
+    while (!(result = Enqueue(value)) && !closed_) {
+      not_full_.Wait(lock);
+    }
+    --pushers_waiting_;
+    if (result) {
+      not_empty_.NotifyAll();
+    }
+    return result;
+  }
+
+  void Close() {
+    closed_ = true;
+    embb::base::LockGuard<embb::base::Mutex> lock(mutex_);
+    not_full_.NotifyAll();
+    not_empty_.NotifyAll();
+  }
+
+  bool IsClosed() const {
+    return closed_;
+  }
+
+  /**
+   * Emits the next pushed value, waiting for one if necessary. Once the
+   * source is closed and all pushed values are emitted, a blank token is
+   * emitted and the source is done. If the network is stopped while
+   * waiting, a blank token is emitted as well, but the source stays open.
+   */
+  virtual void Run(int clock) {
+    Type value;
+    const bool popped = Pop(value);
+    // Waiting for a value is not accounted as execution time
+    const ProfileMark mark = ProfileBegin();
+    if (popped) {
+      GetOutput<0>().Send(clock, value);
+    } else {
+      GetOutput<0>().Send(Signal<Type>(clock));
+      if (!stopped_)
+        not_done_ = false;
+    }
+    ProfileEnd(clock, mark, !popped);
+    listener_->OnClock(clock);
+  }
+
+  virtual void GetConsumers(std::vector<Node*> & consumers) {
+    outputs_.GetConsumers(consumers);
+  }
+
+  virtual void SetSlices(int slices) {
+    Node::SetSlices(slices);
+    outputs_.SetSlices(slices);
+    action_.Resize(slices);
+    stopped_ = false;
+    not_done_ = true;
+  }
+
+  virtual void Start(int clock) {
+    action_[clock] = Action(this, clock);
+    sched_->Spawn(action_[clock]);
+  }
+
+  virtual void Stop() {
+    stopped_ = true;
+    embb::base::LockGuard<embb::base::Mutex> lock(mutex_);
+    not_empty_.NotifyAll();
+  }
+
+  virtual bool MayBlock() const {
+    return true;
+  }
+
+  virtual bool IsDone() const {
+    return !not_done_;
+  }
+
+  OutputsType & GetOutputs() {
+    return outputs_;
+  }
+
+  template <int Index>
+  typename TypeAt<typename OutputsType::Types, Index>::Result & GetOutput() {
+    return outputs_.template Get<Index>();
+  }
+
+  template <typename T>
+  void operator >> (T & target) {
+    GetOutput<0>() >> target.template GetInput<0>();
+  }
+
+ private:
+  OutputsType outputs_;
+  BoundedQueue<Type> queue_;
+  embb::base::Atomic<bool> closed_;
+  embb::base::Atomic<bool> stopped_;
+  embb::base::Atomic<int> pushers_waiting_;
+  embb::base::Atomic<int> popper_waiting_;
+  embb::base::Mutex mutex_;
+  embb::base::ConditionVariable not_full_;
+  embb::base::ConditionVariable not_empty_;
+  SlotArray<Action> action_;
+  ClockListener * listener_;
+  volatile bool not_done_;
+
+  bool Enqueue(Type const & value) {
+    return !closed_ && queue_.TryEnqueue(value);
+  }
+
+  bool Pop(Type & value) {
+    // Values still queued when the network is stopped are kept for the
+    // next run
+    if (stopped_)
+      return false;
+    bool result = queue_.TryDequeue(value);
+    if (!result) {
+      embb::base::UniqueLock<embb::base::Mutex> lock(mutex_);
+      ++popper_waiting_;
+      // Values pushed before Close() are still emitted
+      while (!(result = queue_.TryDequeue(value)) && !closed_ &&
+        !stopped_) {
+        not_empty_.Wait(lock);
+      }
+      --popper_waiting_;
+      if (!result && !stopped_)
+        result = queue_.TryDequeue(value);
+    }
+    if (result && pushers_waiting_ > 0) {
+      embb::base::LockGuard<embb::base::Mutex> lock(mutex_);
+      not_full_.NotifyAll();
+    }
+    return result;
+  }
+};
+
+} // namespace internal
+} // namespace dataflow
+} // namespace embb
+
+#endif // EMBB_DATAFLOW_INTERNAL_EXTERNAL_SOURCE_H_
@@ -33,27 +33,30 @@
 #endif
 
 #include <embb/dataflow/internal/signal.h>
+#include <embb/dataflow/internal/slot_array.h>
 #include <embb/dataflow/internal/clock_listener.h>
 
 namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <typename, int>
+template <typename>
 class Out;
 
-template <typename Type, int Slices>
+class Node;
+
+template <typename Type>
 class In {
  public:
   typedef Signal<Type> SignalType;
 
-  In() : connected_(false) {}
+  In() : connected_(false), owner_(NULL), producer_(NULL) {}
 
   SignalType const & GetSignal(int clock) const {
-    return values_[clock % Slices];
+    return values_[clock];
   }
 
-  Type GetValue(int clock) const {
+  Type const & GetValue(int clock) const {
     SignalType const & signal = GetSignal(clock);
     if (signal.IsBlank())
       EMBB_THROW(embb::base::ErrorException,
@@ -64,36 +67,76 @@ class In {
   bool IsConnected() const { return connected_; }
   void SetConnected() { connected_ = true; }
 
+  /**
+   * Node this input belongs to.
+   */
+  Node * GetOwner() const { return owner_; }
+  void SetOwner(Node * owner) { owner_ = owner; }
+
+  /**
+   * Producer offering to run the owner of this input inline, see
+   * Node::OfferFusion().
+   */
+  Node * GetProducer() const { return producer_; }
+  void SetProducer(Node * producer) { producer_ = producer; }
+
   void SetListener(ClockListener * listener) { listener_ = listener; }
 
+  void SetSlices(int slices) { values_.Resize(slices); }
+
   void Clear(int clock) {
-    const int idx = clock % Slices;
-    values_[idx].Clear();
+    values_[clock].Clear();
   }
 
-  friend class Out<Type, Slices>;
+  friend class Out<Type>;
 
  private:
-  SignalType values_[Slices];
+  SlotArray<SignalType> values_;
   ClockListener * listener_;
   bool connected_;
+  Node * owner_;
+  Node * producer_;
 #if EMBB_DATAFLOW_TRACE_SIGNAL_HISTORY
   SpinLock lock_;
   std::vector<SignalType> history_;
 #endif
 
   void Receive(SignalType const & value) {
-    const int idx = value.GetClock() % Slices;
-    if (values_[idx].GetClock() >= value.GetClock())
+    const int clock = value.GetClock();
+    CheckClock(clock);
+    values_[clock] = value;
+    Notify(clock);
+  }
+
+  void Receive(int clock, Type const & value) {
+    CheckClock(clock);
+    values_[clock].Set(clock, value);
+    Notify(clock);
+  }
+
+  Type & Acquire(int clock) {
+    CheckClock(clock);
+    return values_[clock].GetStorage();
+  }
+
+  void Publish(int clock) {
+    values_[clock].Publish(clock);
+    Notify(clock);
+  }
+
+  void CheckClock(int clock) const {
+    if (values_[clock].GetClock() >= clock)
       EMBB_THROW(embb::base::ErrorException,
         "Received signal does not increase clock.");
-    values_[idx] = value;
-    listener_->OnClock(value.GetClock());
+  }
+
+  void Notify(int clock) {
 #if EMBB_DATAFLOW_TRACE_SIGNAL_HISTORY
     lock_.Lock();
-    history_.push_back(value);
+    history_.push_back(values_[clock]);
     lock_.Unlock();
 #endif
+    listener_->OnClock(clock);
   }
 };
 
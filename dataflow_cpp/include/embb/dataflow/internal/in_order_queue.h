@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_DATAFLOW_INTERNAL_IN_ORDER_QUEUE_H_
+#define EMBB_DATAFLOW_INTERNAL_IN_ORDER_QUEUE_H_
+
+#include <embb/base/atomic.h>
+
+#include <embb/dataflow/internal/action.h>
+#include <embb/dataflow/internal/node.h>
+#include <embb/dataflow/internal/scheduler.h>
+#include <embb/dataflow/internal/slot_array.h>
+
+namespace embb {
+namespace dataflow {
+namespace internal {
+
+/**
+ * Ready queue of a serial node. Clocks whose inputs are complete are marked
+ * ready and run as tasks strictly in clock order, one at a time. The right
+ * to spawn the next task is a single executing token: it is taken by the
+ * thread that finds the next clock ready and handed on by the task when it
+ * finishes, so no thread ever waits for a running task of the node. Clocks
+ * handled outside of the queue are marked skipped and passed over in order.
+ */
+class InOrderQueue {
+ public:
+  InOrderQueue() : node_(NULL), next_clock_(0) {
+    executing_ = false;
+  }
+
+  /**
+   * Prepares the queue for \c slices tokens in flight, starting at clock 0.
+   */
+  void Reset(Node * node, int slices) {
+    node_ = node;
+    ready_.Resize(slices);
+    for (int ii = 0; ii < slices; ii++)
+      ready_[ii] = -1;
+    action_.Resize(slices);
+    next_clock_ = 0;
+    executing_ = false;
+  }
+
+  /**
+   * Marks \c clock as ready and spawns it if it is the next one.
+   */
+  void SetReady(Scheduler * sched, int clock) {
+    ready_[clock] = clock;
+    TrySpawn(sched);
+  }
+
+  /**
+   * Marks \c clock as handled by the caller, e.g., a blank token that was
+   * forwarded without running the node. It is passed over without spawning
+   * a task.
+   */
+  void SetSkipped(Scheduler * sched, int clock) {
+    ready_[clock] = Skipped(clock);
+    TrySpawn(sched);
+  }
+
+  /**
+   * Called by the task of \c clock when it has finished. Passes the
+   * executing token on to the next clock.
+   */
+  void SetDone(Scheduler * sched, int clock) {
+    next_clock_ = clock + 1;
+    executing_ = false;
+    TrySpawn(sched);
+  }
+
+ private:
+  void TrySpawn(Scheduler * sched) {
+    for (;;) {
+      bool expected = false;
+      if (!executing_.CompareAndSwap(expected, true))
+        return;
+      const int clock = next_clock_;
+      const int ready = ready_[clock];
+      if (ready == clock) {
+        action_[clock] = Action(node_, clock);
+        sched->Spawn(action_[clock]);
+        return;
+      }
+      if (ready == Skipped(clock)) {
+        next_clock_ = clock + 1;
+        executing_ = false;
+        continue;
+      }
+      // Release the token. If the clock became ready meanwhile, its
+      // producer may have missed the token, so try again.
+      executing_ = false;
+      const int again = ready_[clock];
+      if (again != clock && again != Skipped(clock))
+        return;
+    }
+  }
+
+  /**
+   * Mark of a skipped clock, distinct from all clocks and from -1, which
+   * marks slots not ready yet.
+   */
+  static int Skipped(int clock) {
+    return -2 - clock;
+  }
+
+  Node * node_;
+  SlotArray< embb::base::Atomic<int> > ready_;
+  SlotArray<Action> action_;
+  int next_clock_;
+  embb::base::Atomic<bool> executing_;
+};
+
+} // namespace internal
+} // namespace dataflow
+} // namespace embb
+
+#endif // EMBB_DATAFLOW_INTERNAL_IN_ORDER_QUEUE_H_
@@ -29,13 +29,13 @@
 
 #include <embb/dataflow/internal/tuple.h>
 #include <embb/dataflow/internal/in.h>
+#include <embb/dataflow/internal/slot_array.h>
 
 namespace embb {
 namespace dataflow {
 namespace internal {
 
 template <
-  int,
   typename = embb::base::internal::Nil,
   typename = embb::base::internal::Nil,
   typename = embb::base::internal::Nil,
@@ -43,8 +43,8 @@ template <
   typename = embb::base::internal::Nil>
 class Inputs;
 
-template <int Slices>
-class Inputs<Slices, embb::base::internal::Nil, embb::base::internal::Nil,
+template <>
+class Inputs< embb::base::internal::Nil, embb::base::internal::Nil,
   embb::base::internal::Nil, embb::base::internal::Nil,
   embb::base::internal::Nil>
   : public Tuple<embb::base::internal::Nil, embb::base::internal::Nil,
@@ -53,27 +53,34 @@ class Inputs<Slices, embb::base::internal::Nil, embb::base::internal::Nil,
   , public ClockListener {
  public:
   void SetListener(ClockListener * /*notify*/) {}
+  void SetOwner(Node * /*owner*/) {}
+  void SetSlices(int /*slices*/) {}
   bool AreNoneBlank(int /*clock*/) { return false; }
   bool AreAtClock(int /*clock*/) { return true; }
   virtual void OnClock(int /*clock*/) {}
 };
 
-template <int Slices, typename T1>
-class Inputs<Slices, T1, embb::base::internal::Nil, embb::base::internal::Nil,
+template <typename T1>
+class Inputs<T1, embb::base::internal::Nil, embb::base::internal::Nil,
   embb::base::internal::Nil, embb::base::internal::Nil>
-  : public Tuple<In<T1, Slices>, embb::base::internal::Nil,
+  : public Tuple<In<T1>, embb::base::internal::Nil,
     embb::base::internal::Nil, embb::base::internal::Nil,
     embb::base::internal::Nil>
   , public ClockListener {
  public:
-  Inputs() {
-    for (int ii = 0; ii < Slices; ii++)
+  void SetSlices(int slices) {
+    count_.Resize(slices);
+    for (int ii = 0; ii < slices; ii++)
       count_[ii] = 1;
+    this->template Get<0>().SetSlices(slices);
   }
   void SetListener(ClockListener * listener) {
     listener_ = listener;
     this->template Get<0>().SetListener(this);
   }
+  void SetOwner(Node * owner) {
+    this->template Get<0>().SetOwner(owner);
+  }
   bool AreNoneBlank(int clock) {
     return !(
       this->template Get<0>().GetSignal(clock).IsBlank());
@@ -86,37 +93,43 @@ class Inputs<Slices, T1, embb::base::internal::Nil, embb::base::internal::Nil,
     this->template Get<0>().Clear(clock);
   }
   virtual void OnClock(int clock) {
-    const int idx = clock % Slices;
-    if (count_[idx] == 0) {
+    if (count_[clock] == 0) {
       EMBB_THROW(embb::base::ErrorException,
         "All inputs already fired for this clock.")
     }
-    if (--count_[idx] == 0) {
-      count_[idx] = 1;
+    if (--count_[clock] == 0) {
+      count_[clock] = 1;
       listener_->OnClock(clock);
     }
   }
  private:
-  embb::base::Atomic<int> count_[Slices];
+  SlotArray< embb::base::Atomic<int> > count_;
   ClockListener * listener_;
 };
 
-template <int Slices, typename T1, typename T2>
-class Inputs<Slices, T1, T2, embb::base::internal::Nil,
+template <typename T1, typename T2>
+class Inputs<T1, T2, embb::base::internal::Nil,
   embb::base::internal::Nil, embb::base::internal::Nil>
-  : public Tuple<In<T1, Slices>, In<T2, Slices>, embb::base::internal::Nil,
+  : public Tuple<In<T1>, In<T2>, embb::base::internal::Nil,
     embb::base::internal::Nil, embb::base::internal::Nil>
   , public ClockListener {
  public:
-  Inputs() {
-    for (int ii = 0; ii < Slices; ii++)
+  void SetSlices(int slices) {
+    count_.Resize(slices);
+    for (int ii = 0; ii < slices; ii++)
       count_[ii] = 2;
+    this->template Get<0>().SetSlices(slices);
+    this->template Get<1>().SetSlices(slices);
   }
   void SetListener(ClockListener * listener) {
     listener_ = listener;
     this->template Get<0>().SetListener(this);
     this->template Get<1>().SetListener(this);
   }
+  void SetOwner(Node * owner) {
+    this->template Get<0>().SetOwner(owner);
+    this->template Get<1>().SetOwner(owner);
+  }
   bool AreNoneBlank(int clock) {
     return !(
       this->template Get<0>().GetSignal(clock).IsBlank() ||
@@ -132,31 +145,34 @@ class Inputs<Slices, T1, T2, embb::base::internal::Nil,
     this->template Get<1>().Clear(clock);
   }
   virtual void OnClock(int clock) {
-    const int idx = clock % Slices;
-    if (count_[idx] == 0) {
+    if (count_[clock] == 0) {
       EMBB_THROW(embb::base::ErrorException,
         "All inputs already fired for this clock.")
     }
-    if (--count_[idx] == 0) {
-      count_[idx] = 2;
+    if (--count_[clock] == 0) {
+      count_[clock] = 2;
       listener_->OnClock(clock);
     }
   }
  private:
-  embb::base::Atomic<int> count_[Slices];
+  SlotArray< embb::base::Atomic<int> > count_;
   ClockListener * listener_;
 };
 
-template <int Slices, typename T1, typename T2, typename T3>
-class Inputs<Slices, T1, T2, T3, embb::base::internal::Nil,
+template <typename T1, typename T2, typename T3>
+class Inputs<T1, T2, T3, embb::base::internal::Nil,
   embb::base::internal::Nil>
-  : public Tuple<In<T1, Slices>, In<T2, Slices>, In<T3, Slices>,
+  : public Tuple<In<T1>, In<T2>, In<T3>,
     embb::base::internal::Nil, embb::base::internal::Nil>
   , public ClockListener {
  public:
-  Inputs() {
-    for (int ii = 0; ii < Slices; ii++)
+  void SetSlices(int slices) {
+    count_.Resize(slices);
+    for (int ii = 0; ii < slices; ii++)
       count_[ii] = 3;
+    this->template Get<0>().SetSlices(slices);
+    this->template Get<1>().SetSlices(slices);
+    this->template Get<2>().SetSlices(slices);
   }
   void SetListener(ClockListener * listener) {
     listener_ = listener;
@@ -164,6 +180,11 @@ class Inputs<Slices, T1, T2, T3, embb::base::internal::Nil,
     this->template Get<1>().SetListener(this);
     this->template Get<2>().SetListener(this);
   }
+  void SetOwner(Node * owner) {
+    this->template Get<0>().SetOwner(owner);
+    this->template Get<1>().SetOwner(owner);
+    this->template Get<2>().SetOwner(owner);
+  }
   bool AreNoneBlank(int clock) {
     return !(
       this->template Get<0>().GetSignal(clock).IsBlank() ||
@@ -182,30 +203,34 @@ class Inputs<Slices, T1, T2, T3, embb::base::internal::Nil,
     this->template Get<2>().Clear(clock);
   }
   virtual void OnClock(int clock) {
-    const int idx = clock % Slices;
-    if (count_[idx] == 0) {
+    if (count_[clock] == 0) {
       EMBB_THROW(embb::base::ErrorException,
         "All inputs already fired for this clock.")
     }
-    if (--count_[idx] == 0) {
-      count_[idx] = 3;
+    if (--count_[clock] == 0) {
+      count_[clock] = 3;
       listener_->OnClock(clock);
     }
   }
  private:
-  embb::base::Atomic<int> count_[Slices];
+  SlotArray< embb::base::Atomic<int> > count_;
   ClockListener * listener_;
 };
 
-template <int Slices, typename T1, typename T2, typename T3, typename T4>
-class Inputs<Slices, T1, T2, T3, T4, embb::base::internal::Nil>
-  : public Tuple<In<T1, Slices>, In<T2, Slices>, In<T3, Slices>,
-      In<T4, Slices>, embb::base::internal::Nil>
+template <typename T1, typename T2, typename T3, typename T4>
+class Inputs<T1, T2, T3, T4, embb::base::internal::Nil>
+  : public Tuple<In<T1>, In<T2>, In<T3>,
+      In<T4>, embb::base::internal::Nil>
   , public ClockListener {
  public:
-  Inputs() {
-    for (int ii = 0; ii < Slices; ii++)
+  void SetSlices(int slices) {
+    count_.Resize(slices);
+    for (int ii = 0; ii < slices; ii++)
       count_[ii] = 4;
+    this->template Get<0>().SetSlices(slices);
+    this->template Get<1>().SetSlices(slices);
+    this->template Get<2>().SetSlices(slices);
+    this->template Get<3>().SetSlices(slices);
   }
   void SetListener(ClockListener * listener) {
     listener_ = listener;
@@ -214,6 +239,12 @@ class Inputs<Slices, T1, T2, T3, T4, embb::base::internal::Nil>
     this->template Get<2>().SetListener(this);
     this->template Get<3>().SetListener(this);
   }
+  void SetOwner(Node * owner) {
+    this->template Get<0>().SetOwner(owner);
+    this->template Get<1>().SetOwner(owner);
+    this->template Get<2>().SetOwner(owner);
+    this->template Get<3>().SetOwner(owner);
+  }
   bool AreNoneBlank(int clock) {
     return !(
       this->template Get<0>().GetSignal(clock).IsBlank() ||
@@ -235,31 +266,36 @@ class Inputs<Slices, T1, T2, T3, T4, embb::base::internal::Nil>
     this->template Get<3>().Clear(clock);
   }
   virtual void OnClock(int clock) {
-    const int idx = clock % Slices;
-    if (count_[idx] == 0) {
+    if (count_[clock] == 0) {
       EMBB_THROW(embb::base::ErrorException,
         "All inputs already fired for this clock.")
     }
-    if (--count_[idx] == 0) {
-      count_[idx] = 4;
+    if (--count_[clock] == 0) {
+      count_[clock] = 4;
       listener_->OnClock(clock);
     }
   }
  private:
-  embb::base::Atomic<int> count_[Slices];
+  SlotArray< embb::base::Atomic<int> > count_;
   ClockListener * listener_;
 };
 
-template <int Slices, typename T1, typename T2, typename T3, typename T4,
+template <typename T1, typename T2, typename T3, typename T4,
   typename T5>
 class Inputs
-  : public Tuple<In<T1, Slices>, In<T2, Slices>, In<T3, Slices>,
-      In<T4, Slices>, In<T5, Slices> >
+  : public Tuple<In<T1>, In<T2>, In<T3>,
+      In<T4>, In<T5> >
   , public ClockListener {
  public:
-  Inputs() {
-    for (int ii = 0; ii < Slices; ii++)
+  void SetSlices(int slices) {
+    count_.Resize(slices);
+    for (int ii = 0; ii < slices; ii++)
       count_[ii] = 5;
+    this->template Get<0>().SetSlices(slices);
+    this->template Get<1>().SetSlices(slices);
+    this->template Get<2>().SetSlices(slices);
+    this->template Get<3>().SetSlices(slices);
+    this->template Get<4>().SetSlices(slices);
   }
   void SetListener(ClockListener * listener) {
     listener_ = listener;
@@ -269,6 +305,13 @@ class Inputs
     this->template Get<3>().SetListener(this);
     this->template Get<4>().SetListener(this);
   }
+  void SetOwner(Node * owner) {
+    this->template Get<0>().SetOwner(owner);
+    this->template Get<1>().SetOwner(owner);
+    this->template Get<2>().SetOwner(owner);
+    this->template Get<3>().SetOwner(owner);
+    this->template Get<4>().SetOwner(owner);
+  }
   bool AreNoneBlank(int clock) {
     return !(
       this->template Get<0>().GetSignal(clock).IsBlank() ||
@@ -293,18 +336,17 @@ class Inputs
     this->template Get<4>().Clear(clock);
   }
   virtual void OnClock(int clock) {
-    const int idx = clock % Slices;
-    if (count_[idx] == 0) {
+    if (count_[clock] == 0) {
       EMBB_THROW(embb::base::ErrorException,
         "All inputs already fired for this clock.")
     }
-    if (--count_[idx] == 0) {
-      count_[idx] = 5;
+    if (--count_[clock] == 0) {
+      count_[clock] = 5;
       listener_->OnClock(clock);
     }
   }
  private:
-  embb::base::Atomic<int> count_[Slices];
+  SlotArray< embb::base::Atomic<int> > count_;
   ClockListener * listener_;
 };
 
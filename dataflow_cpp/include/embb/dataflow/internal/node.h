@@ -28,8 +28,13 @@
 #define EMBB_DATAFLOW_INTERNAL_NODE_H_
 
 #include <cstddef>
+#include <vector>
+
+#include <embb/mtapi/execution_policy.h>
 
 #include <embb/dataflow/internal/scheduler.h>
+#include <embb/dataflow/internal/node_profile.h>
+#include <embb/dataflow/internal/slot_array.h>
 
 namespace embb {
 namespace dataflow {
@@ -37,19 +42,156 @@ namespace internal {
 
 class Node {
  public:
-  Node() : sched_(NULL) {}
+  enum ExecutionMode {
+    /** Runs inline in the context that completes its inputs */
+    EXECUTE_INLINE,
+    /** Runs as a task per token, tokens in parallel */
+    EXECUTE_PARALLEL,
+    /** Runs as a task per token, tokens in clock order */
+    EXECUTE_SERIAL
+  };
+
+  Node()
+    : sched_(NULL), slices_(0), fused_producer_(NULL), fused_consumer_(NULL),
+      profiling_(false) {
+  }
   virtual ~Node() {}
   virtual bool HasInputs() const { return false; }
   virtual bool HasOutputs() const { return false; }
   virtual void Run(int clock) = 0;
-  virtual bool Start(int /*clock*/) {
+  /**
+   * Spawns a task producing the tokens of a source for \c clock. Completion
+   * is reported to the listener of the source.
+   */
+  virtual void Start(int /*clock*/) {
     EMBB_THROW(embb::base::ErrorException,
       "Nodes are started implicitly.");
   }
+  /**
+   * Returns \c true once a source has produced its last token.
+   */
+  virtual bool IsDone() const { return false; }
+  /**
+   * Wakes up a source that waits for input, so the network can stop. The
+   * next call to SetSlices() makes the source wait again.
+   */
+  virtual void Stop() {}
+  /**
+   * Returns \c true if Run() of a source may wait for input from outside
+   * the network. The network runs such sources on its own thread, so they
+   * never occupy a worker that tokens in flight depend on.
+   */
+  virtual bool MayBlock() const { return false; }
   void SetScheduler(Scheduler * sched) { sched_ = sched; }
+  /**
+   * Allocates the per-slot state for \c slices tokens in flight and resets
+   * the node to clock 0. Called by the network before it starts.
+   */
+  virtual void SetSlices(int slices) {
+    slices_ = slices;
+    ready_time_.Resize(profiling_ ? slices : 0);
+    profile_.Reset();
+  }
+  virtual ExecutionMode GetExecutionMode() const { return EXECUTE_INLINE; }
+
+  /**
+   * Fusion of linear chains, performed by the network in three passes over
+   * all nodes. A process whose only output feeds a single input offers
+   * itself to that input in OfferFusion(). A consumer with only that input,
+   * the same execution mode and the same execution policy accepts in
+   * AcceptFusion(). It then runs inline in the task of its producer instead
+   * of spawning its own.
+   */
+  virtual void ResetFusion() {
+    fused_producer_ = NULL;
+    fused_consumer_ = NULL;
+  }
+  virtual void OfferFusion() {}
+  virtual void AcceptFusion() {}
+  Node * GetFusedProducer() const { return fused_producer_; }
+  Node * GetFusedConsumer() const { return fused_consumer_; }
+
+  /**
+   * Appends the nodes connected to the outputs of this node.
+   */
+  virtual void GetConsumers(std::vector<Node*> & /*consumers*/) {}
+
+  /**
+   * Enables collecting the profile of the node, effective from the next
+   * call to SetSlices().
+   */
+  void SetProfiling(bool enabled) { profiling_ = enabled; }
+  NodeProfile const & GetProfile() const { return profile_; }
+
+  /**
+   * Priority and affinity of the tasks spawned for the node.
+   */
+  embb::mtapi::ExecutionPolicy const & GetPolicy() const { return policy_; }
+  void SetPolicy(embb::mtapi::ExecutionPolicy const & policy) {
+    policy_ = policy;
+  }
 
  protected:
+  struct ProfileMark {
+    unsigned long long start;
+    unsigned long long nested;
+  };
+
   Scheduler * sched_;
+  int slices_;
+  Node * fused_producer_;
+  Node * fused_consumer_;
+
+  /**
+   * Records that all inputs of \c clock are available.
+   */
+  void ProfileReady(int clock) {
+    if (profiling_) {
+      ready_time_[clock] = NodeProfile::Now();
+    }
+  }
+
+  ProfileMark ProfileBegin() {
+    ProfileMark mark = { 0, 0 };
+    if (profiling_) {
+      mark.nested = NodeProfile::NestedTime();
+      NodeProfile::NestedTime() = 0;
+      mark.start = NodeProfile::Now();
+    }
+    return mark;
+  }
+
+  /**
+   * Records a run started by ProfileBegin(). Nodes run inline in between
+   * have added their time to NodeProfile::NestedTime(), which is excluded
+   * here and passed on to an enclosing run.
+   */
+  void ProfileEnd(int clock, ProfileMark const & mark, bool blank) {
+    if (profiling_) {
+      const unsigned long long time = NodeProfile::Now() - mark.start;
+      const unsigned long long nested = NodeProfile::NestedTime();
+      const unsigned long long queued =
+        HasInputs() ? mark.start - ready_time_[clock] : 0;
+      profile_.Record(time > nested ? time - nested : 0, queued, blank);
+      NodeProfile::NestedTime() = mark.nested + time;
+    }
+  }
+
+  void FuseInto(Node * producer) {
+    if (producer != NULL &&
+      producer->GetExecutionMode() == GetExecutionMode() &&
+      producer->policy_.GetPriority() == policy_.GetPriority() &&
+      producer->policy_.GetAffinity() == policy_.GetAffinity()) {
+      fused_producer_ = producer;
+      producer->fused_consumer_ = this;
+    }
+  }
+
+ private:
+  embb::mtapi::ExecutionPolicy policy_;
+  bool profiling_;
+  NodeProfile profile_;
+  SlotArray<unsigned long long> ready_time_;
 };
 
 } // namespace internal
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_DATAFLOW_INTERNAL_NODE_PROFILE_H_
+#define EMBB_DATAFLOW_INTERNAL_NODE_PROFILE_H_
+
+#include <embb/base/atomic.h>
+#include <embb/base/c/time.h>
+
+namespace embb {
+namespace dataflow {
+namespace internal {
+
+/**
+ * Counters of a node collected while profiling. All times are in
+ * nanoseconds. Execution times exclude nodes run inline by the node, e.g.
+ * fused consumers, and are kept in a histogram of powers of two for
+ * percentiles.
+ */
+class NodeProfile {
+ public:
+  /** Number of histogram buckets, bucket \c b counts times below 2^(b+1) */
+  static const int BUCKETS = 48;
+
+  NodeProfile() {
+    Reset();
+  }
+
+  void Reset() {
+    invocations_ = 0;
+    blanks_ = 0;
+    execution_time_ = 0;
+    queueing_time_ = 0;
+    for (int ii = 0; ii < BUCKETS; ii++) {
+      histogram_[ii] = 0;
+    }
+  }
+
+  void Record(
+    unsigned long long execution_time,
+    unsigned long long queueing_time,
+    bool blank) {
+    ++invocations_;
+    if (blank) {
+      ++blanks_;
+    }
+    Add(execution_time_, execution_time);
+    Add(queueing_time_, queueing_time);
+    ++histogram_[GetBucket(execution_time)];
+  }
+
+  unsigned int GetInvocations() const { return invocations_; }
+  unsigned int GetBlanks() const { return blanks_; }
+  unsigned long long GetExecutionTime() const { return execution_time_; }
+  unsigned long long GetQueueingTime() const { return queueing_time_; }
+
+  unsigned long long GetMeanExecutionTime() const {
+    return (invocations_ > 0) ? execution_time_ / invocations_ : 0;
+  }
+
+  unsigned long long GetMeanQueueingTime() const {
+    return (invocations_ > 0) ? queueing_time_ / invocations_ : 0;
+  }
+
+  /**
+   * Returns an upper bound of the execution time of \c percent percent of
+   * the invocations, accurate to a factor of two.
+   */
+  unsigned long long GetExecutionTimePercentile(int percent) const {
+    const unsigned long long count = invocations_;
+    const unsigned long long rank = (count * percent + 99) / 100;
+    unsigned long long seen = 0;
+    for (int ii = 0; ii < BUCKETS; ii++) {
+      seen += histogram_[ii];
+      if (seen >= rank && seen > 0)
+        return 2ull << ii;
+    }
+    return 0;
+  }
+
+  static unsigned long long Now() {
+    embb_time_t time;
+    embb_time_now(&time);
+    return time.seconds * 1000000000ull + time.nanoseconds;
+  }
+
+  /**
+   * Returns the time spent in nodes run inline by the node currently
+   * running on the calling thread.
+   */
+  static unsigned long long & NestedTime();
+
+ private:
+  // Atomic arithmetic on 64 bit integers is not available on all platforms
+  static void Add(
+    embb::base::Atomic<unsigned long long> & sum,
+    unsigned long long value) {
+    unsigned long long expected = sum;
+    while (!sum.CompareAndSwap(expected, expected + value)) {}
+  }
+
+  static int GetBucket(unsigned long long time) {
+    int bucket = 0;
+    while (time > 1 && bucket < BUCKETS - 1) {
+      time >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+  embb::base::Atomic<unsigned int> invocations_;
+  embb::base::Atomic<unsigned int> blanks_;
+  embb::base::Atomic<unsigned long long> execution_time_;
+  embb::base::Atomic<unsigned long long> queueing_time_;
+  embb::base::Atomic<unsigned int> histogram_[BUCKETS];
+};
+
+} // namespace internal
+} // namespace dataflow
+} // namespace embb
+
+#endif // EMBB_DATAFLOW_INTERNAL_NODE_PROFILE_H_
@@ -30,26 +30,77 @@
 #include <vector>
 #include <embb/dataflow/internal/signal.h>
 #include <embb/dataflow/internal/in.h>
+#include <embb/dataflow/internal/slot_array.h>
 
 namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <typename Type, int Slices>
+template <typename Type>
 class Out {
  public:
   typedef Signal<Type> SignalType;
-  typedef In<Type, Slices> InType;
+  typedef In<Type> InType;
 
   Out() {
   }
 
+  void SetSlices(int slices) {
+    // A single input is written in place, see Prepare()
+    staging_.Resize((targets_.size() == 1) ? 0 : slices);
+  }
+
   void Send(SignalType const & value) {
     for (size_t ii = 0; ii < targets_.size(); ii++) {
       targets_[ii]->Receive(value);
     }
   }
 
+  void Send(int clock, Type const & value) {
+    for (size_t ii = 0; ii < targets_.size(); ii++) {
+      targets_[ii]->Receive(clock, value);
+    }
+  }
+
+  /**
+   * Returns a default-initialized value to produce the token for \c clock
+   * into. If exactly one input is connected, this is the slot of that input
+   * itself, so the token reaches its consumer without being copied.
+   * Otherwise, the token is copied to each input by Commit().
+   */
+  Type & Prepare(int clock) {
+    if (targets_.size() == 1) {
+      Type & value = targets_[0]->Acquire(clock);
+      value = Type();
+      return value;
+    }
+    return staging_[clock];
+  }
+
+  /**
+   * Sends the token produced into the value returned by Prepare().
+   */
+  void Commit(int clock) {
+    if (targets_.size() == 1) {
+      targets_[0]->Publish(clock);
+    } else {
+      Send(clock, staging_[clock]);
+      staging_[clock] = Type();
+    }
+  }
+
+  void GetConsumers(std::vector<Node*> & consumers) {
+    for (size_t ii = 0; ii < targets_.size(); ii++) {
+      consumers.push_back(targets_[ii]->GetOwner());
+    }
+  }
+
+  void OfferFusion(Node * producer) {
+    if (targets_.size() == 1) {
+      targets_[0]->SetProducer(producer);
+    }
+  }
+
   void Connect(InType & input) {
     if (input.IsConnected()) {
       EMBB_THROW(embb::base::ErrorException,
@@ -66,6 +117,7 @@ class Out {
 
  private:
   std::vector< InType * > targets_;
+  SlotArray<Type> staging_;
 };
 
 
@@ -27,6 +27,8 @@
 #ifndef EMBB_DATAFLOW_INTERNAL_OUTPUTS_H_
 #define EMBB_DATAFLOW_INTERNAL_OUTPUTS_H_
 
+#include <vector>
+
 #include <embb/dataflow/internal/tuple.h>
 #include <embb/dataflow/internal/out.h>
 
@@ -35,7 +37,6 @@ namespace dataflow {
 namespace internal {
 
 template <
-  int,
   typename = embb::base::internal::Nil,
   typename = embb::base::internal::Nil,
   typename = embb::base::internal::Nil,
@@ -43,54 +44,106 @@ template <
   typename = embb::base::internal::Nil >
 class Outputs;
 
-template <int Slices>
-class Outputs<Slices, embb::base::internal::Nil, embb::base::internal::Nil,
+template <>
+class Outputs< embb::base::internal::Nil, embb::base::internal::Nil,
   embb::base::internal::Nil, embb::base::internal::Nil,
   embb::base::internal::Nil>
   : public Tuple<embb::base::internal::Nil, embb::base::internal::Nil,
     embb::base::internal::Nil, embb::base::internal::Nil,
     embb::base::internal::Nil> {
  public:
+  void SetSlices(int /*slices*/) {}
+  void GetConsumers(std::vector<Node*> & /*consumers*/) {}
 };
 
-template <int Slices, typename T1>
-class Outputs<Slices, T1, embb::base::internal::Nil, embb::base::internal::Nil,
+template <typename T1>
+class Outputs<T1, embb::base::internal::Nil, embb::base::internal::Nil,
   embb::base::internal::Nil, embb::base::internal::Nil>
-  : public Tuple<Out<T1, Slices>, embb::base::internal::Nil,
+  : public Tuple<Out<T1>, embb::base::internal::Nil,
     embb::base::internal::Nil, embb::base::internal::Nil,
     embb::base::internal::Nil> {
  public:
+  void SetSlices(int slices) {
+    this->template Get<0>().SetSlices(slices);
+  }
+  void GetConsumers(std::vector<Node*> & consumers) {
+    this->template Get<0>().GetConsumers(consumers);
+  }
 };
 
-template <int Slices, typename T1, typename T2>
-class Outputs<Slices, T1, T2, embb::base::internal::Nil,
+template <typename T1, typename T2>
+class Outputs<T1, T2, embb::base::internal::Nil,
   embb::base::internal::Nil, embb::base::internal::Nil>
-  : public Tuple<Out<T1, Slices>, Out<T2, Slices>, embb::base::internal::Nil,
+  : public Tuple<Out<T1>, Out<T2>, embb::base::internal::Nil,
     embb::base::internal::Nil, embb::base::internal::Nil> {
  public:
+  void SetSlices(int slices) {
+    this->template Get<0>().SetSlices(slices);
+    this->template Get<1>().SetSlices(slices);
+  }
+  void GetConsumers(std::vector<Node*> & consumers) {
+    this->template Get<0>().GetConsumers(consumers);
+    this->template Get<1>().GetConsumers(consumers);
+  }
 };
 
-template <int Slices, typename T1, typename T2, typename T3>
-class Outputs<Slices, T1, T2, T3, embb::base::internal::Nil,
+template <typename T1, typename T2, typename T3>
+class Outputs<T1, T2, T3, embb::base::internal::Nil,
   embb::base::internal::Nil>
-  : public Tuple<Out<T1, Slices>, Out<T2, Slices>, Out<T3, Slices>,
+  : public Tuple<Out<T1>, Out<T2>, Out<T3>,
     embb::base::internal::Nil, embb::base::internal::Nil> {
  public:
+  void SetSlices(int slices) {
+    this->template Get<0>().SetSlices(slices);
+    this->template Get<1>().SetSlices(slices);
+    this->template Get<2>().SetSlices(slices);
+  }
+  void GetConsumers(std::vector<Node*> & consumers) {
+    this->template Get<0>().GetConsumers(consumers);
+    this->template Get<1>().GetConsumers(consumers);
+    this->template Get<2>().GetConsumers(consumers);
+  }
 };
 
-template <int Slices, typename T1, typename T2, typename T3, typename T4>
-class Outputs<Slices, T1, T2, T3, T4, embb::base::internal::Nil>
-  : public Tuple<Out<T1, Slices>, Out<T2, Slices>, Out<T3, Slices>,
-      Out<T4, Slices>, embb::base::internal::Nil>{
+template <typename T1, typename T2, typename T3, typename T4>
+class Outputs<T1, T2, T3, T4, embb::base::internal::Nil>
+  : public Tuple<Out<T1>, Out<T2>, Out<T3>,
+      Out<T4>, embb::base::internal::Nil>{
  public:
+  void SetSlices(int slices) {
+    this->template Get<0>().SetSlices(slices);
+    this->template Get<1>().SetSlices(slices);
+    this->template Get<2>().SetSlices(slices);
+    this->template Get<3>().SetSlices(slices);
+  }
+  void GetConsumers(std::vector<Node*> & consumers) {
+    this->template Get<0>().GetConsumers(consumers);
+    this->template Get<1>().GetConsumers(consumers);
+    this->template Get<2>().GetConsumers(consumers);
+    this->template Get<3>().GetConsumers(consumers);
+  }
 };
 
-template <int Slices, typename T1, typename T2, typename T3, typename T4,
+template <typename T1, typename T2, typename T3, typename T4,
   typename T5>
 class Outputs
-  : public Tuple<Out<T1, Slices>, Out<T2, Slices>, Out<T3, Slices>,
-      Out<T4, Slices>, Out<T5, Slices> > {
+  : public Tuple<Out<T1>, Out<T2>, Out<T3>,
+      Out<T4>, Out<T5> > {
  public:
+  void SetSlices(int slices) {
+    this->template Get<0>().SetSlices(slices);
+    this->template Get<1>().SetSlices(slices);
+    this->template Get<2>().SetSlices(slices);
+    this->template Get<3>().SetSlices(slices);
+    this->template Get<4>().SetSlices(slices);
+  }
+  void GetConsumers(std::vector<Node*> & consumers) {
+    this->template Get<0>().GetConsumers(consumers);
+    this->template Get<1>().GetConsumers(consumers);
+    this->template Get<2>().GetConsumers(consumers);
+    this->template Get<3>().GetConsumers(consumers);
+    this->template Get<4>().GetConsumers(consumers);
+  }
 };
 
 } // namespace internal
@@ -32,31 +32,37 @@
 #include <embb/dataflow/internal/outputs.h>
 #include <embb/dataflow/internal/process_executor.h>
 #include <embb/dataflow/internal/action.h>
+#include <embb/dataflow/internal/in_order_queue.h>
+#include <embb/dataflow/internal/slot_array.h>
 
 namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <int Slices, bool Serial, class INPUTS, class OUTPUTS> class Process;
+template <bool Serial, class INPUTS, class OUTPUTS> class Process;
 
 template <
-  int Slices, bool Serial,
+  bool Serial,
   typename I1, typename I2, typename I3, typename I4, typename I5,
   typename O1, typename O2, typename O3, typename O4, typename O5>
-class Process< Slices, Serial, Inputs<Slices, I1, I2, I3, I4, I5>,
-  Outputs<Slices, O1, O2, O3, O4, O5> >
+class Process< Serial, Inputs<I1, I2, I3, I4, I5>,
+  Outputs<O1, O2, O3, O4, O5> >
   : public Node
   , public ClockListener {
  public:
-  typedef Inputs<Slices, I1, I2, I3, I4, I5> InputsType;
-  typedef Outputs<Slices, O1, O2, O3, O4, O5> OutputsType;
+  typedef Inputs<I1, I2, I3, I4, I5> InputsType;
+  typedef Outputs<O1, O2, O3, O4, O5> OutputsType;
   typedef ProcessExecutor< InputsType, OutputsType > ExecutorType;
   typedef typename ExecutorType::FunctionType FunctionType;
 
-  explicit Process(FunctionType function)
+  explicit Process(
+    FunctionType function,
+    embb::mtapi::ExecutionPolicy const & policy =
+      embb::mtapi::ExecutionPolicy())
     : executor_(function) {
-    next_clock_ = 0;
     inputs_.SetListener(this);
+    inputs_.SetOwner(this);
+    SetPolicy(policy);
   }
 
   virtual bool HasInputs() const {
@@ -68,7 +74,43 @@ class Process< Slices, Serial, Inputs<Slices, I1, I2, I3, I4, I5>,
   }
 
   virtual void Run(int clock) {
-    executor_.Execute(clock, inputs_, outputs_);
+    Execute(clock);
+    if (Serial && fused_producer_ == NULL) {
+      queue_.SetDone(sched_, clock);
+    }
+  }
+
+  virtual ExecutionMode GetExecutionMode() const {
+    return Serial ? EXECUTE_SERIAL : EXECUTE_PARALLEL;
+  }
+
+  virtual void ResetFusion() {
+    Node::ResetFusion();
+    inputs_.template Get<0>().SetProducer(NULL);
+  }
+
+  virtual void OfferFusion() {
+    if (outputs_.Size() == 1) {
+      outputs_.template Get<0>().OfferFusion(this);
+    }
+  }
+
+  virtual void AcceptFusion() {
+    if (inputs_.Size() == 1) {
+      FuseInto(inputs_.template Get<0>().GetProducer());
+    }
+  }
+
+  virtual void GetConsumers(std::vector<Node*> & consumers) {
+    outputs_.GetConsumers(consumers);
+  }
+
+  virtual void SetSlices(int slices) {
+    Node::SetSlices(slices);
+    inputs_.SetSlices(slices);
+    outputs_.SetSlices(slices);
+    action_.Resize(Serial ? 0 : slices);
+    queue_.Reset(this, Serial ? slices : 0);
   }
 
   InputsType & GetInputs() {
@@ -98,22 +140,25 @@ class Process< Slices, Serial, Inputs<Slices, I1, I2, I3, I4, I5>,
     if (!inputs_.AreAtClock(clock))
       EMBB_THROW(embb::base::ErrorException,
         "Some inputs are not at expected clock.")
+    ProfileReady(clock);
 
     bool ordered = Serial;
-    if (ordered) {
-      lock_.Lock();
-      for (int ii = next_clock_; ii < next_clock_ + Slices; ii++) {
-        if (!inputs_.AreAtClock(ii)) {
-          break;
-        }
-        next_clock_ = ii + 1;
-        Run(ii);
+    if (fused_producer_ != NULL) {
+      Run(clock);
+    } else if (!inputs_.AreNoneBlank(clock)) {
+      // Blanks do not run the function, so they are forwarded right away
+      // instead of in a task of their own. The queue must pass over the
+      // clock before forwarding, as the slot is reused once the token is
+      // complete.
+      if (ordered) {
+        queue_.SetSkipped(sched_, clock);
       }
-      lock_.Unlock();
+      Execute(clock);
+    } else if (ordered) {
+      queue_.SetReady(sched_, clock);
     } else {
-      const int idx = clock % Slices;
-      action_[idx] = Action(this, clock);
-      sched_->Spawn(action_[idx]);
+      action_[clock] = Action(this, clock);
+      sched_->Spawn(action_[clock]);
     }
   }
 
@@ -121,9 +166,15 @@ class Process< Slices, Serial, Inputs<Slices, I1, I2, I3, I4, I5>,
   InputsType inputs_;
   OutputsType outputs_;
   ExecutorType executor_;
-  int next_clock_;
-  Action action_[Slices];
-  SpinLock lock_;
+  SlotArray<Action> action_;
+  InOrderQueue queue_;
+
+  void Execute(int clock) {
+    const ProfileMark mark = ProfileBegin();
+    const bool blank = !inputs_.AreNoneBlank(clock);
+    executor_.Execute(clock, inputs_, outputs_);
+    ProfileEnd(clock, mark, blank);
+  }
 };
 
 } // namespace internal
@@ -40,8 +40,8 @@ namespace internal {
 template <class Inputs, class Outputs>
 class ProcessExecutor;
 
-template <int Slices, typename I1, typename O1>
-class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1> > {
+template <typename I1, typename O1>
+class ProcessExecutor< Inputs<I1>, Outputs<O1> > {
  public:
   typedef embb::base::Function<void, I1 const &, O1 &> FunctionType;
 
@@ -49,14 +49,14 @@ class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1> & inputs,
-    Outputs<Slices, O1> & outputs) {
+    Inputs<I1> & inputs,
+    Outputs<O1> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         o1);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
+      outputs.template Get<0>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
     }
@@ -66,8 +66,8 @@ class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename O1, typename O2>
-class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2> > {
+template <typename I1, typename O1, typename O2>
+class ProcessExecutor< Inputs<I1>, Outputs<O1, O2> > {
  public:
   typedef embb::base::Function<void, I1 const &, O1 &, O2 &> FunctionType;
 
@@ -75,16 +75,16 @@ class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1> & inputs,
-    Outputs<Slices, O1, O2> & outputs) {
+    Inputs<I1> & inputs,
+    Outputs<O1, O2> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
-      O2 o2;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
+      O2 & o2 = outputs.template Get<1>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         o1, o2);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-      outputs.template Get<1>().Send(Signal<O2>(clock, o2));
+      outputs.template Get<0>().Commit(clock);
+      outputs.template Get<1>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
       outputs.template Get<1>().Send(Signal<O2>(clock));
@@ -95,8 +95,8 @@ class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename O1, typename O2, typename O3>
-class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2, O3> > {
+template <typename I1, typename O1, typename O2, typename O3>
+class ProcessExecutor< Inputs<I1>, Outputs<O1, O2, O3> > {
  public:
   typedef embb::base::Function<void, I1 const &, O1 &, O2 &, O3 &>
     FunctionType;
@@ -105,18 +105,18 @@ class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2, O3> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1> & inputs,
-    Outputs<Slices, O1, O2, O3> & outputs) {
+    Inputs<I1> & inputs,
+    Outputs<O1, O2, O3> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
-      O2 o2;
-      O3 o3;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
+      O2 & o2 = outputs.template Get<1>().Prepare(clock);
+      O3 & o3 = outputs.template Get<2>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         o1, o2, o3);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-      outputs.template Get<1>().Send(Signal<O2>(clock, o2));
-      outputs.template Get<2>().Send(Signal<O3>(clock, o3));
+      outputs.template Get<0>().Commit(clock);
+      outputs.template Get<1>().Commit(clock);
+      outputs.template Get<2>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
       outputs.template Get<1>().Send(Signal<O2>(clock));
@@ -128,9 +128,9 @@ class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2, O3> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename O1, typename O2, typename O3,
+template <typename I1, typename O1, typename O2, typename O3,
   typename O4>
-class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2, O3, O4> > {
+class ProcessExecutor< Inputs<I1>, Outputs<O1, O2, O3, O4> > {
  public:
   typedef embb::base::Function<void, I1 const &, O1 &, O2 &, O3 &, O4 &>
     FunctionType;
@@ -139,20 +139,20 @@ class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2, O3, O4> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1> & inputs,
-    Outputs<Slices, O1, O2, O3, O4> & outputs) {
+    Inputs<I1> & inputs,
+    Outputs<O1, O2, O3, O4> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
-      O2 o2;
-      O3 o3;
-      O4 o4;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
+      O2 & o2 = outputs.template Get<1>().Prepare(clock);
+      O3 & o3 = outputs.template Get<2>().Prepare(clock);
+      O4 & o4 = outputs.template Get<3>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         o1, o2, o3, o4);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-      outputs.template Get<1>().Send(Signal<O2>(clock, o2));
-      outputs.template Get<2>().Send(Signal<O3>(clock, o3));
-      outputs.template Get<3>().Send(Signal<O4>(clock, o4));
+      outputs.template Get<0>().Commit(clock);
+      outputs.template Get<1>().Commit(clock);
+      outputs.template Get<2>().Commit(clock);
+      outputs.template Get<3>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
       outputs.template Get<1>().Send(Signal<O2>(clock));
@@ -165,8 +165,8 @@ class ProcessExecutor< Inputs<Slices, I1>, Outputs<Slices, O1, O2, O3, O4> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename I2, typename O1>
-class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1> > {
+template <typename I1, typename I2, typename O1>
+class ProcessExecutor< Inputs<I1, I2>, Outputs<O1> > {
  public:
   typedef embb::base::Function<void, I1 const &, I2 const &, O1 &>
     FunctionType;
@@ -175,15 +175,15 @@ class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1, I2> & inputs,
-    Outputs<Slices, O1> & outputs) {
+    Inputs<I1, I2> & inputs,
+    Outputs<O1> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         inputs.template Get<1>().GetValue(clock),
         o1);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
+      outputs.template Get<0>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
     }
@@ -193,8 +193,8 @@ class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename I2, typename O1, typename O2>
-class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1, O2> > {
+template <typename I1, typename I2, typename O1, typename O2>
+class ProcessExecutor< Inputs<I1, I2>, Outputs<O1, O2> > {
  public:
   typedef embb::base::Function<void, I1 const &, I2 const &, O1 &, O2 &>
     FunctionType;
@@ -203,17 +203,17 @@ class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1, O2> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1, I2> & inputs,
-    Outputs<Slices, O1, O2> & outputs) {
+    Inputs<I1, I2> & inputs,
+    Outputs<O1, O2> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
-      O2 o2;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
+      O2 & o2 = outputs.template Get<1>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         inputs.template Get<1>().GetValue(clock),
         o1, o2);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-      outputs.template Get<1>().Send(Signal<O2>(clock, o2));
+      outputs.template Get<0>().Commit(clock);
+      outputs.template Get<1>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
       outputs.template Get<1>().Send(Signal<O2>(clock));
@@ -224,9 +224,9 @@ class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1, O2> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename I2, typename O1, typename O2,
+template <typename I1, typename I2, typename O1, typename O2,
   typename O3>
-class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1, O2, O3> > {
+class ProcessExecutor< Inputs<I1, I2>, Outputs<O1, O2, O3> > {
  public:
   typedef embb::base::Function<void, I1 const &, I2 const &, O1 &, O2 &, O3 &>
     FunctionType;
@@ -235,19 +235,19 @@ class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1, O2, O3> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1, I2> & inputs,
-    Outputs<Slices, O1, O2, O3> & outputs) {
+    Inputs<I1, I2> & inputs,
+    Outputs<O1, O2, O3> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
-      O2 o2;
-      O3 o3;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
+      O2 & o2 = outputs.template Get<1>().Prepare(clock);
+      O3 & o3 = outputs.template Get<2>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         inputs.template Get<1>().GetValue(clock),
         o1, o2, o3);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-      outputs.template Get<1>().Send(Signal<O2>(clock, o2));
-      outputs.template Get<2>().Send(Signal<O3>(clock, o3));
+      outputs.template Get<0>().Commit(clock);
+      outputs.template Get<1>().Commit(clock);
+      outputs.template Get<2>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
       outputs.template Get<1>().Send(Signal<O2>(clock));
@@ -259,8 +259,8 @@ class ProcessExecutor< Inputs<Slices, I1, I2>, Outputs<Slices, O1, O2, O3> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename I2, typename I3, typename O1>
-class ProcessExecutor< Inputs<Slices, I1, I2, I3>, Outputs<Slices, O1> > {
+template <typename I1, typename I2, typename I3, typename O1>
+class ProcessExecutor< Inputs<I1, I2, I3>, Outputs<O1> > {
  public:
   typedef embb::base::Function<void, I1 const &, I2 const &, I3 const &, O1 &>
     FunctionType;
@@ -269,16 +269,16 @@ class ProcessExecutor< Inputs<Slices, I1, I2, I3>, Outputs<Slices, O1> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1, I2, I3> & inputs,
-    Outputs<Slices, O1> & outputs) {
+    Inputs<I1, I2, I3> & inputs,
+    Outputs<O1> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         inputs.template Get<1>().GetValue(clock),
         inputs.template Get<2>().GetValue(clock),
         o1);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
+      outputs.template Get<0>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
     }
@@ -288,9 +288,9 @@ class ProcessExecutor< Inputs<Slices, I1, I2, I3>, Outputs<Slices, O1> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename I2, typename I3, typename O1,
+template <typename I1, typename I2, typename I3, typename O1,
   typename O2>
-class ProcessExecutor< Inputs<Slices, I1, I2, I3>, Outputs<Slices, O1, O2> > {
+class ProcessExecutor< Inputs<I1, I2, I3>, Outputs<O1, O2> > {
  public:
   typedef embb::base::Function<void, I1 const &, I2 const &, I3 const &,
     O1 &, O2 &> FunctionType;
@@ -299,18 +299,18 @@ class ProcessExecutor< Inputs<Slices, I1, I2, I3>, Outputs<Slices, O1, O2> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1, I2, I3> & inputs,
-    Outputs<Slices, O1, O2> & outputs) {
+    Inputs<I1, I2, I3> & inputs,
+    Outputs<O1, O2> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
-      O2 o2;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
+      O2 & o2 = outputs.template Get<1>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         inputs.template Get<1>().GetValue(clock),
         inputs.template Get<2>().GetValue(clock),
         o1, o2);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-      outputs.template Get<1>().Send(Signal<O2>(clock, o2));
+      outputs.template Get<0>().Commit(clock);
+      outputs.template Get<1>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
       outputs.template Get<1>().Send(Signal<O2>(clock));
@@ -321,9 +321,9 @@ class ProcessExecutor< Inputs<Slices, I1, I2, I3>, Outputs<Slices, O1, O2> > {
   FunctionType function_;
 };
 
-template <int Slices, typename I1, typename I2, typename I3, typename I4,
+template <typename I1, typename I2, typename I3, typename I4,
   typename O1>
-class ProcessExecutor< Inputs<Slices, I1, I2, I3, I4>, Outputs<Slices, O1> > {
+class ProcessExecutor< Inputs<I1, I2, I3, I4>, Outputs<O1> > {
  public:
   typedef embb::base::Function<void, I1 const &, I2 const &, I3 const &,
     I4 const &, O1 &> FunctionType;
@@ -332,17 +332,17 @@ class ProcessExecutor< Inputs<Slices, I1, I2, I3, I4>, Outputs<Slices, O1> > {
 
   void Execute(
     int clock,
-    Inputs<Slices, I1, I2, I3, I4> & inputs,
-    Outputs<Slices, O1> & outputs) {
+    Inputs<I1, I2, I3, I4> & inputs,
+    Outputs<O1> & outputs) {
     if (inputs.AreNoneBlank(clock)) {
-      O1 o1;
+      O1 & o1 = outputs.template Get<0>().Prepare(clock);
       function_(
         inputs.template Get<0>().GetValue(clock),
         inputs.template Get<1>().GetValue(clock),
         inputs.template Get<2>().GetValue(clock),
         inputs.template Get<3>().GetValue(clock),
         o1);
-      outputs.template Get<0>().Send(Signal<O1>(clock, o1));
+      outputs.template Get<0>().Commit(clock);
     } else {
       outputs.template Get<0>().Send(Signal<O1>(clock));
     }
@@ -27,42 +27,46 @@
 #ifndef EMBB_DATAFLOW_INTERNAL_SCHEDULER_MTAPI_H_
 #define EMBB_DATAFLOW_INTERNAL_SCHEDULER_MTAPI_H_
 
+#include <vector>
+
 #include <embb/dataflow/internal/action.h>
 #include <embb/dataflow/internal/scheduler.h>
 #include <embb/mtapi/node.h>
+#include <embb/mtapi/action.h>
 #include <embb/base/function.h>
 
 namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <int Slices>
 class SchedulerMTAPI : public Scheduler {
  public:
-  SchedulerMTAPI() {
+  explicit SchedulerMTAPI(int slices) : group_(slices) {
     embb::mtapi::Node & node = embb::mtapi::Node::GetInstance();
-    for (int ii = 0; ii < Slices; ii++) {
+    for (int ii = 0; ii < slices; ii++) {
       embb::mtapi::Group & group = node.CreateGroup();
       group_[ii] = &group;
     }
   }
   virtual ~SchedulerMTAPI() {
     embb::mtapi::Node & node = embb::mtapi::Node::GetInstance();
-    for (int ii = 0; ii < Slices; ii++) {
+    for (size_t ii = 0; ii < group_.size(); ii++) {
       group_[ii]->WaitAll(MTAPI_INFINITE);
       node.DestroyGroup(*group_[ii]);
     }
   }
   virtual void Spawn(Action & action) {
-    const int idx = action.GetClock() % Slices;
-    group_[idx]->Spawn(embb::base::MakeFunction(action, &Action::RunMTAPI));
+    const int idx = action.GetClock() % static_cast<int>(group_.size());
+    group_[idx]->Spawn(embb::mtapi::Action(
+      embb::base::MakeFunction(action, &Action::RunMTAPI),
+      action.GetPolicy()));
   }
   virtual void WaitForSlice(int slice) {
     group_[slice]->WaitAll(MTAPI_INFINITE);
   }
 
  private:
-  embb::mtapi::Group * group_[Slices];
+  std::vector<embb::mtapi::Group *> group_;
 };
 
 } // namespace internal
@@ -37,16 +37,17 @@ namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <int Slices, typename Type>
+template <typename Type>
 class Select
   : public Node
   , public ClockListener {
  public:
-  typedef Inputs<Slices, bool, Type, Type> InputsType;
-  typedef Outputs<Slices, Type> OutputsType;
+  typedef Inputs<bool, Type, Type> InputsType;
+  typedef Outputs<Type> OutputsType;
 
   Select() {
     inputs_.SetListener(this);
+    inputs_.SetOwner(this);
   }
 
   virtual bool HasInputs() const {
@@ -58,27 +59,39 @@ class Select
   }
 
   virtual void Run(int clock) {
+    const ProfileMark mark = ProfileBegin();
+    bool blank = true;
     if (GetInput<0>().GetSignal(clock).IsBlank()) {
       GetOutput<0>().Send(Signal<Type>(clock));
     } else {
       bool pred = GetInput<0>().GetValue(clock);
-      Type val;
       if (pred) {
         if (GetInput<1>().GetSignal(clock).IsBlank()) {
           GetOutput<0>().Send(Signal<Type>(clock));
         } else {
-          val = GetInput<1>().GetValue(clock);
-          GetOutput<0>().Send(Signal<Type>(clock, val));
+          GetOutput<0>().Send(clock, GetInput<1>().GetValue(clock));
+          blank = false;
         }
       } else {
         if (GetInput<2>().GetSignal(clock).IsBlank()) {
           GetOutput<0>().Send(Signal<Type>(clock));
         } else {
-          val = GetInput<2>().GetValue(clock);
-          GetOutput<0>().Send(Signal<Type>(clock, val));
+          GetOutput<0>().Send(clock, GetInput<2>().GetValue(clock));
+          blank = false;
         }
       }
     }
+    ProfileEnd(clock, mark, blank);
+  }
+
+  virtual void GetConsumers(std::vector<Node*> & consumers) {
+    outputs_.GetConsumers(consumers);
+  }
+
+  virtual void SetSlices(int slices) {
+    Node::SetSlices(slices);
+    inputs_.SetSlices(slices);
+    outputs_.SetSlices(slices);
   }
 
   InputsType & GetInputs() {
@@ -105,17 +118,16 @@ class Select
   }
 
   virtual void OnClock(int clock) {
-    //const int idx = clock % Slices;
     if (!inputs_.AreAtClock(clock))
       EMBB_THROW(embb::base::ErrorException,
         "Some inputs are not at expected clock.")
+    ProfileReady(clock);
     Run(clock);
   }
 
  private:
   InputsType inputs_;
   OutputsType outputs_;
-  Action action_[Slices];
 };
 
 } // namespace internal
@@ -27,42 +27,55 @@
 #ifndef EMBB_DATAFLOW_INTERNAL_SIGNAL_H_
 #define EMBB_DATAFLOW_INTERNAL_SIGNAL_H_
 
-#include <embb/dataflow/internal/spinlock.h>
-
 namespace embb {
 namespace dataflow {
 namespace internal {
 
+/**
+ * Token slot of an input port. A slot is written by exactly one producer
+ * per clock and the consumer is only notified afterwards, so no locking is
+ * required.
+ */
 template <typename Type>
 class Signal {
  public:
   Signal() : blank_(true), value_(), clock_(-1) {}
-  Signal(int clock, Type value) : blank_(false), value_(value), clock_(clock) {}
+  Signal(int clock, Type const & value)
+    : blank_(false), value_(value), clock_(clock) {}
   explicit Signal(int clock) : blank_(true), value_(), clock_(clock) {}
   Signal(Signal const & other)
     : blank_(other.blank_), value_(other.value_), clock_(other.clock_) {}
-  void operator = (Signal const & rhs) {
-    lock_.Lock();
+  Signal & operator = (Signal const & rhs) {
     blank_ = rhs.blank_;
     value_ = rhs.value_;
     clock_ = rhs.clock_;
-    lock_.Unlock();
+    return *this;
   }
   int GetClock() const { return clock_; }
   bool IsBlank() const { return blank_; }
   Type const & GetValue() const { return value_; }
+  /**
+   * Returns the stored value for producing a token in place. The value
+   * becomes visible as a token after the next call to Publish().
+   */
+  Type & GetStorage() { return value_; }
+  void Set(int clock, Type const & value) {
+    value_ = value;
+    Publish(clock);
+  }
+  void Publish(int clock) {
+    blank_ = false;
+    clock_ = clock;
+  }
   void Clear() {
-    lock_.Lock();
     blank_ = true;
     clock_ = -1;
-    lock_.Unlock();
   }
 
  private:
   bool blank_;
   Type value_;
   int clock_;
-  SpinLock lock_;
 };
 
 } // namespace internal
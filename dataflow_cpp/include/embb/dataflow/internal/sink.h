@@ -31,28 +31,32 @@
 #include <embb/dataflow/internal/inputs.h>
 #include <embb/dataflow/internal/sink_executor.h>
 #include <embb/dataflow/internal/action.h>
+#include <embb/dataflow/internal/in_order_queue.h>
 
 namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <int Slices, class Inputs> class Sink;
+template <class Inputs> class Sink;
 
 template <
-  int Slices,
   typename I1, typename I2, typename I3, typename I4, typename I5>
-class Sink< Slices, Inputs<Slices, I1, I2, I3, I4, I5> >
+class Sink< Inputs<I1, I2, I3, I4, I5> >
   : public Node
   , public ClockListener {
  public:
-  typedef Inputs<Slices, I1, I2, I3, I4, I5> InputsType;
+  typedef Inputs<I1, I2, I3, I4, I5> InputsType;
   typedef SinkExecutor< InputsType > ExecutorType;
   typedef typename ExecutorType::FunctionType FunctionType;
 
-  explicit Sink(FunctionType function)
+  explicit Sink(
+    FunctionType function,
+    embb::mtapi::ExecutionPolicy const & policy =
+      embb::mtapi::ExecutionPolicy())
     : executor_(function) {
-    next_clock_ = 0;
     inputs_.SetListener(this);
+    inputs_.SetOwner(this);
+    SetPolicy(policy);
   }
 
   void SetListener(ClockListener * listener) {
@@ -64,10 +68,31 @@ class Sink< Slices, Inputs<Slices, I1, I2, I3, I4, I5> >
   }
 
   virtual void Run(int clock) {
-    if (inputs_.AreNoneBlank(clock)) {
-      executor_.Execute(clock, inputs_);
+    Execute(clock);
+    if (fused_producer_ == NULL) {
+      queue_.SetDone(sched_, clock);
     }
-    listener_->OnClock(clock);
+  }
+
+  virtual ExecutionMode GetExecutionMode() const {
+    return EXECUTE_SERIAL;
+  }
+
+  virtual void ResetFusion() {
+    Node::ResetFusion();
+    inputs_.template Get<0>().SetProducer(NULL);
+  }
+
+  virtual void AcceptFusion() {
+    if (inputs_.Size() == 1) {
+      FuseInto(inputs_.template Get<0>().GetProducer());
+    }
+  }
+
+  virtual void SetSlices(int slices) {
+    Node::SetSlices(slices);
+    inputs_.SetSlices(slices);
+    queue_.Reset(this, slices);
   }
 
   InputsType & GetInputs() {
@@ -80,31 +105,36 @@ class Sink< Slices, Inputs<Slices, I1, I2, I3, I4, I5> >
   }
 
   virtual void OnClock(int clock) {
-    TrySpawn(clock);
+    if (!inputs_.AreAtClock(clock))
+      EMBB_THROW(embb::base::ErrorException,
+        "Some inputs are not at expected clock.")
+    ProfileReady(clock);
+    if (fused_producer_ != NULL) {
+      Run(clock);
+    } else if (!inputs_.AreNoneBlank(clock)) {
+      // Blanks are not passed to the function, so they are completed right
+      // away instead of in a task of their own, see Process::OnClock()
+      queue_.SetSkipped(sched_, clock);
+      Execute(clock);
+    } else {
+      queue_.SetReady(sched_, clock);
+    }
   }
 
  private:
   InputsType inputs_;
   ExecutorType executor_;
-  int next_clock_;
-  Action action_[Slices];
   ClockListener * listener_;
-  SpinLock lock_;
-
-  void TrySpawn(int clock) {
-    if (!inputs_.AreAtClock(clock))
-      EMBB_THROW(embb::base::ErrorException,
-        "Some inputs are not at expected clock.")
+  InOrderQueue queue_;
 
-    lock_.Lock();
-    for (int ii = next_clock_; ii < next_clock_ + Slices; ii++) {
-      if (!inputs_.AreAtClock(ii)) {
-        break;
-      }
-      next_clock_ = ii + 1;
-      Run(ii);
+  void Execute(int clock) {
+    const ProfileMark mark = ProfileBegin();
+    const bool blank = !inputs_.AreNoneBlank(clock);
+    if (!blank) {
+      executor_.Execute(clock, inputs_);
     }
-    lock_.Unlock();
+    ProfileEnd(clock, mark, blank);
+    listener_->OnClock(clock);
   }
 };
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_DATAFLOW_INTERNAL_SLOT_ARRAY_H_
+#define EMBB_DATAFLOW_INTERNAL_SLOT_ARRAY_H_
+
+#include <cstddef>
+#include <new>
+
+#include <embb/base/memory_allocation.h>
+
+namespace embb {
+namespace dataflow {
+namespace internal {
+
+/**
+ * Per-slot state of a node or port. The number of slots is the number of
+ * tokens the network keeps in flight and is only known when the network is
+ * started. Slots are indexed by clock and reused in ring order.
+ */
+template <typename Type>
+class SlotArray {
+ public:
+  SlotArray() : slots_(NULL), size_(0) {}
+
+  ~SlotArray() {
+    Free();
+  }
+
+  /**
+   * Replaces all slots by \c size default-constructed ones.
+   */
+  void Resize(int size) {
+    Free();
+    if (size > 0) {
+      slots_ = static_cast<Type*>(embb::base::Allocation::Allocate(
+        sizeof(Type) * static_cast<size_t>(size)));
+      for (int ii = 0; ii < size; ii++) {
+        new (&slots_[ii]) Type();
+      }
+      size_ = size;
+    }
+  }
+
+  int GetSize() const { return size_; }
+
+  Type & operator [] (int clock) {
+    return slots_[clock % size_];
+  }
+
+  Type const & operator [] (int clock) const {
+    return slots_[clock % size_];
+  }
+
+ private:
+  void Free() {
+    for (int ii = 0; ii < size_; ii++) {
+      slots_[ii].~Type();
+    }
+    if (slots_ != NULL) {
+      embb::base::Allocation::Free(slots_);
+    }
+    slots_ = NULL;
+    size_ = 0;
+  }
+
+  // Prevent copy-construction
+  SlotArray(SlotArray const &);
+
+  // Prevent assignment
+  SlotArray & operator = (SlotArray const &);
+
+  Type * slots_;
+  int size_;
+};
+
+} // namespace internal
+} // namespace dataflow
+} // namespace embb
+
+#endif // EMBB_DATAFLOW_INTERNAL_SLOT_ARRAY_H_
@@ -34,20 +34,21 @@
 #include <embb/dataflow/internal/outputs.h>
 #include <embb/dataflow/internal/source_executor.h>
 #include <embb/dataflow/internal/action.h>
+#include <embb/dataflow/internal/clock_listener.h>
+#include <embb/dataflow/internal/slot_array.h>
 
 namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <int Slices, class Outputs> class Source;
+template <class Outputs> class Source;
 
 template <
-  int Slices,
   typename O1, typename O2, typename O3, typename O4, typename O5>
-class Source< Slices, Outputs<Slices, O1, O2, O3, O4, O5> >
+class Source< Outputs<O1, O2, O3, O4, O5> >
   : public Node {
  public:
-  typedef Outputs<Slices, O1, O2, O3, O4, O5> OutputsType;
+  typedef Outputs<O1, O2, O3, O4, O5> OutputsType;
   typedef SourceExecutor< OutputsType > ExecutorType;
   typedef typename ExecutorType::FunctionType FunctionType;
 
@@ -60,16 +61,35 @@ class Source< Slices, Outputs<Slices, O1, O2, O3, O4, O5> >
     return outputs_.Size() > 0;
   }
 
+  void SetListener(ClockListener * listener) {
+    listener_ = listener;
+  }
+
   virtual void Run(int clock) {
+    const ProfileMark mark = ProfileBegin();
     not_done_ = executor_.Execute(clock, outputs_);
+    ProfileEnd(clock, mark, false);
     next_clock_++;
+    listener_->OnClock(clock);
+  }
+
+  virtual void GetConsumers(std::vector<Node*> & consumers) {
+    outputs_.GetConsumers(consumers);
+  }
+
+  virtual void SetSlices(int slices) {
+    Node::SetSlices(slices);
+    outputs_.SetSlices(slices);
+    action_.Resize(slices);
+  }
+
+  virtual void Start(int clock) {
+    action_[clock] = Action(this, clock);
+    sched_->Spawn(action_[clock]);
   }
 
-  virtual bool Start(int clock) {
-    if (not_done_) {
-      Run(clock);
-    }
-    return not_done_;
+  virtual bool IsDone() const {
+    return !not_done_;
   }
 
   OutputsType & GetOutputs() {
@@ -89,7 +109,8 @@ class Source< Slices, Outputs<Slices, O1, O2, O3, O4, O5> >
  private:
   OutputsType outputs_;
   ExecutorType executor_;
-  Action action_[Slices];
+  SlotArray<Action> action_;
+  ClockListener * listener_;
   volatile bool not_done_;
   embb::base::Atomic<int> next_clock_;
 };
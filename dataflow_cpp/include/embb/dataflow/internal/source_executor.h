@@ -39,8 +39,8 @@ namespace internal {
 template <class OUTPUTS>
 class SourceExecutor;
 
-template <int Slices, typename O1>
-class SourceExecutor< Outputs<Slices, O1> > {
+template <typename O1>
+class SourceExecutor< Outputs<O1> > {
  public:
   typedef embb::base::Function<bool, O1 &> FunctionType;
 
@@ -48,10 +48,10 @@ class SourceExecutor< Outputs<Slices, O1> > {
 
   bool Execute(
     int clock,
-    Outputs<Slices, O1> & outputs) {
-    O1 o1;
+    Outputs<O1> & outputs) {
+    O1 & o1 = outputs.template Get<0>().Prepare(clock);
     bool result = function_(o1);
-    outputs.template Get<0>().Send(Signal<O1>(clock, o1));
+    outputs.template Get<0>().Commit(clock);
     return result;
   }
 
@@ -59,8 +59,8 @@ class SourceExecutor< Outputs<Slices, O1> > {
   FunctionType function_;
 };
 
-template <int Slices, typename O1, typename O2>
-class SourceExecutor< Outputs<Slices, O1, O2> > {
+template <typename O1, typename O2>
+class SourceExecutor< Outputs<O1, O2> > {
  public:
   typedef embb::base::Function<bool, O1 &, O2 &> FunctionType;
 
@@ -68,12 +68,12 @@ class SourceExecutor< Outputs<Slices, O1, O2> > {
 
   bool Execute(
     int clock,
-    Outputs<Slices, O1, O2> & outputs) {
-    O1 o1;
-    O2 o2;
+    Outputs<O1, O2> & outputs) {
+    O1 & o1 = outputs.template Get<0>().Prepare(clock);
+    O2 & o2 = outputs.template Get<1>().Prepare(clock);
     bool result = function_(o1, o2);
-    outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-    outputs.template Get<1>().Send(Signal<O2>(clock, o2));
+    outputs.template Get<0>().Commit(clock);
+    outputs.template Get<1>().Commit(clock);
     return result;
   }
 
@@ -81,8 +81,8 @@ class SourceExecutor< Outputs<Slices, O1, O2> > {
   FunctionType function_;
 };
 
-template <int Slices, typename O1, typename O2, typename O3>
-class SourceExecutor< Outputs<Slices, O1, O2, O3> > {
+template <typename O1, typename O2, typename O3>
+class SourceExecutor< Outputs<O1, O2, O3> > {
  public:
   typedef embb::base::Function<bool, O1 &, O2 &, O3 &> FunctionType;
 
@@ -90,14 +90,14 @@ class SourceExecutor< Outputs<Slices, O1, O2, O3> > {
 
   bool Execute(
     int clock,
-    Outputs<Slices, O1, O2, O3> & outputs) {
-    O1 o1;
-    O2 o2;
-    O3 o3;
+    Outputs<O1, O2, O3> & outputs) {
+    O1 & o1 = outputs.template Get<0>().Prepare(clock);
+    O2 & o2 = outputs.template Get<1>().Prepare(clock);
+    O3 & o3 = outputs.template Get<2>().Prepare(clock);
     bool result = function_(o1, o2, o3);
-    outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-    outputs.template Get<1>().Send(Signal<O2>(clock, o2));
-    outputs.template Get<2>().Send(Signal<O3>(clock, o3));
+    outputs.template Get<0>().Commit(clock);
+    outputs.template Get<1>().Commit(clock);
+    outputs.template Get<2>().Commit(clock);
     return result;
   }
 
@@ -105,8 +105,8 @@ class SourceExecutor< Outputs<Slices, O1, O2, O3> > {
   FunctionType function_;
 };
 
-template <int Slices, typename O1, typename O2, typename O3, typename O4>
-class SourceExecutor< Outputs<Slices, O1, O2, O3, O4> > {
+template <typename O1, typename O2, typename O3, typename O4>
+class SourceExecutor< Outputs<O1, O2, O3, O4> > {
  public:
   typedef embb::base::Function<bool, O1 &, O2 &, O3 &, O4 &> FunctionType;
 
@@ -114,16 +114,16 @@ class SourceExecutor< Outputs<Slices, O1, O2, O3, O4> > {
 
   bool Execute(
     int clock,
-    Outputs<Slices, O1, O2, O3, O4> & outputs) {
-    O1 o1;
-    O2 o2;
-    O3 o3;
-    O4 o4;
+    Outputs<O1, O2, O3, O4> & outputs) {
+    O1 & o1 = outputs.template Get<0>().Prepare(clock);
+    O2 & o2 = outputs.template Get<1>().Prepare(clock);
+    O3 & o3 = outputs.template Get<2>().Prepare(clock);
+    O4 & o4 = outputs.template Get<3>().Prepare(clock);
     bool result = function_(o1, o2, o3, o4);
-    outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-    outputs.template Get<1>().Send(Signal<O2>(clock, o2));
-    outputs.template Get<2>().Send(Signal<O3>(clock, o3));
-    outputs.template Get<3>().Send(Signal<O4>(clock, o4));
+    outputs.template Get<0>().Commit(clock);
+    outputs.template Get<1>().Commit(clock);
+    outputs.template Get<2>().Commit(clock);
+    outputs.template Get<3>().Commit(clock);
     return result;
   }
 
@@ -131,9 +131,9 @@ class SourceExecutor< Outputs<Slices, O1, O2, O3, O4> > {
   FunctionType function_;
 };
 
-template <int Slices, typename O1, typename O2, typename O3, typename O4,
+template <typename O1, typename O2, typename O3, typename O4,
   typename O5>
-class SourceExecutor< Outputs<Slices, O1, O2, O3, O4, O5> > {
+class SourceExecutor< Outputs<O1, O2, O3, O4, O5> > {
  public:
   typedef embb::base::Function<bool, O1 &, O2 &, O3 &, O4 &, O5 &> FunctionType;
 
@@ -141,18 +141,18 @@ class SourceExecutor< Outputs<Slices, O1, O2, O3, O4, O5> > {
 
   bool Execute(
     int clock,
-    Outputs<Slices, O1, O2, O3, O4, O5> & outputs) {
-    O1 o1;
-    O2 o2;
-    O3 o3;
-    O4 o4;
-    O5 o5;
+    Outputs<O1, O2, O3, O4, O5> & outputs) {
+    O1 & o1 = outputs.template Get<0>().Prepare(clock);
+    O2 & o2 = outputs.template Get<1>().Prepare(clock);
+    O3 & o3 = outputs.template Get<2>().Prepare(clock);
+    O4 & o4 = outputs.template Get<3>().Prepare(clock);
+    O5 & o5 = outputs.template Get<4>().Prepare(clock);
     bool result = function_(o1, o2, o3, o4, o5);
-    outputs.template Get<0>().Send(Signal<O1>(clock, o1));
-    outputs.template Get<1>().Send(Signal<O2>(clock, o2));
-    outputs.template Get<2>().Send(Signal<O3>(clock, o3));
-    outputs.template Get<3>().Send(Signal<O4>(clock, o4));
-    outputs.template Get<4>().Send(Signal<O5>(clock, o5));
+    outputs.template Get<0>().Commit(clock);
+    outputs.template Get<1>().Commit(clock);
+    outputs.template Get<2>().Commit(clock);
+    outputs.template Get<3>().Commit(clock);
+    outputs.template Get<4>().Commit(clock);
     return result;
   }
 
@@ -37,16 +37,17 @@ namespace embb {
 namespace dataflow {
 namespace internal {
 
-template <int Slices, typename Type>
+template <typename Type>
 class Switch
   : public Node
   , public ClockListener {
  public:
-  typedef Inputs<Slices, bool, Type> InputsType;
-  typedef Outputs<Slices, Type, Type> OutputsType;
+  typedef Inputs<bool, Type> InputsType;
+  typedef Outputs<Type, Type> OutputsType;
 
   Switch() {
     inputs_.SetListener(this);
+    inputs_.SetOwner(this);
   }
 
   virtual bool HasInputs() const {
@@ -58,24 +59,37 @@ class Switch
   }
 
   virtual void Run(int clock) {
-    if (inputs_.AreNoneBlank(clock)) {
+    const ProfileMark mark = ProfileBegin();
+    const bool blank = !inputs_.AreNoneBlank(clock);
+    if (!blank) {
       bool pred = GetInput<0>().GetValue(clock);
-      Type val = GetInput<1>().GetValue(clock);
+      Type const & val = GetInput<1>().GetValue(clock);
       if (pred) {
         // signal with value
-        GetOutput<0>().Send(Signal<Type>(clock, val));
+        GetOutput<0>().Send(clock, val);
         // blank signal
         GetOutput<1>().Send(Signal<Type>(clock));
       } else {
         // blank signal
         GetOutput<0>().Send(Signal<Type>(clock));
         // signal with value
-        GetOutput<1>().Send(Signal<Type>(clock, val));
+        GetOutput<1>().Send(clock, val);
       }
     } else {
       GetOutput<0>().Send(Signal<Type>(clock));
       GetOutput<1>().Send(Signal<Type>(clock));
     }
+    ProfileEnd(clock, mark, blank);
+  }
+
+  virtual void GetConsumers(std::vector<Node*> & consumers) {
+    outputs_.GetConsumers(consumers);
+  }
+
+  virtual void SetSlices(int slices) {
+    Node::SetSlices(slices);
+    inputs_.SetSlices(slices);
+    outputs_.SetSlices(slices);
   }
 
   InputsType & GetInputs() {
@@ -102,17 +116,16 @@ class Switch
   }
 
   virtual void OnClock(int clock) {
-    //const int idx = clock % Slices;
     if (!inputs_.AreAtClock(clock))
       EMBB_THROW(embb::base::ErrorException,
         "Some inputs are not at expected clock.")
+    ProfileReady(clock);
     Run(clock);
   }
 
  private:
   InputsType inputs_;
   OutputsType outputs_;
-  Action action_[Slices];
 };
 
 } // namespace internal
@@ -27,19 +27,21 @@
 #ifndef EMBB_DATAFLOW_NETWORK_H_
 #define EMBB_DATAFLOW_NETWORK_H_
 
-#if EMBB_DATAFLOW_TRACE_SIGNAL_HISTORY
+#include <ostream>
 #include <vector>
-#endif
 
 #include <embb/base/atomic.h>
-#include <embb/base/thread.h>
+#include <embb/base/duration.h>
 
 #include <embb/dataflow/internal/select.h>
 #include <embb/dataflow/internal/switch.h>
 #include <embb/dataflow/internal/constant_source.h>
 #include <embb/dataflow/internal/source.h>
+#include <embb/dataflow/internal/external_source.h>
 #include <embb/dataflow/internal/process.h>
 #include <embb/dataflow/internal/sink.h>
+#include <embb/dataflow/internal/slot_array.h>
+#include <embb/dataflow/internal/clock_countdown.h>
 
 #include <embb/dataflow/internal/scheduler_sequential.h>
 #include <embb/dataflow/internal/scheduler_mtapi.h>
@@ -52,16 +54,112 @@ namespace dataflow {
 /**
  * Represents a set of processes, that are connected by communication channels.
  *
- * \tparam Slices Number of concurrently processed tokens.
+ * \tparam Slices Default number of concurrently processed tokens, see
+ *         SetSlices().
  * \ingroup CPP_DATAFLOW
  */
 template <int Slices>
 class Network {
  public:
   /**
-   * Constructs an empty network.
+   * Constructs an empty network that processes \c Slices tokens
+   * concurrently.
+   */
+  Network();
+
+  /**
+   * Constructs an empty network that processes \c slices tokens
+   * concurrently.
+   * \param slices Number of concurrently processed tokens.
+   * \throws embb::base::ErrorException if \c slices is not positive.
+   */
+  explicit Network(int slices);
+
+  /**
+   * Sets the number of concurrently processed tokens. More tokens in flight
+   * allow more stages to run in parallel, at the cost of per-token state in
+   * each node and a higher latency. Disables auto-tuning.
+   * \param slices Number of concurrently processed tokens.
+   * \throws embb::base::ErrorException if \c slices is not positive.
+   */
+  void SetSlices(int slices);
+
+  /**
+   * Returns the number of concurrently processed tokens. After a run with
+   * auto-tuning enabled, this is the tuned value.
+   * \returns Number of concurrently processed tokens.
+   */
+  int GetSlices() const;
+
+  /**
+   * Enables auto-tuning of the number of concurrently processed tokens.
+   * Starting at the value given by SetSlices(), each run increases it one
+   * at a time as long as the throughput improves, up to \c max_slices. It
+   * is decreased again if the latency of a token from its source to all
+   * sinks exceeds \c max_latency.
+   * \param max_slices Upper bound for the number of tokens in flight.
+   * \param max_latency Upper bound for the latency of a token.
+   * \throws embb::base::ErrorException if \c max_slices is smaller than
+   *         the current number of slices.
+   */
+  void SetAutoTuning(
+    int max_slices,
+    embb::base::Duration<embb::base::Microseconds> const & max_latency);
+
+  /**
+   * Enables or disables fusion of linear chains, which is enabled by
+   * default. A parallel (serial) process or sink whose only input is fed by
+   * a parallel (serial) process that has no other consumers runs inline in
+   * the task of that process, unless their execution policies differ. This
+   * saves one task per token and edge.
+   * \param enabled \c true to fuse linear chains, \c false to run each
+   *        process in tasks of its own.
+   */
+  void SetFusion(bool enabled);
+
+  /**
+   * Writes the execution plan of the network, one line per task that is
+   * run for each token. Each line lists the processes and sinks executed by
+   * the task, numbered in the order they were added to the network.
+   * Switches and selects run inline and are not listed.
+   * \param os Stream to write the plan to.
+   */
+  void PrintPlan(std::ostream & os);
+
+  /**
+   * Output formats of PrintProfile().
+   */
+  enum ProfileFormat {
+    PROFILE_CSV,  /**< One comma-separated line per node, with header */
+    PROFILE_JSON  /**< JSON object with nodes, critical path and bottleneck */
+  };
+
+  /**
+   * Enables or disables profiling, which is disabled by default. While
+   * enabled, each run of the network collects per-node counters: the
+   * number of invocations and of blank tokens, the execution time, and the
+   * queueing delay between the inputs of a token being available and its
+   * processing being started. Execution times exclude processes run inline
+   * by a node, such as fused consumers.
+   * \param enabled \c true to collect a profile in the following runs.
    */
-  Network() {}
+  void SetProfiling(bool enabled);
+
+  /**
+   * Writes the profile of the last run. For each source, process, and sink,
+   * numbered in the order they were added to the network, it lists the
+   * counters and the 50th, 90th, and 99th percentiles of the execution
+   * time, which are accurate to a factor of two. It further identifies
+   * - the critical path, the path from a source to a sink with the largest
+   *   sum of mean execution times, which bounds the latency of a token
+   *   regardless of the number of cores, and
+   * - the bottleneck, the node with the largest execution time per core it
+   *   can use, which bounds the throughput. Parallel processes, switches
+   *   and selects can use all cores, the others a single one.
+   * \param os Stream to write the profile to.
+   * \param format Output format.
+   */
+  void PrintProfile(std::ostream & os, ProfileFormat format = PROFILE_CSV);
 
   /**
    * Input port class.
@@ -199,8 +297,12 @@ class Network {
     /**
      * Constructs a SerialProcess with a user specified processing function.
      * \param function The Function to call to process a token.
+     * \param policy Priority and affinity of the tasks processing tokens.
      */
-    explicit SerialProcess(FunctionType function);
+    explicit SerialProcess(
+      FunctionType function,
+      embb::mtapi::ExecutionPolicy const & policy =
+        embb::mtapi::ExecutionPolicy());
 
     /**
      * \returns \c true if the SerialProcess has any inputs, \c false
@@ -287,8 +389,12 @@ class Network {
     /**
     * Constructs a ParallelProcess with a user specified processing function.
     * \param function The Function to call to process a token.
+    * \param policy Priority and affinity of the tasks processing tokens.
     */
-    explicit ParallelProcess(FunctionType function);
+    explicit ParallelProcess(
+      FunctionType function,
+      embb::mtapi::ExecutionPolicy const & policy =
+        embb::mtapi::ExecutionPolicy());
 
     /**
     * \returns \c true if the ParallelProcess has any inputs, \c false
@@ -348,6 +454,10 @@ class Network {
    * is sent. If input port 0 is set to true the value goes to output port 0
    * and to output port 1 otherwise.
    * Tokens are processed as soon as all inputs for that token are complete.
+   * The other output port receives an empty token. Processes and sinks
+   * receiving an empty token do not call their function and pass it on
+   * right away in the calling thread, so inactive branches do not cost any
+   * tasks.
    *
    * \see Select
    *
@@ -531,8 +641,12 @@ class Network {
     /**
      * Constructs a Sink with a user specified processing function.
      * \param function The Function to call to process a token.
+     * \param policy Priority and affinity of the tasks processing tokens.
      */
-    explicit Sink(FunctionType function);
+    explicit Sink(
+      FunctionType function,
+      embb::mtapi::ExecutionPolicy const & policy =
+        embb::mtapi::ExecutionPolicy());
 
     /**
      * \returns Always \c true.
@@ -697,9 +811,113 @@ class Network {
   void Add(ConstantSource<Type> & source);
 
   /**
-   * Executes the network until one of the the sources returns \c false.
+   * External source process template.
+   *
+   * An external source has one output port and emits the values pushed into
+   * it from arbitrary threads, one per token. The values are buffered in a
+   * bounded lock-free queue. When all slices are in flight, the network
+   * stops taking values from the queue, so the queue fills up and pushers
+   * are held back.
+   *
+   * \tparam Type The type of output port 0.
+   */
+  template<typename Type>
+  class ExternalSource {
+   public:
+    /**
+     * Output port type list.
+     */
+    typedef Outputs<OUTPUT_TYPE_LIST> OutputsType;
+
+    /**
+     * Constructs an ExternalSource buffering up to \c capacity values.
+     * \param capacity Number of values that can be pushed ahead of the
+     *        network, rounded up to the next power of two.
+     */
+    explicit ExternalSource(unsigned int capacity);
+
+    /**
+     * Pushes a value to be emitted, unless the queue is full.
+     * \threadsafe
+     * \returns \c true if the value was pushed, \c false if the queue is
+     *          full or the source is closed.
+     */
+    bool TryPush(Type const & value);
+
+    /**
+     * Pushes a value to be emitted, waiting while the queue is full.
+     * \threadsafe
+     * \returns \c true if the value was pushed, \c false if the source is
+     *          closed.
+     */
+    bool Push(Type const & value);
+
+    /**
+     * Ends the stream. Values pushed before are still emitted, then the
+     * network runs out of tokens as if a source had returned \c false.
+     * Values pushed concurrently with Close() may be discarded.
+     * \threadsafe
+     */
+    void Close();
+
+    /**
+     * \returns \c true if Close() has been called.
+     */
+    bool IsClosed() const;
+
+    /**
+     * \returns Always \c false.
+     */
+    virtual bool HasInputs() const;
+
+    /**
+     * \returns Always \c true.
+     */
+    virtual bool HasOutputs() const;
+
+    /**
+     * \returns Reference to a list of all output ports.
+     */
+    OutputsType & GetOutputs();
+
+    /**
+     * \returns Output port at Index.
+     */
+    template <int Index>
+    typename OutputsType::Types<Index>::Result & GetOutput();
+
+    /**
+     * Connects output port 0 to input port 0 of \c target.
+     * \param target Process to connect to.
+     * \tparam T Type of target process.
+     */
+    template <typename T>
+    void operator >> (T & target);
+  };
+
+  /**
+   * Adds a new external source process to the network.
+   * \param source The external source process to add.
+   */
+  template<typename Type>
+  void Add(ExternalSource<Type> & source);
+
+  /**
+   * Executes the network until one of the the sources returns \c false or
+   * is closed, or until Stop() is called. With external sources only, the
+   * network keeps running until they are closed or the network is stopped.
+   * Tokens already in flight are completed before returning. External
+   * sources wait for values on the calling thread.
    */
   void operator () ();
+
+  /**
+   * Stops a running network. No further tokens are emitted. External
+   * sources are not closed, values still queued in them are emitted when
+   * the network is run again.
+   * \threadsafe
+   */
+  void Stop();
 };
 
 #else
@@ -707,14 +925,81 @@ class Network {
 template <int Slices>
 class Network : public internal::ClockListener {
  public:
-  Network() {}
+  Network()
+    : slices_(Slices), max_slices_(Slices), max_latency_(0), fusion_(true),
+      stop_(false), profiling_(false), cores_(1) {}
+
+  explicit Network(int slices)
+    : max_latency_(0), fusion_(true), stop_(false), profiling_(false),
+      cores_(1) {
+    SetSlices(slices);
+  }
+
+  void SetSlices(int slices) {
+    if (slices < 1)
+      EMBB_THROW(embb::base::ErrorException,
+        "Number of slices must be positive.")
+    slices_ = slices;
+    max_slices_ = slices;
+  }
+
+  int GetSlices() const {
+    return slices_;
+  }
+
+  void SetAutoTuning(
+    int max_slices,
+    embb::base::Duration<embb::base::Microseconds> const & max_latency) {
+    if (max_slices < slices_)
+      EMBB_THROW(embb::base::ErrorException,
+        "Maximum number of slices is below the current number of slices.")
+    max_slices_ = max_slices;
+    max_latency_ = max_latency.Count();
+  }
+
+  void SetFusion(bool enabled) {
+    fusion_ = enabled;
+  }
+
+  void PrintPlan(std::ostream & os) {
+    Compile();
+    PrintTasks(os, processes_);
+    PrintTasks(os, sinks_);
+  }
+
+  enum ProfileFormat {
+    PROFILE_CSV,
+    PROFILE_JSON
+  };
+
+  void SetProfiling(bool enabled) {
+    profiling_ = enabled;
+  }
+
+  void PrintProfile(std::ostream & os, ProfileFormat format = PROFILE_CSV) {
+    std::vector<internal::Node*> nodes;
+    nodes.insert(nodes.end(), sources_.begin(), sources_.end());
+    nodes.insert(nodes.end(), processes_.begin(), processes_.end());
+    nodes.insert(nodes.end(), sinks_.begin(), sinks_.end());
+    std::vector<bool> critical(nodes.size(), false);
+    std::vector<internal::Node*> path;
+    GetCriticalPath(nodes, path);
+    for (size_t it = 0; it < path.size(); it++)
+      critical[IndexOf(nodes, path[it])] = true;
+    internal::Node * bottleneck = GetBottleneck(nodes);
+    if (format == PROFILE_JSON) {
+      PrintProfileJson(os, nodes, critical, path, bottleneck);
+    } else {
+      PrintProfileCsv(os, nodes, critical, bottleneck);
+    }
+  }
 
   template <typename T1, typename T2 = embb::base::internal::Nil,
     typename T3 = embb::base::internal::Nil,
     typename T4 = embb::base::internal::Nil,
     typename T5 = embb::base::internal::Nil>
   struct Inputs {
-    typedef internal::Inputs<Slices, T1, T2, T3, T4, T5> Type;
+    typedef internal::Inputs<T1, T2, T3, T4, T5> Type;
   };
 
   template <typename T1, typename T2 = embb::base::internal::Nil,
@@ -722,7 +1007,7 @@ class Network : public internal::ClockListener {
     typename T4 = embb::base::internal::Nil,
     typename T5 = embb::base::internal::Nil>
   struct Outputs {
-    typedef internal::Outputs<Slices, T1, T2, T3, T4, T5> Type;
+    typedef internal::Outputs<T1, T2, T3, T4, T5> Type;
   };
 
   template <class Inputs, class Outputs> class SerialProcess;
@@ -730,20 +1015,23 @@ class Network : public internal::ClockListener {
   template <
     typename I1, typename I2, typename I3, typename I4, typename I5,
     typename O1, typename O2, typename O3, typename O4, typename O5>
-  class SerialProcess< internal::Inputs<Slices, I1, I2, I3, I4, I5>,
-    internal::Outputs<Slices, O1, O2, O3, O4, O5> >
-    : public internal::Process< Slices, true,
-        internal::Inputs<Slices, I1, I2, I3, I4, I5>,
-        internal::Outputs<Slices, O1, O2, O3, O4, O5> > {
+  class SerialProcess< internal::Inputs<I1, I2, I3, I4, I5>,
+    internal::Outputs<O1, O2, O3, O4, O5> >
+    : public internal::Process< true,
+        internal::Inputs<I1, I2, I3, I4, I5>,
+        internal::Outputs<O1, O2, O3, O4, O5> > {
    public:
-    typedef typename internal::Process< Slices, true,
-      internal::Inputs<Slices, I1, I2, I3, I4, I5>,
-      internal::Outputs<Slices, O1, O2, O3, O4, O5> >::FunctionType
+    typedef typename internal::Process< true,
+      internal::Inputs<I1, I2, I3, I4, I5>,
+      internal::Outputs<O1, O2, O3, O4, O5> >::FunctionType
         FunctionType;
-    explicit SerialProcess(FunctionType function)
-      : internal::Process< Slices, true,
-          internal::Inputs<Slices, I1, I2, I3, I4, I5>,
-          internal::Outputs<Slices, O1, O2, O3, O4, O5> >(function) {
+    explicit SerialProcess(
+      FunctionType function,
+      embb::mtapi::ExecutionPolicy const & policy =
+        embb::mtapi::ExecutionPolicy())
+      : internal::Process< true,
+          internal::Inputs<I1, I2, I3, I4, I5>,
+          internal::Outputs<O1, O2, O3, O4, O5> >(function, policy) {
       //empty
     }
   };
@@ -758,20 +1046,23 @@ class Network : public internal::ClockListener {
   template <
     typename I1, typename I2, typename I3, typename I4, typename I5,
     typename O1, typename O2, typename O3, typename O4, typename O5>
-  class ParallelProcess< internal::Inputs<Slices, I1, I2, I3, I4, I5>,
-    internal::Outputs<Slices, O1, O2, O3, O4, O5> >
-    : public internal::Process< Slices, false,
-        internal::Inputs<Slices, I1, I2, I3, I4, I5>,
-        internal::Outputs<Slices, O1, O2, O3, O4, O5> >{
+  class ParallelProcess< internal::Inputs<I1, I2, I3, I4, I5>,
+    internal::Outputs<O1, O2, O3, O4, O5> >
+    : public internal::Process< false,
+        internal::Inputs<I1, I2, I3, I4, I5>,
+        internal::Outputs<O1, O2, O3, O4, O5> >{
    public:
-    typedef typename internal::Process< Slices, false,
-      internal::Inputs<Slices, I1, I2, I3, I4, I5>,
-      internal::Outputs<Slices, O1, O2, O3, O4, O5> >::FunctionType
+    typedef typename internal::Process< false,
+      internal::Inputs<I1, I2, I3, I4, I5>,
+      internal::Outputs<O1, O2, O3, O4, O5> >::FunctionType
         FunctionType;
-    explicit ParallelProcess(FunctionType function)
-      : internal::Process< Slices, false,
-          internal::Inputs<Slices, I1, I2, I3, I4, I5>,
-          internal::Outputs<Slices, O1, O2, O3, O4, O5> >(function) {
+    explicit ParallelProcess(
+      FunctionType function,
+      embb::mtapi::ExecutionPolicy const & policy =
+        embb::mtapi::ExecutionPolicy())
+      : internal::Process< false,
+          internal::Inputs<I1, I2, I3, I4, I5>,
+          internal::Outputs<O1, O2, O3, O4, O5> >(function, policy) {
       //empty
     }
   };
@@ -782,7 +1073,7 @@ class Network : public internal::ClockListener {
   }
 
   template<typename Type>
-  class Switch : public internal::Switch<Slices, Type> {
+  class Switch : public internal::Switch<Type> {
    public:
   };
 
@@ -792,7 +1083,7 @@ class Network : public internal::ClockListener {
   }
 
   template<typename Type>
-  class Select : public internal::Select<Slices, Type> {
+  class Select : public internal::Select<Type> {
    public:
   };
 
@@ -805,15 +1096,18 @@ class Network : public internal::ClockListener {
     typename I3 = embb::base::internal::Nil,
     typename I4 = embb::base::internal::Nil,
     typename I5 = embb::base::internal::Nil>
-  class Sink : public internal::Sink<Slices,
-    internal::Inputs<Slices, I1, I2, I3, I4, I5> > {
+  class Sink : public internal::Sink<
+    internal::Inputs<I1, I2, I3, I4, I5> > {
    public:
-    typedef typename internal::Sink<Slices,
-      internal::Inputs<Slices, I1, I2, I3, I4, I5> >::FunctionType FunctionType;
-
-    explicit Sink(FunctionType function)
-      : internal::Sink<Slices,
-          internal::Inputs<Slices, I1, I2, I3, I4, I5> >(function) {
+    typedef typename internal::Sink<
+      internal::Inputs<I1, I2, I3, I4, I5> >::FunctionType FunctionType;
+
+    explicit Sink(
+      FunctionType function,
+      embb::mtapi::ExecutionPolicy const & policy =
+        embb::mtapi::ExecutionPolicy())
+      : internal::Sink<
+          internal::Inputs<I1, I2, I3, I4, I5> >(function, policy) {
       //empty
     }
   };
@@ -828,70 +1122,121 @@ class Network : public internal::ClockListener {
     typename O3 = embb::base::internal::Nil,
     typename O4 = embb::base::internal::Nil,
     typename O5 = embb::base::internal::Nil>
-  class Source : public internal::Source<Slices,
-    internal::Outputs<Slices, O1, O2, O3, O4, O5> > {
+  class Source : public internal::Source<
+    internal::Outputs<O1, O2, O3, O4, O5> > {
    public:
-    typedef typename internal::Source<Slices,
-      internal::Outputs<Slices, O1, O2, O3, O4, O5> >::FunctionType
+    typedef typename internal::Source<
+      internal::Outputs<O1, O2, O3, O4, O5> >::FunctionType
         FunctionType;
 
     explicit Source(FunctionType function)
-      : internal::Source<Slices,
-          internal::Outputs<Slices, O1, O2, O3, O4, O5> >(function) {
+      : internal::Source<
+          internal::Outputs<O1, O2, O3, O4, O5> >(function) {
       //empty
     }
   };
 
   template<typename O1, typename O2, typename O3, typename O4, typename O5>
   void Add(Source<O1, O2, O3, O4, O5> & source) {
+    source.SetListener(&source_count_);
     sources_.push_back(&source);
   }
 
   template<typename Type>
-  class ConstantSource : public internal::ConstantSource<Slices, Type> {
+  class ConstantSource : public internal::ConstantSource<Type> {
    public:
     explicit ConstantSource(Type value)
-      : internal::ConstantSource<Slices, Type>(value) {
+      : internal::ConstantSource<Type>(value) {
       //empty
     }
   };
 
   template<typename Type>
   void Add(ConstantSource<Type> & source) {
+    source.SetListener(&source_count_);
+    sources_.push_back(&source);
+  }
+
+  template<typename Type>
+  class ExternalSource : public internal::ExternalSource<Type> {
+   public:
+    explicit ExternalSource(unsigned int capacity)
+      : internal::ExternalSource<Type>(capacity) {
+      //empty
+    }
+  };
+
+  template<typename Type>
+  void Add(ExternalSource<Type> & source) {
+    source.SetListener(&source_count_);
     sources_.push_back(&source);
   }
 
   void operator () () {
+    stop_ = false;
+
+    // With auto-tuning, per-slot state is allocated for the largest window
+    // and only slices_ tokens are let in at a time.
+    const int capacity = max_slices_;
     internal::SchedulerSequential sched_seq;
-    internal::SchedulerMTAPI<Slices> sched_mtapi;
+    internal::SchedulerMTAPI sched_mtapi(capacity);
     internal::Scheduler * sched = &sched_mtapi;
 
-    for (size_t it = 0; it < sources_.size(); it++)
+    cores_ = static_cast<int>(
+      embb::mtapi::Node::GetInstance().GetCoreCount());
+
+    for (size_t it = 0; it < sources_.size(); it++) {
       sources_[it]->SetScheduler(sched);
-    for (size_t it = 0; it < processes_.size(); it++)
+      sources_[it]->SetProfiling(profiling_);
+      sources_[it]->SetSlices(capacity);
+    }
+    for (size_t it = 0; it < processes_.size(); it++) {
       processes_[it]->SetScheduler(sched);
-    for (size_t it = 0; it < sinks_.size(); it++)
+      processes_[it]->SetProfiling(profiling_);
+      processes_[it]->SetSlices(capacity);
+    }
+    for (size_t it = 0; it < sinks_.size(); it++) {
       sinks_[it]->SetScheduler(sched);
+      sinks_[it]->SetProfiling(profiling_);
+      sinks_[it]->SetSlices(capacity);
+    }
+
+    Compile();
+    PartitionSources();
 
-    for (int ii = 0; ii < Slices; ii++) sink_count_[ii] = 0;
+    sink_count_.SetSlices(capacity);
+    source_count_.SetSlices(capacity);
+    tuning_ = max_slices_ > slices_;
+    spawn_time_.Resize(tuning_ ? capacity : 0);
+    StartTuningPeriod(0);
+    best_throughput_ = 0.0;
+#if EMBB_DATAFLOW_TRACE_SIGNAL_HISTORY
+    spawn_history_.assign(capacity, std::vector<int>());
+#endif
 
     int clock = 0;
-    while (clock >= 0) {
-      const int idx = clock % Slices;
-      while (sink_count_[idx] > 0) embb::base::Thread::CurrentYield();
-      sched->WaitForSlice(idx);
-      if (!SpawnClock(clock))
-        break;
+    int done = 0;
+    while (clock >= 0 && !stop_) {
+      // Keep at most slices_ tokens in flight. As slices_ never exceeds the
+      // capacity, this also frees the slot of clock - capacity.
+      for (; done <= clock - slices_; done++)
+        WaitForClock(sched, done);
+      const bool more = SpawnClock(clock);
       clock++;
+      if (!more)
+        break;
+      if (tuning_ && clock - tuning_clock_ >= TUNING_PERIOD * slices_)
+        Tune(clock);
     }
 
-    int ii = clock - Slices + 1;
-    if (ii < 0) ii = 0;
-    for (; ii < clock; ii++) {
-      const int idx = ii % Slices;
-      while (sink_count_[idx] > 0) embb::base::Thread::CurrentYield();
-      sched->WaitForSlice(idx);
-    }
+    for (; done < clock; done++)
+      WaitForClock(sched, done);
+  }
+
+  void Stop() {
+    stop_ = true;
+    for (size_t it = 0; it < sources_.size(); it++)
+      sources_[it]->Stop();
   }
 
   /**
@@ -901,34 +1246,347 @@ class Network : public internal::ClockListener {
    * corresponding slot, thus allowing a new token to be emitted.
    */
   virtual void OnClock(int clock) {
-    const int idx = clock % Slices;
-    const int cnt = --sink_count_[idx];
-    if (cnt < 0)
-      EMBB_THROW(embb::base::ErrorException,
-        "More sinks than expected signaled reception of given clock.")
+    const int cnt = sink_count_.CountDown(clock);
+    if (cnt == 0 && spawn_time_.GetSize() > 0) {
+      // Record the largest latency in microseconds for Tune()
+      unsigned int latency =
+        static_cast<unsigned int>((Now() - spawn_time_[clock]) / 1000);
+      unsigned int max = max_latency_seen_;
+      while (latency > max &&
+        !max_latency_seen_.CompareAndSwap(max, latency)) {}
+    }
   }
 
  private:
+  /**
+   * Number of tokens per slice over which the throughput is measured when
+   * auto-tuning.
+   */
+  static const int TUNING_PERIOD = 8;
+
   std::vector<internal::Node*> processes_;
   std::vector<internal::Node*> sources_;
+  std::vector<internal::Node*> spawned_sources_;
+  std::vector<internal::Node*> inline_sources_;
   std::vector<internal::Node*> sinks_;
-  embb::base::Atomic<int> sink_count_[Slices];
+  internal::ClockCountdown sink_count_;
+  internal::ClockCountdown source_count_;
+  int slices_;
+  int max_slices_;
+  unsigned long long max_latency_;
+  bool fusion_;
+  embb::base::Atomic<bool> stop_;
+  bool profiling_;
+  int cores_;
+  bool tuning_;
+  int tuning_clock_;
+  unsigned long long tuning_time_;
+  double best_throughput_;
+  internal::SlotArray<unsigned long long> spawn_time_;
+  embb::base::Atomic<unsigned int> max_latency_seen_;
 #if EMBB_DATAFLOW_TRACE_SIGNAL_HISTORY
-  std::vector<int> spawn_history_[Slices];
+  std::vector< std::vector<int> > spawn_history_;
 #endif
 
   bool SpawnClock(int clock) {
-    const int idx = clock % Slices;
     bool result = true;
 #if EMBB_DATAFLOW_TRACE_SIGNAL_HISTORY
-    spawn_history_[idx].push_back(clock);
+    spawn_history_[clock % max_slices_].push_back(clock);
 #endif
-    sink_count_[idx] = static_cast<int>(sinks_.size());
+    sink_count_.Set(clock, static_cast<int>(sinks_.size()));
+    source_count_.Set(clock, static_cast<int>(sources_.size()));
+    if (spawn_time_.GetSize() > 0) {
+      spawn_time_[clock] = Now();
+    }
+    // Sources run concurrently with each other and with the tokens still in
+    // flight. The next clock is only started when all sources are done, so
+    // each source produces its tokens in order.
+    for (size_t kk = 0; kk < spawned_sources_.size(); kk++) {
+      spawned_sources_[kk]->Start(clock);
+    }
+    for (size_t kk = 0; kk < inline_sources_.size(); kk++) {
+      inline_sources_[kk]->Run(clock);
+    }
+    source_count_.Wait(clock);
     for (size_t kk = 0; kk < sources_.size(); kk++) {
-      result &= sources_[kk]->Start(clock);
+      result &= !sources_[kk]->IsDone();
     }
     return result;
   }
+
+  /**
+   * Sources that may block run on the calling thread, otherwise they could
+   * hold all workers while the tokens they wait for depend on them. If no
+   * source blocks, the calling thread runs the first source itself instead
+   * of idling.
+   */
+  void PartitionSources() {
+    spawned_sources_.clear();
+    inline_sources_.clear();
+    for (size_t it = 0; it < sources_.size(); it++) {
+      if (sources_[it]->MayBlock()) {
+        inline_sources_.push_back(sources_[it]);
+      } else {
+        spawned_sources_.push_back(sources_[it]);
+      }
+    }
+    if (inline_sources_.empty() && !spawned_sources_.empty()) {
+      inline_sources_.push_back(spawned_sources_.front());
+      spawned_sources_.erase(spawned_sources_.begin());
+    }
+  }
+
+  void WaitForClock(internal::Scheduler * sched, int clock) {
+    sink_count_.Wait(clock);
+    sched->WaitForSlice(clock % max_slices_);
+  }
+
+  void StartTuningPeriod(int clock) {
+    tuning_clock_ = clock;
+    tuning_time_ = Now();
+    max_latency_seen_ = 0;
+  }
+
+  /**
+   * Grows the window by one slice while the throughput of the last period
+   * improved and the latency bound was kept. Shrinks it and stops tuning
+   * once the latency bound was exceeded, and stops at the previous window
+   * once the throughput did not improve any further.
+   */
+  void Tune(int clock) {
+    const unsigned long long now = Now();
+    const double throughput = static_cast<double>(clock - tuning_clock_) /
+      static_cast<double>(now - tuning_time_ + 1);
+    if (max_latency_seen_ > max_latency_) {
+      if (slices_ > 1) slices_--;
+      tuning_ = false;
+    } else if (throughput > best_throughput_) {
+      best_throughput_ = throughput;
+      if (slices_ < max_slices_) {
+        slices_++;
+      } else {
+        tuning_ = false;
+      }
+    } else {
+      slices_--;
+      tuning_ = false;
+    }
+    StartTuningPeriod(clock);
+  }
+
+  /**
+   * Determines the linear chains to fuse, see internal::Node::OfferFusion().
+   */
+  void Compile() {
+    for (size_t it = 0; it < processes_.size(); it++)
+      processes_[it]->ResetFusion();
+    for (size_t it = 0; it < sinks_.size(); it++)
+      sinks_[it]->ResetFusion();
+    if (!fusion_)
+      return;
+    for (size_t it = 0; it < processes_.size(); it++)
+      processes_[it]->OfferFusion();
+    for (size_t it = 0; it < processes_.size(); it++)
+      processes_[it]->AcceptFusion();
+    for (size_t it = 0; it < sinks_.size(); it++)
+      sinks_[it]->AcceptFusion();
+  }
+
+  void PrintTasks(std::ostream & os, std::vector<internal::Node*> & nodes) {
+    for (size_t it = 0; it < nodes.size(); it++) {
+      internal::Node * node = nodes[it];
+      if (node->GetExecutionMode() == internal::Node::EXECUTE_INLINE ||
+        node->GetFusedProducer() != NULL)
+        continue;
+      PrintNode(os, node);
+      for (node = node->GetFusedConsumer(); node != NULL;
+        node = node->GetFusedConsumer()) {
+        os << " -> ";
+        PrintNode(os, node);
+      }
+      os << std::endl;
+    }
+  }
+
+  void PrintNode(std::ostream & os, internal::Node * node) {
+    PrintName(os, node);
+    os << ((node->GetExecutionMode() == internal::Node::EXECUTE_SERIAL) ?
+      " (serial)" : " (parallel)");
+  }
+
+  void PrintName(std::ostream & os, internal::Node * node) {
+    for (size_t it = 0; it < sources_.size(); it++) {
+      if (sources_[it] == node)
+        os << "source " << it;
+    }
+    for (size_t it = 0; it < processes_.size(); it++) {
+      if (processes_[it] == node)
+        os << "process " << it;
+    }
+    for (size_t it = 0; it < sinks_.size(); it++) {
+      if (sinks_[it] == node)
+        os << "sink " << it;
+    }
+  }
+
+  const char * GetModeName(internal::Node * node) {
+    if (!node->HasInputs())
+      return "source";
+    switch (node->GetExecutionMode()) {
+    case internal::Node::EXECUTE_SERIAL:
+      return "serial";
+    case internal::Node::EXECUTE_PARALLEL:
+      return "parallel";
+    default:
+      return "inline";
+    }
+  }
+
+  static int IndexOf(
+    std::vector<internal::Node*> const & nodes, internal::Node * node) {
+    for (size_t it = 0; it < nodes.size(); it++) {
+      if (nodes[it] == node)
+        return static_cast<int>(it);
+    }
+    return -1;
+  }
+
+  /**
+   * Finds the path from a source to a sink with the largest sum of mean
+   * execution times per token. Queueing delays are left out, as they depend
+   * on the load of the workers rather than on the dependencies of a token.
+   */
+  void GetCriticalPath(
+    std::vector<internal::Node*> const & nodes,
+    std::vector<internal::Node*> & path) {
+    std::vector<unsigned long long> length(nodes.size(), 0);
+    std::vector<int> next(nodes.size(), -1);
+    std::vector<int> state(nodes.size(), 0);
+    int first = -1;
+    for (size_t it = 0; it < sources_.size(); it++) {
+      const int idx = IndexOf(nodes, sources_[it]);
+      GetPathLength(nodes, idx, length, next, state);
+      if (first < 0 || length[idx] > length[first])
+        first = idx;
+    }
+    for (int idx = first; idx >= 0; idx = next[idx])
+      path.push_back(nodes[idx]);
+  }
+
+  /**
+   * Computes the length of the longest path from \c idx to a sink by depth
+   * first search, remembering the successor on that path in \c next.
+   */
+  unsigned long long GetPathLength(
+    std::vector<internal::Node*> const & nodes, int idx,
+    std::vector<unsigned long long> & length, std::vector<int> & next,
+    std::vector<int> & state) {
+    // 0: not visited, 1: on the current path, 2: done
+    if (state[idx] != 0)
+      return length[idx];
+    state[idx] = 1;
+    std::vector<internal::Node*> consumers;
+    nodes[idx]->GetConsumers(consumers);
+    unsigned long long longest = 0;
+    for (size_t it = 0; it < consumers.size(); it++) {
+      const int consumer = IndexOf(nodes, consumers[it]);
+      if (consumer < 0)
+        continue;
+      const unsigned long long consumer_length =
+        GetPathLength(nodes, consumer, length, next, state);
+      if (next[idx] < 0 || consumer_length > longest) {
+        longest = consumer_length;
+        next[idx] = consumer;
+      }
+    }
+    length[idx] =
+      nodes[idx]->GetProfile().GetMeanExecutionTime() + longest;
+    state[idx] = 2;
+    return length[idx];
+  }
+
+  /**
+   * Finds the node with the most execution time per worker it can use,
+   * which bounds the throughput.
+   */
+  internal::Node * GetBottleneck(std::vector<internal::Node*> const & nodes) {
+    internal::Node * bottleneck = NULL;
+    unsigned long long max_load = 0;
+    for (size_t it = 0; it < nodes.size(); it++) {
+      unsigned long long load = nodes[it]->GetProfile().GetExecutionTime();
+      if (nodes[it]->HasInputs() &&
+        nodes[it]->GetExecutionMode() != internal::Node::EXECUTE_SERIAL)
+        load /= static_cast<unsigned long long>(cores_);
+      if (load > max_load) {
+        max_load = load;
+        bottleneck = nodes[it];
+      }
+    }
+    return bottleneck;
+  }
+
+  void PrintProfileCsv(
+    std::ostream & os, std::vector<internal::Node*> const & nodes,
+    std::vector<bool> const & critical, internal::Node * bottleneck) {
+    os << "node,mode,invocations,blanks,total_ns,mean_ns,p50_ns,p90_ns,"
+      "p99_ns,mean_queueing_ns,critical_path,bottleneck" << std::endl;
+    for (size_t it = 0; it < nodes.size(); it++) {
+      internal::NodeProfile const & profile = nodes[it]->GetProfile();
+      PrintName(os, nodes[it]);
+      os << ',' << GetModeName(nodes[it]) <<
+        ',' << profile.GetInvocations() <<
+        ',' << profile.GetBlanks() <<
+        ',' << profile.GetExecutionTime() <<
+        ',' << profile.GetMeanExecutionTime() <<
+        ',' << profile.GetExecutionTimePercentile(50) <<
+        ',' << profile.GetExecutionTimePercentile(90) <<
+        ',' << profile.GetExecutionTimePercentile(99) <<
+        ',' << profile.GetMeanQueueingTime() <<
+        ',' << (critical[it] ? 1 : 0) <<
+        ',' << ((nodes[it] == bottleneck) ? 1 : 0) << std::endl;
+    }
+  }
+
+  void PrintProfileJson(
+    std::ostream & os, std::vector<internal::Node*> const & nodes,
+    std::vector<bool> const & critical,
+    std::vector<internal::Node*> const & path, internal::Node * bottleneck) {
+    os << "{" << std::endl << "  \"nodes\": [";
+    for (size_t it = 0; it < nodes.size(); it++) {
+      internal::NodeProfile const & profile = nodes[it]->GetProfile();
+      os << ((it > 0) ? "," : "") << std::endl << "    {\"node\": \"";
+      PrintName(os, nodes[it]);
+      os << "\", \"mode\": \"" << GetModeName(nodes[it]) <<
+        "\", \"invocations\": " << profile.GetInvocations() <<
+        ", \"blanks\": " << profile.GetBlanks() <<
+        ", \"total_ns\": " << profile.GetExecutionTime() <<
+        ", \"mean_ns\": " << profile.GetMeanExecutionTime() <<
+        ", \"p50_ns\": " << profile.GetExecutionTimePercentile(50) <<
+        ", \"p90_ns\": " << profile.GetExecutionTimePercentile(90) <<
+        ", \"p99_ns\": " << profile.GetExecutionTimePercentile(99) <<
+        ", \"mean_queueing_ns\": " << profile.GetMeanQueueingTime() <<
+        ", \"critical_path\": " << (critical[it] ? "true" : "false") << "}";
+    }
+    os << std::endl << "  ]," << std::endl << "  \"critical_path\": [";
+    for (size_t it = 0; it < path.size(); it++) {
+      os << ((it > 0) ? ", \"" : "\"");
+      PrintName(os, path[it]);
+      os << "\"";
+    }
+    os << "]," << std::endl << "  \"bottleneck\": ";
+    if (bottleneck != NULL) {
+      os << "\"";
+      PrintName(os, bottleneck);
+      os << "\"";
+    } else {
+      os << "null";
+    }
+    os << std::endl << "}" << std::endl;
+  }
+
+  static unsigned long long Now() {
+    return internal::NodeProfile::Now();
+  }
 };
 
 #endif // DOXYGEN
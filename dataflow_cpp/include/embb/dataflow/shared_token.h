@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_DATAFLOW_SHARED_TOKEN_H_
+#define EMBB_DATAFLOW_SHARED_TOKEN_H_
+
+#include <cstddef>
+
+#include <embb/base/atomic.h>
+#include <embb/base/exceptions.h>
+#include <embb/base/memory_allocation.h>
+
+namespace embb {
+namespace dataflow {
+
+/**
+ * Reference-counted handle to an immutable token value.
+ *
+ * Tokens sent to several inputs are copied once per input. Using a
+ * SharedToken as port type lets all consumers share one value instead, as
+ * copying the handle only increments a reference count. The value is
+ * produced in place via Emplace() and must not be modified after the token
+ * has been sent.
+ *
+ * \tparam Type Type of the shared value
+ * \ingroup CPP_DATAFLOW
+ */
+template <typename Type>
+class SharedToken {
+ public:
+  /**
+   * Creates an empty token.
+   *
+   * \waitfree
+   */
+  SharedToken() : block_(NULL) {}
+
+  /**
+   * Creates a token holding a copy of \c value.
+   *
+   * \memory Allocates the shared value and its reference count
+   * \notthreadsafe
+   */
+  explicit SharedToken(
+    Type const & value
+    /**< [IN] Value to share */
+    ) : block_(NULL) {
+    Emplace() = value;
+  }
+
+  /**
+   * Creates a token sharing the value of \c other.
+   *
+   * \waitfree
+   */
+  SharedToken(
+    SharedToken const & other
+    /**< [IN] Token to share the value with */
+    ) : block_(other.block_) {
+    if (block_ != NULL) {
+      ++block_->references;
+    }
+  }
+
+  /**
+   * Releases the shared value, deleting it if this was the last reference.
+   */
+  ~SharedToken() {
+    Release();
+  }
+
+  /**
+   * Releases the current value and shares the value of \c other.
+   *
+   * \return Reference to this token
+   * \waitfree
+   */
+  SharedToken & operator = (
+    SharedToken const & other
+    /**< [IN] Token to share the value with */
+    ) {
+    if (other.block_ != NULL) {
+      ++other.block_->references;
+    }
+    Release();
+    block_ = other.block_;
+    return *this;
+  }
+
+  /**
+   * Replaces the value by a new, default-constructed one that is not
+   * shared yet.
+   *
+   * \return Reference to the new value, to be filled in place
+   * \memory Allocates the shared value and its reference count
+   * \notthreadsafe
+   */
+  Type & Emplace() {
+    Release();
+    block_ = embb::base::Allocation::New<Block>();
+    return block_->value;
+  }
+
+  /**
+   * Checks whether the token holds a value.
+   *
+   * \return \c true if no value is held, otherwise \c false
+   * \waitfree
+   */
+  bool IsEmpty() const {
+    return block_ == NULL;
+  }
+
+  /**
+   * Returns the number of tokens sharing the value.
+   *
+   * \return Number of references, or 0 if the token is empty
+   * \waitfree
+   */
+  int GetReferenceCount() const {
+    return (block_ == NULL) ? 0 : block_->references.Load();
+  }
+
+  /**
+   * Returns the shared value.
+   *
+   * \return Reference to the shared value
+   * \throws embb::base::ErrorException if the token is empty
+   * \waitfree
+   */
+  Type const & GetValue() const {
+    if (block_ == NULL)
+      EMBB_THROW(embb::base::ErrorException,
+        "Token is empty, cannot get a value.")
+    return block_->value;
+  }
+
+  /**
+   * Returns the shared value.
+   *
+   * \return Reference to the shared value
+   * \throws embb::base::ErrorException if the token is empty
+   * \waitfree
+   */
+  Type const & operator * () const {
+    return GetValue();
+  }
+
+  /**
+   * Returns the shared value.
+   *
+   * \return Pointer to the shared value
+   * \throws embb::base::ErrorException if the token is empty
+   * \waitfree
+   */
+  Type const * operator -> () const {
+    return &GetValue();
+  }
+
+ private:
+  struct Block {
+    Block() : references(1), value() {}
+
+    embb::base::Atomic<int> references;
+    Type value;
+  };
+
+  void Release() {
+    if (block_ != NULL && --block_->references == 0) {
+      embb::base::Allocation::Delete(block_);
+    }
+    block_ = NULL;
+  }
+
+  Block * block_;
+};
+
+} // namespace dataflow
+} // namespace embb
+
+#endif // EMBB_DATAFLOW_SHARED_TOKEN_H_
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dataflow_cpp_test_batch.h>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/function.h>
+#include <embb/base/c/memory_allocation.h>
+
+#include <embb/dataflow/dataflow.h>
+
+#define BATCH_TOKEN_COUNT 100
+#define BATCH_SIZE 8
+
+namespace {
+
+typedef embb::dataflow::Batch<int> IntBatch;
+typedef embb::dataflow::Network<4> BatchNetwork;
+typedef BatchNetwork::Source<IntBatch> BatchSourceNode;
+typedef BatchNetwork::ParallelProcess< BatchNetwork::Inputs<IntBatch>::Type,
+  BatchNetwork::Outputs<IntBatch>::Type > BatchProcessNode;
+typedef BatchNetwork::Sink<IntBatch> BatchSinkNode;
+
+int batch_next;
+int batch_received[BATCH_TOKEN_COUNT];
+int batch_count;
+int batch_clocks;
+
+bool BatchSourceFunc(int & out) {
+  out = batch_next++;
+  return batch_next < BATCH_TOKEN_COUNT;
+}
+
+void BatchAddOne(int const & in, int & out) {
+  out = in + 1;
+}
+
+// Works on the whole span at once
+void BatchSquare(IntBatch const & in, IntBatch & out) {
+  out.Resize(in.GetSize());
+  int const * src = in.GetData();
+  int * dst = out.GetData();
+  for (size_t ii = 0; ii < in.GetSize(); ii++) {
+    dst[ii] = src[ii] * src[ii];
+  }
+}
+
+void BatchSinkFunc(int const & in) {
+  batch_received[batch_count++] = in;
+}
+
+void BatchCountClocks(IntBatch const & in) {
+  if (!in.IsEmpty()) {
+    batch_clocks++;
+  }
+}
+
+} // namespace
+
+BatchTest::BatchTest() {
+  CreateUnit("dataflow_cpp batch test").Add(&BatchTest::TestBatches, this);
+}
+
+void BatchTest::TestBatches() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    embb::dataflow::BatchSource<int> source_adapter(
+      embb::base::MakeFunction(BatchSourceFunc), BATCH_SIZE);
+    embb::dataflow::BatchProcess<int, int> add_adapter(
+      embb::base::MakeFunction(BatchAddOne));
+    embb::dataflow::BatchSink<int> sink_adapter(
+      embb::base::MakeFunction(BatchSinkFunc));
+
+    BatchNetwork network;
+    BatchSourceNode source(embb::base::MakeFunction(
+      source_adapter, &embb::dataflow::BatchSource<int>::Run));
+    BatchProcessNode add(embb::base::MakeFunction(
+      add_adapter, &embb::dataflow::BatchProcess<int, int>::Run));
+    BatchProcessNode square(embb::base::MakeFunction(BatchSquare));
+    BatchSinkNode sink(embb::base::MakeFunction(
+      sink_adapter, &embb::dataflow::BatchSink<int>::Run));
+    BatchSinkNode clocks(embb::base::MakeFunction(BatchCountClocks));
+
+    batch_next = 0;
+    batch_count = 0;
+    batch_clocks = 0;
+
+    source >> add;
+    add >> square;
+    square.GetOutput<0>() >> sink.GetInput<0>();
+    source.GetOutput<0>() >> clocks.GetInput<0>();
+    network.Add(source);
+    network.Add(add);
+    network.Add(square);
+    network.Add(sink);
+    network.Add(clocks);
+    network();
+
+    PT_ASSERT_EQ(batch_count, BATCH_TOKEN_COUNT);
+    for (int ii = 0; ii < BATCH_TOKEN_COUNT; ii++) {
+      PT_EXPECT_EQ(batch_received[ii], (ii + 1) * (ii + 1));
+    }
+    // All but the last batch are full
+    PT_EXPECT_EQ(batch_clocks,
+      (BATCH_TOKEN_COUNT + BATCH_SIZE - 1) / BATCH_SIZE);
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dataflow_cpp_test_blank.h>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/function.h>
+#include <embb/base/c/memory_allocation.h>
+
+#include <embb/dataflow/dataflow.h>
+
+#define BLANK_TOKEN_COUNT 300
+
+namespace {
+
+typedef embb::dataflow::Network<4> BlankNetwork;
+typedef BlankNetwork::Source<int, bool> BlankSource;
+typedef BlankNetwork::Switch<int> BlankSwitch;
+typedef BlankNetwork::ParallelProcess< BlankNetwork::Inputs<int>::Type,
+  BlankNetwork::Outputs<int>::Type > BlankParallel;
+typedef BlankNetwork::SerialProcess< BlankNetwork::Inputs<int>::Type,
+  BlankNetwork::Outputs<int>::Type > BlankSerial;
+typedef BlankNetwork::SerialProcess< BlankNetwork::Inputs<int, int>::Type,
+  BlankNetwork::Outputs<int>::Type > BlankSerialJoin;
+typedef BlankNetwork::Sink<int> BlankSink;
+
+int blank_next;
+int blank_received[2][BLANK_TOKEN_COUNT];
+int blank_count[2];
+int blank_last_serial;
+bool blank_serial_in_order;
+bool blank_join_called;
+
+bool BlankSourceFunc(int & out, bool & pred) {
+  out = blank_next++;
+  // Two of three tokens take the first branch
+  pred = (out % 3) != 0;
+  return blank_next < BLANK_TOKEN_COUNT;
+}
+
+void BlankAddOne(int const & in, int & out) {
+  out = in + 1;
+}
+
+void BlankSubtractOne(int const & in, int & out) {
+  out = in - 1;
+}
+
+void BlankSerialCheck(int const & in, int & out) {
+  // Serial processes see their values in order, despite skipped blanks
+  if (in <= blank_last_serial)
+    blank_serial_in_order = false;
+  blank_last_serial = in;
+  out = in;
+}
+
+void BlankJoin(int const & in1, int const & in2, int & out) {
+  out = in1 + in2;
+}
+
+void BlankSinkFirst(int const & in) {
+  blank_received[0][blank_count[0]++] = in;
+}
+
+void BlankSinkSecond(int const & in) {
+  blank_received[1][blank_count[1]++] = in;
+}
+
+void BlankSinkJoin(int const & /*in*/) {
+  blank_join_called = true;
+}
+
+BlankSink * blank_inactive_sink;
+bool blank_forwarded_inline;
+
+bool BlankInactiveSourceFunc(int & out, bool & pred) {
+  out = blank_next++;
+  // All tokens take the second branch, the first one only sees blanks
+  pred = false;
+  return blank_next < BLANK_TOKEN_COUNT;
+}
+
+void BlankSinkActive(int const & in) {
+  // The switch sends the blank of a clock down the first branch before it
+  // sends the value down the second one. If the blank was forwarded in the
+  // delivering thread, it has already reached the end of the first branch.
+  if (blank_inactive_sink->GetProfile().GetBlanks() <
+    static_cast<unsigned int>(in + 1))
+    blank_forwarded_inline = false;
+}
+
+/**
+ * Runs a source that routes each token into one of two branches of
+ * parallel and serial processes. Both branches also feed a join, which
+ * thus only ever sees blanks. Returns whether each sink got its values in
+ * order and the join was never called.
+ */
+bool RunBranches(int slices, bool fusion) {
+  BlankNetwork network(slices);
+  BlankSource source(embb::base::MakeFunction(BlankSourceFunc));
+  BlankSwitch sw;
+  BlankParallel add_first(embb::base::MakeFunction(BlankAddOne));
+  BlankSerial check_first(embb::base::MakeFunction(BlankSerialCheck));
+  BlankParallel sub_first(embb::base::MakeFunction(BlankSubtractOne));
+  BlankSerial add_second(embb::base::MakeFunction(BlankAddOne));
+  BlankParallel sub_second(embb::base::MakeFunction(BlankSubtractOne));
+  BlankSerialJoin join(embb::base::MakeFunction(BlankJoin));
+  BlankSink sink_first(embb::base::MakeFunction(BlankSinkFirst));
+  BlankSink sink_second(embb::base::MakeFunction(BlankSinkSecond));
+  BlankSink sink_join(embb::base::MakeFunction(BlankSinkJoin));
+
+  blank_next = 0;
+  blank_count[0] = 0;
+  blank_count[1] = 0;
+  blank_last_serial = -1;
+  blank_serial_in_order = true;
+  blank_join_called = false;
+
+  source.GetOutput<0>() >> sw.GetInput<1>();
+  source.GetOutput<1>() >> sw.GetInput<0>();
+  sw.GetOutput<0>() >> add_first.GetInput<0>();
+  add_first >> check_first;
+  check_first >> sub_first;
+  sub_first >> sink_first;
+  sub_first.GetOutput<0>() >> join.GetInput<0>();
+  sw.GetOutput<1>() >> add_second.GetInput<0>();
+  add_second >> sub_second;
+  sub_second >> sink_second;
+  sub_second.GetOutput<0>() >> join.GetInput<1>();
+  join >> sink_join;
+
+  network.Add(source);
+  network.Add(sw);
+  network.Add(add_first);
+  network.Add(check_first);
+  network.Add(sub_first);
+  network.Add(add_second);
+  network.Add(sub_second);
+  network.Add(join);
+  network.Add(sink_first);
+  network.Add(sink_second);
+  network.Add(sink_join);
+  network.SetFusion(fusion);
+  network();
+
+  bool result = blank_serial_in_order && !blank_join_called;
+  int first = 0;
+  int second = 0;
+  for (int ii = 0; result && ii < BLANK_TOKEN_COUNT; ii++) {
+    if (ii % 3 != 0) {
+      result = first < blank_count[0] && blank_received[0][first++] == ii;
+    } else {
+      result = second < blank_count[1] && blank_received[1][second++] == ii;
+    }
+  }
+  return result && first == blank_count[0] && second == blank_count[1];
+}
+
+/**
+ * Runs a source that routes all tokens into the second of two branches,
+ * such that the first branch of parallel and serial processes only sees
+ * blanks. Returns whether each blank was forwarded to the end of the first
+ * branch by the thread delivering it, and whether all runs of the first
+ * branch were blank.
+ */
+bool RunInactiveBranch(int slices, bool fusion) {
+  BlankNetwork network(slices);
+  BlankSource source(embb::base::MakeFunction(BlankInactiveSourceFunc));
+  BlankSwitch sw;
+  BlankParallel add_inactive(embb::base::MakeFunction(BlankAddOne));
+  BlankSerial check_inactive(embb::base::MakeFunction(BlankSerialCheck));
+  BlankSink sink_inactive(embb::base::MakeFunction(BlankSinkFirst));
+  BlankSink sink_active(embb::base::MakeFunction(BlankSinkActive));
+
+  blank_next = 0;
+  blank_count[0] = 0;
+  blank_inactive_sink = &sink_inactive;
+  blank_forwarded_inline = true;
+
+  source.GetOutput<0>() >> sw.GetInput<1>();
+  source.GetOutput<1>() >> sw.GetInput<0>();
+  sw.GetOutput<0>() >> add_inactive.GetInput<0>();
+  add_inactive >> check_inactive;
+  check_inactive >> sink_inactive;
+  sw.GetOutput<1>() >> sink_active.GetInput<0>();
+
+  network.Add(source);
+  network.Add(sw);
+  network.Add(add_inactive);
+  network.Add(check_inactive);
+  network.Add(sink_inactive);
+  network.Add(sink_active);
+  network.SetFusion(fusion);
+  network.SetProfiling(true);
+  network();
+
+  const unsigned int tokens = BLANK_TOKEN_COUNT;
+  return blank_forwarded_inline && blank_count[0] == 0 &&
+    add_inactive.GetProfile().GetBlanks() == tokens &&
+    add_inactive.GetProfile().GetInvocations() == tokens &&
+    check_inactive.GetProfile().GetBlanks() == tokens &&
+    check_inactive.GetProfile().GetInvocations() == tokens &&
+    sink_inactive.GetProfile().GetBlanks() == tokens &&
+    sink_inactive.GetProfile().GetInvocations() == tokens;
+}
+
+} // namespace
+
+BlankTest::BlankTest() {
+  CreateUnit("dataflow_cpp blank short-circuit test")
+    .Add(&BlankTest::TestBranches, this);
+  CreateUnit("dataflow_cpp blank inline forwarding test")
+    .Add(&BlankTest::TestInactiveBranch, this);
+}
+
+void BlankTest::TestBranches() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  for (int slices = 1; slices <= 8; slices *= 2) {
+    PT_EXPECT(RunBranches(slices, true));
+    PT_EXPECT(RunBranches(slices, false));
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
+
+void BlankTest::TestInactiveBranch() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  for (int slices = 1; slices <= 8; slices *= 2) {
+    PT_EXPECT(RunInactiveBranch(slices, true));
+    PT_EXPECT(RunInactiveBranch(slices, false));
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dataflow_cpp_test_external.h>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/atomic.h>
+#include <embb/base/function.h>
+#include <embb/base/thread.h>
+#include <embb/base/c/memory_allocation.h>
+
+#include <embb/dataflow/dataflow.h>
+
+#define EXTERNAL_TOKEN_COUNT 1000
+
+namespace {
+
+typedef embb::dataflow::Network<4> ExternalNetwork;
+typedef ExternalNetwork::ExternalSource<int> ExternalIntSource;
+typedef ExternalNetwork::ParallelProcess< ExternalNetwork::Inputs<int>::Type,
+  ExternalNetwork::Outputs<int>::Type > ExternalSquare;
+typedef ExternalNetwork::SerialProcess<
+  ExternalNetwork::Inputs<int, int>::Type,
+  ExternalNetwork::Outputs<int>::Type > ExternalMultiply;
+typedef ExternalNetwork::Sink<int> ExternalSink;
+
+int external_received[EXTERNAL_TOKEN_COUNT];
+int external_count;
+embb::base::Atomic<int> external_completed;
+
+void ExternalSquareFunc(int const & in, int & out) {
+  out = in * in;
+}
+
+void ExternalMultiplyFunc(int const & in1, int const & in2, int & out) {
+  out = in1 * in2;
+}
+
+void ExternalSinkFunc(int const & in) {
+  if (external_count < EXTERNAL_TOKEN_COUNT) {
+    external_received[external_count] = in;
+  }
+  external_count++;
+}
+
+void ExternalCountingSinkFunc(int const & in) {
+  ExternalSinkFunc(in);
+  external_completed++;
+}
+
+/**
+ * Pushes EXTERNAL_TOKEN_COUNT values into a source from a separate thread,
+ * then either closes the source or stops the network.
+ */
+class Pusher {
+ public:
+  Pusher(ExternalIntSource & source, ExternalNetwork * network)
+    : source_(source), network_(network) {}
+
+  void operator()() {
+    for (int ii = 0; ii < EXTERNAL_TOKEN_COUNT; ii++) {
+      if (!source_.Push(ii))
+        break;
+    }
+    if (network_ != NULL) {
+      network_->Stop();
+    } else {
+      source_.Close();
+    }
+  }
+
+ private:
+  ExternalIntSource & source_;
+  ExternalNetwork * network_;
+};
+
+/**
+ * Pushes one value into each of two sources and waits until the network
+ * has delivered their product before pushing the next ones.
+ */
+class LockstepPusher {
+ public:
+  LockstepPusher(ExternalIntSource & source1, ExternalIntSource & source2)
+    : source1_(source1), source2_(source2) {}
+
+  void operator()() {
+    for (int ii = 0; ii < EXTERNAL_TOKEN_COUNT; ii++) {
+      source1_.Push(ii);
+      source2_.Push(ii);
+      while (external_completed.Load() <= ii) {
+        embb::base::Thread::CurrentYield();
+      }
+    }
+    source1_.Close();
+    source2_.Close();
+  }
+
+ private:
+  ExternalIntSource & source1_;
+  ExternalIntSource & source2_;
+};
+
+/**
+ * Checks that the sink received the squares of a prefix of the pushed
+ * values in order.
+ */
+bool ReceivedInOrder() {
+  bool result = external_count <= EXTERNAL_TOKEN_COUNT;
+  for (int ii = 0; result && ii < external_count; ii++) {
+    result = external_received[ii] == ii * ii;
+  }
+  return result;
+}
+
+} // namespace
+
+ExternalTest::ExternalTest() {
+  CreateUnit("dataflow_cpp external source push test")
+    .Add(&ExternalTest::TestPush, this);
+  CreateUnit("dataflow_cpp external source backpressure test")
+    .Add(&ExternalTest::TestBackpressure, this);
+  CreateUnit("dataflow_cpp network stop test")
+    .Add(&ExternalTest::TestStop, this);
+  CreateUnit("dataflow_cpp two external sources test")
+    .Add(&ExternalTest::TestTwoSources, this);
+}
+
+void ExternalTest::TestPush() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    ExternalNetwork network;
+    ExternalIntSource source(4);
+    ExternalSquare square(embb::base::MakeFunction(ExternalSquareFunc));
+    ExternalSink sink(embb::base::MakeFunction(ExternalSinkFunc));
+    external_count = 0;
+
+    source >> square;
+    square >> sink;
+    network.Add(source);
+    network.Add(square);
+    network.Add(sink);
+
+    Pusher pusher(source, NULL);
+    embb::base::Thread thread(pusher);
+    network();
+    thread.Join();
+
+    PT_EXPECT_EQ(external_count, EXTERNAL_TOKEN_COUNT);
+    PT_EXPECT(ReceivedInOrder());
+    PT_EXPECT(source.IsClosed());
+    PT_EXPECT(!source.Push(0));
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
+
+void ExternalTest::TestBackpressure() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    ExternalNetwork network;
+    ExternalIntSource source(8);
+    ExternalSink sink(embb::base::MakeFunction(ExternalSinkFunc));
+    external_count = 0;
+
+    source >> sink;
+    network.Add(source);
+    network.Add(sink);
+
+    // Nothing is consumed before the network runs, so pushing must be
+    // refused eventually
+    int pushed = 0;
+    while (pushed < EXTERNAL_TOKEN_COUNT && source.TryPush(pushed)) {
+      pushed++;
+    }
+    PT_EXPECT_EQ(pushed, 8);
+
+    // Values pushed before closing are still delivered
+    source.Close();
+    PT_EXPECT(!source.TryPush(0));
+    network();
+
+    PT_EXPECT_EQ(external_count, pushed);
+    for (int ii = 0; ii < pushed && ii < external_count; ii++) {
+      PT_EXPECT_EQ(external_received[ii], ii);
+    }
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
+
+void ExternalTest::TestStop() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    ExternalNetwork network;
+    ExternalIntSource source(4);
+    ExternalSquare square(embb::base::MakeFunction(ExternalSquareFunc));
+    ExternalSink sink(embb::base::MakeFunction(ExternalSinkFunc));
+    external_count = 0;
+
+    source >> square;
+    square >> sink;
+    network.Add(source);
+    network.Add(square);
+    network.Add(sink);
+
+    Pusher pusher(source, &network);
+    embb::base::Thread thread(pusher);
+    network();
+    thread.Join();
+
+    PT_EXPECT(ReceivedInOrder());
+
+    // Stopping does not close the source, values still queued are emitted
+    // by the next run
+    PT_EXPECT(!source.IsClosed());
+    source.Close();
+    network();
+
+    PT_EXPECT_EQ(external_count, EXTERNAL_TOKEN_COUNT);
+    PT_EXPECT(ReceivedInOrder());
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
+
+void ExternalTest::TestTwoSources() {
+  // A single worker must not be held by a source waiting for values, as
+  // the pusher only continues once the previous token has been processed
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    ExternalNetwork network;
+    ExternalIntSource source1(4);
+    ExternalIntSource source2(4);
+    ExternalMultiply multiply(embb::base::MakeFunction(ExternalMultiplyFunc));
+    ExternalSink sink(embb::base::MakeFunction(ExternalCountingSinkFunc));
+    external_count = 0;
+    external_completed = 0;
+
+    source1.GetOutput<0>() >> multiply.GetInput<0>();
+    source2.GetOutput<0>() >> multiply.GetInput<1>();
+    multiply >> sink;
+    network.Add(source1);
+    network.Add(source2);
+    network.Add(multiply);
+    network.Add(sink);
+
+    LockstepPusher pusher(source1, source2);
+    embb::base::Thread thread(pusher);
+    network();
+    thread.Join();
+
+    PT_EXPECT_EQ(external_count, EXTERNAL_TOKEN_COUNT);
+    PT_EXPECT(ReceivedInOrder());
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
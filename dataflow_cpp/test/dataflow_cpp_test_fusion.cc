@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dataflow_cpp_test_fusion.h>
+
+#include <sstream>
+#include <string>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/function.h>
+#include <embb/base/c/memory_allocation.h>
+
+#include <embb/dataflow/dataflow.h>
+
+#define FUSION_TOKEN_COUNT 100
+
+namespace {
+
+typedef embb::dataflow::Network<4> FusionNetwork;
+typedef FusionNetwork::Source<int> FusionSource;
+typedef FusionNetwork::ParallelProcess< FusionNetwork::Inputs<int>::Type,
+  FusionNetwork::Outputs<int>::Type > FusionParallel;
+typedef FusionNetwork::SerialProcess< FusionNetwork::Inputs<int>::Type,
+  FusionNetwork::Outputs<int>::Type > FusionSerial;
+typedef FusionNetwork::Sink<int> FusionSink;
+
+int fusion_next;
+int fusion_received[FUSION_TOKEN_COUNT];
+int fusion_count;
+
+bool FusionSourceFunc(int & out) {
+  out = fusion_next++;
+  return fusion_next < FUSION_TOKEN_COUNT;
+}
+
+void FusionAddOne(int const & in, int & out) {
+  out = in + 1;
+}
+
+void FusionDouble(int const & in, int & out) {
+  out = in * 2;
+}
+
+void FusionSinkFunc(int const & in) {
+  fusion_received[fusion_count++] = in;
+}
+
+/**
+ * Runs the chain source -> add -> double -> add -> double -> sink, where
+ * the first two processes are parallel and the last two are serial. Returns
+ * the plan and whether all tokens arrived in order.
+ */
+bool RunChain(bool fusion, std::string & plan) {
+  FusionNetwork network;
+  FusionSource source(embb::base::MakeFunction(FusionSourceFunc));
+  FusionParallel parallel_add(embb::base::MakeFunction(FusionAddOne));
+  FusionParallel parallel_double(embb::base::MakeFunction(FusionDouble));
+  FusionSerial serial_add(embb::base::MakeFunction(FusionAddOne));
+  FusionSerial serial_double(embb::base::MakeFunction(FusionDouble));
+  FusionSink sink(embb::base::MakeFunction(FusionSinkFunc));
+
+  fusion_next = 0;
+  fusion_count = 0;
+
+  source >> parallel_add;
+  parallel_add >> parallel_double;
+  parallel_double >> serial_add;
+  serial_add >> serial_double;
+  serial_double >> sink;
+  network.Add(source);
+  network.Add(parallel_add);
+  network.Add(parallel_double);
+  network.Add(serial_add);
+  network.Add(serial_double);
+  network.Add(sink);
+
+  network.SetFusion(fusion);
+  std::ostringstream os;
+  network.PrintPlan(os);
+  plan = os.str();
+  network();
+
+  bool result = fusion_count == FUSION_TOKEN_COUNT;
+  for (int ii = 0; result && ii < FUSION_TOKEN_COUNT; ii++) {
+    result = fusion_received[ii] == ((ii + 1) * 2 + 1) * 2;
+  }
+  return result;
+}
+
+} // namespace
+
+FusionTest::FusionTest() {
+  CreateUnit("dataflow_cpp fusion test").Add(&FusionTest::TestChain, this);
+}
+
+void FusionTest::TestChain() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  std::string plan;
+  PT_EXPECT(RunChain(true, plan));
+  PT_EXPECT_EQ(plan, std::string(
+    "process 0 (parallel) -> process 1 (parallel)\n"
+    "process 2 (serial) -> process 3 (serial) -> sink 0 (serial)\n"));
+
+  PT_EXPECT(RunChain(false, plan));
+  PT_EXPECT_EQ(plan, std::string(
+    "process 0 (parallel)\n"
+    "process 1 (parallel)\n"
+    "process 2 (serial)\n"
+    "process 3 (serial)\n"
+    "sink 0 (serial)\n"));
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dataflow_cpp_test_policy.h>
+
+#include <sstream>
+#include <string>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/function.h>
+#include <embb/base/c/memory_allocation.h>
+
+#include <embb/dataflow/dataflow.h>
+
+#define POLICY_TOKEN_COUNT 100
+
+namespace {
+
+typedef embb::dataflow::Network<4> PolicyNetwork;
+typedef PolicyNetwork::Source<int> PolicySource;
+typedef PolicyNetwork::ParallelProcess< PolicyNetwork::Inputs<int>::Type,
+  PolicyNetwork::Outputs<int>::Type > PolicyParallel;
+typedef PolicyNetwork::SerialProcess< PolicyNetwork::Inputs<int>::Type,
+  PolicyNetwork::Outputs<int>::Type > PolicySerial;
+typedef PolicyNetwork::Sink<int> PolicySink;
+
+int policy_next;
+int policy_received[POLICY_TOKEN_COUNT];
+int policy_count;
+
+bool PolicySourceFunc(int & out) {
+  out = policy_next++;
+  return policy_next < POLICY_TOKEN_COUNT;
+}
+
+void PolicyAddOne(int const & in, int & out) {
+  out = in + 1;
+}
+
+void PolicySinkFunc(int const & in) {
+  policy_received[policy_count++] = in;
+}
+
+} // namespace
+
+PolicyTest::PolicyTest() {
+  CreateUnit("dataflow_cpp execution policy test")
+    .Add(&PolicyTest::TestPolicies, this);
+}
+
+void PolicyTest::TestPolicies() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    embb::mtapi::ExecutionPolicy low_priority(1u);
+    embb::mtapi::ExecutionPolicy worker_zero(false);
+    worker_zero.AddWorker(0);
+
+    PolicyNetwork network;
+    PolicySource source(embb::base::MakeFunction(PolicySourceFunc));
+    PolicyParallel first(embb::base::MakeFunction(PolicyAddOne));
+    PolicyParallel second(embb::base::MakeFunction(PolicyAddOne),
+      low_priority);
+    PolicySerial third(embb::base::MakeFunction(PolicyAddOne), worker_zero);
+    PolicySink sink(embb::base::MakeFunction(PolicySinkFunc), worker_zero);
+
+    PT_EXPECT_EQ(second.GetPolicy().GetPriority(), 1u);
+    PT_EXPECT(third.GetPolicy().GetAffinity() ==
+      worker_zero.GetAffinity());
+
+    policy_next = 0;
+    policy_count = 0;
+
+    source >> first;
+    first >> second;
+    second >> third;
+    third >> sink;
+    network.Add(source);
+    network.Add(first);
+    network.Add(second);
+    network.Add(third);
+    network.Add(sink);
+
+    // Only nodes with equal policies are fused
+    std::ostringstream plan;
+    network.PrintPlan(plan);
+    PT_EXPECT_EQ(plan.str(), std::string(
+      "process 0 (parallel)\n"
+      "process 1 (parallel)\n"
+      "process 2 (serial) -> sink 0 (serial)\n"));
+
+    network();
+
+    PT_EXPECT_EQ(policy_count, POLICY_TOKEN_COUNT);
+    for (int ii = 0; ii < POLICY_TOKEN_COUNT && ii < policy_count; ii++) {
+      PT_EXPECT_EQ(policy_received[ii], ii + 3);
+    }
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
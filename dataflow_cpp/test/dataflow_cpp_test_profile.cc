@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dataflow_cpp_test_profile.h>
+
+#include <sstream>
+#include <string>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/function.h>
+#include <embb/base/c/memory_allocation.h>
+#include <embb/base/c/time.h>
+
+#include <embb/dataflow/dataflow.h>
+
+#define PROFILE_TOKEN_COUNT 50
+
+namespace {
+
+typedef embb::dataflow::Network<4> ProfileNetwork;
+typedef ProfileNetwork::Source<int> ProfileSource;
+typedef ProfileNetwork::Source<int, bool> ProfilePredSource;
+typedef ProfileNetwork::ParallelProcess< ProfileNetwork::Inputs<int>::Type,
+  ProfileNetwork::Outputs<int>::Type > ProfileParallel;
+typedef ProfileNetwork::SerialProcess< ProfileNetwork::Inputs<int>::Type,
+  ProfileNetwork::Outputs<int>::Type > ProfileSerial;
+typedef ProfileNetwork::Switch<int> ProfileSwitch;
+typedef ProfileNetwork::Sink<int> ProfileSink;
+typedef ProfileNetwork::Sink<int, int> ProfileJoin;
+
+int profile_next;
+
+bool ProfileSourceFunc(int & out) {
+  out = profile_next++;
+  return profile_next < PROFILE_TOKEN_COUNT;
+}
+
+bool ProfilePredSourceFunc(int & out, bool & pred) {
+  out = profile_next++;
+  pred = (out % 2) == 0;
+  return profile_next < PROFILE_TOKEN_COUNT;
+}
+
+void ProfileSlow(int const & in, int & out) {
+  embb_time_t start, now;
+  embb_time_now(&start);
+  do {
+    embb_time_now(&now);
+  } while ((now.seconds - start.seconds) * 1000000000ull +
+    now.nanoseconds - start.nanoseconds < 200000ull);
+  out = in;
+}
+
+void ProfileFast(int const & in, int & out) {
+  out = in;
+}
+
+void ProfileSinkFunc(int const & /*in*/) {
+}
+
+void ProfileJoinFunc(int const & /*in1*/, int const & /*in2*/) {
+}
+
+} // namespace
+
+ProfileTest::ProfileTest() {
+  CreateUnit("dataflow_cpp profile counters test")
+    .Add(&ProfileTest::TestCounters, this);
+  CreateUnit("dataflow_cpp profile report test")
+    .Add(&ProfileTest::TestReport, this);
+}
+
+void ProfileTest::TestCounters() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    ProfileNetwork network;
+    ProfilePredSource source(embb::base::MakeFunction(ProfilePredSourceFunc));
+    ProfileSwitch sw;
+    ProfileSink even(embb::base::MakeFunction(ProfileSinkFunc));
+    ProfileSink odd(embb::base::MakeFunction(ProfileSinkFunc));
+    profile_next = 0;
+
+    source.GetOutput<0>() >> sw.GetInput<1>();
+    source.GetOutput<1>() >> sw.GetInput<0>();
+    sw.GetOutput<0>() >> even.GetInput<0>();
+    sw.GetOutput<1>() >> odd.GetInput<0>();
+    network.Add(source);
+    network.Add(sw);
+    network.Add(even);
+    network.Add(odd);
+
+    network();
+    PT_EXPECT_EQ(even.GetProfile().GetInvocations(), 0u);
+
+    network.SetProfiling(true);
+    profile_next = 0;
+    network();
+    PT_EXPECT_EQ(source.GetProfile().GetInvocations(),
+      static_cast<unsigned int>(PROFILE_TOKEN_COUNT));
+    PT_EXPECT_EQ(sw.GetProfile().GetInvocations(),
+      static_cast<unsigned int>(PROFILE_TOKEN_COUNT));
+    PT_EXPECT_EQ(sw.GetProfile().GetBlanks(), 0u);
+    PT_EXPECT_EQ(even.GetProfile().GetInvocations(),
+      static_cast<unsigned int>(PROFILE_TOKEN_COUNT));
+    PT_EXPECT_EQ(even.GetProfile().GetBlanks(),
+      static_cast<unsigned int>(PROFILE_TOKEN_COUNT / 2));
+    PT_EXPECT_EQ(odd.GetProfile().GetBlanks(),
+      static_cast<unsigned int>(PROFILE_TOKEN_COUNT / 2));
+    PT_EXPECT_LE(even.GetProfile().GetExecutionTimePercentile(50),
+      even.GetProfile().GetExecutionTimePercentile(99));
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
+
+void ProfileTest::TestReport() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    ProfileNetwork network;
+    ProfileSource source(embb::base::MakeFunction(ProfileSourceFunc));
+    ProfileSerial slow(embb::base::MakeFunction(ProfileSlow));
+    ProfileParallel fast(embb::base::MakeFunction(ProfileFast));
+    ProfileJoin join(embb::base::MakeFunction(ProfileJoinFunc));
+    profile_next = 0;
+
+    source >> slow;
+    source >> fast;
+    slow >> join;
+    fast.GetOutput<0>() >> join.GetInput<1>();
+    network.Add(source);
+    network.Add(slow);
+    network.Add(fast);
+    network.Add(join);
+    network.SetProfiling(true);
+    network();
+
+    // The slow process runs for at least 200us per token
+    PT_EXPECT_GE(slow.GetProfile().GetMeanExecutionTime(), 200000ull);
+    PT_EXPECT_GE(slow.GetProfile().GetExecutionTimePercentile(50),
+      200000ull);
+
+    std::ostringstream csv;
+    network.PrintProfile(csv);
+    std::string lines = csv.str();
+    PT_EXPECT_EQ(lines.find("node,mode,invocations,"), 0u);
+    PT_EXPECT(lines.find("\nsource 0,source,50,0,") != std::string::npos);
+    PT_EXPECT(lines.find("\nprocess 1,parallel,50,0,") != std::string::npos);
+    PT_EXPECT(lines.find("\nsink 0,serial,50,0,") != std::string::npos);
+    // Slow process is on the critical path and the bottleneck
+    PT_EXPECT(lines.find(",1,1\n") != std::string::npos);
+    PT_EXPECT(lines.find("\nprocess 0,serial,") != std::string::npos);
+
+    std::ostringstream json;
+    network.PrintProfile(json, ProfileNetwork::PROFILE_JSON);
+    std::string object = json.str();
+    PT_EXPECT(object.find("\"critical_path\": "
+      "[\"source 0\", \"process 0\", \"sink 0\"]") != std::string::npos);
+    PT_EXPECT(object.find("\"bottleneck\": \"process 0\"") !=
+      std::string::npos);
+  }
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dataflow_cpp_test_token.h>
+
+#include <vector>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/function.h>
+#include <embb/base/c/memory_allocation.h>
+
+#include <embb/dataflow/dataflow.h>
+
+#define TOKEN_COUNT 64
+
+namespace {
+
+typedef embb::dataflow::Network<4> TokenNetwork;
+
+/**
+ * Payload that counts how often a non-empty instance is copied.
+ */
+class CountedPayload {
+ public:
+  CountedPayload() : id_(-1) {}
+  CountedPayload(CountedPayload const & other) : id_(other.id_) {
+    Count(other);
+  }
+  CountedPayload & operator = (CountedPayload const & other) {
+    id_ = other.id_;
+    Count(other);
+    return *this;
+  }
+  int GetId() const { return id_; }
+  void SetId(int id) { id_ = id; }
+
+  static embb::base::Atomic<int> copies;
+
+ private:
+  int id_;
+
+  static void Count(CountedPayload const & other) {
+    if (other.id_ >= 0) {
+      ++copies;
+    }
+  }
+};
+
+embb::base::Atomic<int> CountedPayload::copies;
+
+int counted_next;
+int counted_sum;
+
+bool CountedSource(CountedPayload & out) {
+  out.SetId(counted_next++);
+  return counted_next < TOKEN_COUNT;
+}
+
+void CountedIncrement(CountedPayload const & in, CountedPayload & out) {
+  out.SetId(in.GetId() + 1);
+}
+
+void CountedSink(CountedPayload const & in) {
+  counted_sum += in.GetId();
+}
+
+typedef std::vector<int> Buffer;
+typedef embb::dataflow::SharedToken<Buffer> SharedBuffer;
+
+int shared_next;
+
+bool SharedSource(SharedBuffer & out) {
+  Buffer & buffer = out.Emplace();
+  buffer.assign(16, shared_next++);
+  return shared_next < TOKEN_COUNT;
+}
+
+class SharedSink {
+ public:
+  SharedSink() : count_(0) {}
+  void Run(SharedBuffer const & in) {
+    buffers_[count_++] = &in.GetValue();
+  }
+  Buffer const * GetBuffer(int index) const { return buffers_[index]; }
+  int GetCount() const { return count_; }
+
+ private:
+  Buffer const * buffers_[TOKEN_COUNT];
+  int count_;
+};
+
+} // namespace
+
+TokenTest::TokenTest() {
+  CreateUnit("dataflow_cpp single consumer test")
+    .Add(&TokenTest::TestSingleConsumer, this);
+  CreateUnit("dataflow_cpp shared fan-out test")
+    .Add(&TokenTest::TestSharedFanOut, this);
+}
+
+void TokenTest::TestSingleConsumer() {
+  typedef TokenNetwork::Source<CountedPayload> MySource;
+  typedef TokenNetwork::ParallelProcess<
+    TokenNetwork::Inputs<CountedPayload>::Type,
+    TokenNetwork::Outputs<CountedPayload>::Type > MyProcess;
+  typedef TokenNetwork::Sink<CountedPayload> MySink;
+
+  embb::mtapi::Node::Initialize(1, 1);
+  {
+    TokenNetwork network;
+    MySource source(embb::base::MakeFunction(CountedSource));
+    MyProcess process(embb::base::MakeFunction(CountedIncrement));
+    MySink sink(embb::base::MakeFunction(CountedSink));
+
+    CountedPayload::copies = 0;
+    counted_next = 0;
+    counted_sum = 0;
+
+    source >> process;
+    process >> sink;
+    network.Add(source);
+    network.Add(process);
+    network.Add(sink);
+    network();
+
+    // Each token is produced in the slot of its only consumer.
+    PT_EXPECT_EQ(CountedPayload::copies.Load(), 0);
+    PT_EXPECT_EQ(counted_sum, TOKEN_COUNT * (TOKEN_COUNT + 1) / 2);
+  }
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
+
+void TokenTest::TestSharedFanOut() {
+  typedef TokenNetwork::Source<SharedBuffer> MySource;
+  typedef TokenNetwork::Sink<SharedBuffer> MySink;
+
+  embb::mtapi::Node::Initialize(1, 1);
+  {
+    TokenNetwork network;
+    SharedSink shared_sink1;
+    SharedSink shared_sink2;
+    MySource source(embb::base::MakeFunction(SharedSource));
+    MySink sink1(embb::base::MakeFunction(shared_sink1, &SharedSink::Run));
+    MySink sink2(embb::base::MakeFunction(shared_sink2, &SharedSink::Run));
+
+    shared_next = 0;
+
+    source.GetOutput<0>() >> sink1.GetInput<0>();
+    source.GetOutput<0>() >> sink2.GetInput<0>();
+    network.Add(source);
+    network.Add(sink1);
+    network.Add(sink2);
+    network();
+
+    // Both sinks see the same buffer for each token.
+    PT_ASSERT_EQ(shared_sink1.GetCount(), TOKEN_COUNT);
+    PT_ASSERT_EQ(shared_sink2.GetCount(), TOKEN_COUNT);
+    for (int ii = 0; ii < TOKEN_COUNT; ii++) {
+      PT_EXPECT(shared_sink1.GetBuffer(ii) == shared_sink2.GetBuffer(ii));
+    }
+  }
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+
+  SharedBuffer token(Buffer(4, 1));
+  PT_EXPECT_EQ(token.GetReferenceCount(), 1);
+  {
+    SharedBuffer copy(token);
+    PT_EXPECT_EQ(token.GetReferenceCount(), 2);
+    PT_EXPECT(&copy.GetValue() == &token.GetValue());
+  }
+  PT_EXPECT_EQ(token.GetReferenceCount(), 1);
+  token = SharedBuffer();
+  PT_EXPECT(token.IsEmpty());
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dataflow_cpp_test_window.h>
+
+#include <embb/mtapi/mtapi.h>
+
+#include <embb/base/function.h>
+#include <embb/base/mutex.h>
+#include <embb/base/condition_variable.h>
+#include <embb/base/duration.h>
+#include <embb/base/c/memory_allocation.h>
+
+#include <embb/dataflow/dataflow.h>
+
+#define WINDOW_TOKEN_COUNT 200
+
+namespace {
+
+typedef embb::dataflow::Network<4> WindowNetwork;
+typedef WindowNetwork::Source<int> WindowSource;
+typedef WindowNetwork::ParallelProcess< WindowNetwork::Inputs<int>::Type,
+  WindowNetwork::Outputs<int>::Type > WindowSquare;
+typedef WindowNetwork::Sink<int> WindowSink;
+
+int window_next;
+int window_received[WINDOW_TOKEN_COUNT];
+int window_count;
+unsigned long long window_delay;
+
+/**
+ * Waits for window_delay microseconds without using the processor, so that
+ * waits on different threads overlap even on one core.
+ */
+void WindowWait() {
+  embb::base::Mutex mutex;
+  embb::base::ConditionVariable timer;
+  embb::base::UniqueLock<embb::base::Mutex> lock(mutex);
+  timer.WaitFor(lock,
+    embb::base::Duration<embb::base::Microseconds>(window_delay));
+}
+
+bool WindowSourceFunc(int & out) {
+  if (window_delay > 0)
+    WindowWait();
+  out = window_next++;
+  return window_next < WINDOW_TOKEN_COUNT;
+}
+
+void WindowSquareFunc(int const & in, int & out) {
+  if (window_delay > 0)
+    WindowWait();
+  out = in * in;
+}
+
+void WindowSinkFunc(int const & in) {
+  window_received[window_count++] = in;
+}
+
+/**
+ * Runs a pipeline through \c network and checks that all tokens arrive in
+ * order.
+ */
+bool RunPipeline(WindowNetwork & network) {
+  WindowSource source(embb::base::MakeFunction(WindowSourceFunc));
+  WindowSquare square(embb::base::MakeFunction(WindowSquareFunc));
+  WindowSink sink(embb::base::MakeFunction(WindowSinkFunc));
+
+  window_next = 0;
+  window_count = 0;
+
+  source >> square;
+  square >> sink;
+  network.Add(source);
+  network.Add(square);
+  network.Add(sink);
+  network();
+
+  bool result = window_count == WINDOW_TOKEN_COUNT;
+  for (int ii = 0; result && ii < WINDOW_TOKEN_COUNT; ii++) {
+    result = window_received[ii] == ii * ii;
+  }
+  return result;
+}
+
+} // namespace
+
+WindowTest::WindowTest() {
+  CreateUnit("dataflow_cpp runtime slices test")
+    .Add(&WindowTest::TestRuntimeSlices, this);
+  CreateUnit("dataflow_cpp auto-tuning test")
+    .Add(&WindowTest::TestAutoTuning, this);
+}
+
+void WindowTest::TestRuntimeSlices() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  {
+    WindowNetwork network;
+    PT_EXPECT_EQ(network.GetSlices(), 4);
+    PT_EXPECT(RunPipeline(network));
+  }
+  for (int slices = 1; slices <= 32; slices *= 2) {
+    WindowNetwork network(slices);
+    PT_EXPECT_EQ(network.GetSlices(), slices);
+    PT_EXPECT(RunPipeline(network));
+  }
+
+#ifdef EMBB_USE_EXCEPTIONS
+  bool thrown = false;
+  try {
+    WindowNetwork network(0);
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+#endif
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
+
+void WindowTest::TestAutoTuning() {
+  embb::mtapi::Node::Initialize(1, 1);
+
+  // The source and the process wait without using the processor, so a
+  // second token in flight doubles the throughput even on one core
+  window_delay = 1000;
+  {
+    WindowNetwork network(1);
+    // A latency bound that is never exceeded
+    network.SetAutoTuning(16,
+      embb::base::Duration<embb::base::Microseconds>(1000000000));
+    PT_EXPECT(RunPipeline(network));
+    PT_EXPECT_GT(network.GetSlices(), 1);
+    PT_EXPECT_LE(network.GetSlices(), 16);
+  }
+  {
+    WindowNetwork network(4);
+    // A latency bound that is always exceeded
+    network.SetAutoTuning(16,
+      embb::base::Duration<embb::base::Microseconds>(0));
+    PT_EXPECT(RunPipeline(network));
+    PT_EXPECT_GE(network.GetSlices(), 1);
+    PT_EXPECT_LE(network.GetSlices(), 4);
+  }
+  window_delay = 0;
+
+#ifdef EMBB_USE_EXCEPTIONS
+  bool thrown = false;
+  try {
+    WindowNetwork network(8);
+    network.SetAutoTuning(4,
+      embb::base::Duration<embb::base::Microseconds>(1000));
+  } catch (embb::base::ErrorException &) {
+    thrown = true;
+  }
+  PT_EXPECT(thrown);
+#endif
+
+  embb::mtapi::Node::Finalize();
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+}
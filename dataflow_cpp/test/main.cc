@@ -30,8 +30,24 @@
 
 #include <dataflow_cpp_test_simple.h>
 #include <dataflow_cpp_test_tuple.h>
+#include <dataflow_cpp_test_token.h>
+#include <dataflow_cpp_test_window.h>
+#include <dataflow_cpp_test_fusion.h>
+#include <dataflow_cpp_test_batch.h>
+#include <dataflow_cpp_test_external.h>
+#include <dataflow_cpp_test_profile.h>
+#include <dataflow_cpp_test_blank.h>
+#include <dataflow_cpp_test_policy.h>
 
 PT_MAIN("Dataflow C++") {
   PT_RUN(SimpleTest);
   PT_RUN(TupleTest);
+  PT_RUN(TokenTest);
+  PT_RUN(WindowTest);
+  PT_RUN(FusionTest);
+  PT_RUN(BatchTest);
+  PT_RUN(ExternalTest);
+  PT_RUN(ProfileTest);
+  PT_RUN(BlankTest);
+  PT_RUN(PolicyTest);
 }
@@ -27,16 +27,17 @@
 #include <stdlib.h>
 #include <embb/base/c/atomic.h>
 #include <embb/base/c/memory_allocation.h>
+#include <embb/base/c/sharded_counter.h>
 
 #include <embb_mtapi_alloc.h>
 
-static embb_atomic_unsigned_int embb_mtapi_alloc_bytes_allocated = { 0 };
+static embb_sharded_counter_t embb_mtapi_alloc_bytes_allocated;
 
 void * embb_mtapi_alloc_allocate(unsigned int bytes) {
   void * ptr = embb_alloc(bytes);
   if (ptr != NULL) {
-    embb_atomic_fetch_and_add_unsigned_int(
-      &embb_mtapi_alloc_bytes_allocated, sizeof(unsigned int)+bytes);
+    embb_sharded_counter_add(
+      &embb_mtapi_alloc_bytes_allocated, (long)(sizeof(unsigned int)+bytes));
   }
   return ptr;
 }
@@ -48,9 +49,10 @@ void embb_mtapi_alloc_deallocate(void * ptr) {
 }
 
 void embb_mtapi_alloc_reset_bytes_allocated() {
-  embb_atomic_store_unsigned_int(&embb_mtapi_alloc_bytes_allocated, 0);
+  embb_sharded_counter_init(&embb_mtapi_alloc_bytes_allocated);
 }
 
 unsigned int embb_mtapi_alloc_get_bytes_allocated() {
-  return embb_atomic_load_unsigned_int(&embb_mtapi_alloc_bytes_allocated);
+  return (unsigned int)embb_sharded_counter_read(
+    &embb_mtapi_alloc_bytes_allocated);
 }
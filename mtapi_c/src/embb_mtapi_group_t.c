@@ -24,6 +24,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <stddef.h>
+
 #include <embb/base/c/base.h>
 #include <embb/mtapi/c/mtapi.h>
 
@@ -57,7 +59,8 @@ void embb_mtapi_group_initialize(embb_mtapi_group_t * that) {
   that->group_id = MTAPI_GROUP_ID_NONE;
   that->deleted = MTAPI_FALSE;
   that->num_tasks.internal_variable = 0;
-  embb_mtapi_task_queue_initialize(&that->queue);
+  embb_mtapi_mpsc_queue_initialize(&that->queue);
+  embb_mtapi_spinlock_initialize(&that->queue_lock);
 }
 
 void embb_mtapi_group_initialize_with_node(
@@ -69,8 +72,9 @@ void embb_mtapi_group_initialize_with_node(
   that->group_id = MTAPI_GROUP_ID_NONE;
   that->deleted = MTAPI_FALSE;
   that->num_tasks.internal_variable = 0;
-  embb_mtapi_task_queue_initialize_with_capacity(
-    &that->queue, node->attributes.queue_limit);
+  EMBB_UNUSED(node);
+  embb_mtapi_mpsc_queue_initialize(&that->queue);
+  embb_mtapi_spinlock_initialize(&that->queue_lock);
 }
 
 void embb_mtapi_group_finalize(embb_mtapi_group_t * that) {
@@ -78,7 +82,36 @@ void embb_mtapi_group_finalize(embb_mtapi_group_t * that) {
 
   that->deleted = MTAPI_TRUE;
   that->num_tasks.internal_variable = 0;
-  embb_mtapi_task_queue_finalize(&that->queue);
+  embb_mtapi_mpsc_queue_finalize(&that->queue);
+  embb_mtapi_spinlock_finalize(&that->queue_lock);
+}
+
+void embb_mtapi_group_push_completed_task(
+  embb_mtapi_group_t * that,
+  embb_mtapi_task_t * task) {
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+
+  embb_mtapi_mpsc_queue_push(&that->queue, &task->group_node);
+}
+
+embb_mtapi_task_t * embb_mtapi_group_pop_completed_task(
+  embb_mtapi_group_t * that) {
+  embb_mtapi_mpsc_queue_node_t * node;
+
+  assert(MTAPI_NULL != that);
+
+  /* the queue allows only one consumer, but several threads may wait on
+     the same group */
+  embb_mtapi_spinlock_acquire(&that->queue_lock);
+  node = embb_mtapi_mpsc_queue_pop(&that->queue);
+  embb_mtapi_spinlock_release(&that->queue_lock);
+
+  if (MTAPI_NULL == node) {
+    return MTAPI_NULL;
+  }
+  return (embb_mtapi_task_t *)
+    ((char *)node - offsetof(embb_mtapi_task_t, group_node));
 }
 
 
@@ -240,7 +273,7 @@ void mtapi_group_wait_all(
         }
 
         /* fetch and delete all available tasks */
-        local_task = embb_mtapi_task_queue_pop(&local_group->queue);
+        local_task = embb_mtapi_group_pop_completed_task(local_group);
         while (MTAPI_NULL != local_task) {
           if (MTAPI_SUCCESS != local_task->error_code) {
             local_status = local_task->error_code;
@@ -248,7 +281,7 @@ void mtapi_group_wait_all(
           embb_mtapi_task_delete(local_task, node->task_pool);
           embb_atomic_fetch_and_add_int(&local_group->num_tasks, -1);
 
-          local_task = embb_mtapi_task_queue_pop(&local_group->queue);
+          local_task = embb_mtapi_group_pop_completed_task(local_group);
         }
 
         /* do other work if applicable */
@@ -312,7 +345,7 @@ void mtapi_group_wait_any(
 
         /* wait for any task to arrive */
         local_status = MTAPI_SUCCESS;
-        local_task = embb_mtapi_task_queue_pop(&local_group->queue);
+        local_task = embb_mtapi_group_pop_completed_task(local_group);
         while (MTAPI_NULL == local_task) {
           if (MTAPI_INFINITE < timeout) {
             embb_time_t current_time;
@@ -331,7 +364,7 @@ void mtapi_group_wait_any(
             context);
 
           /* try to pop a task from the group queue */
-          local_task = embb_mtapi_task_queue_pop(&local_group->queue);
+          local_task = embb_mtapi_group_pop_completed_task(local_group);
         }
         /* was there a timeout, or is there a result? */
         if (MTAPI_NULL != local_task) {
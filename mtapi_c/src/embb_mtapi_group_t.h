@@ -31,7 +31,9 @@
 #include <embb/base/c/atomic.h>
 
 #include <embb_mtapi_pool_template.h>
-#include <embb_mtapi_task_queue_t.h>
+#include <embb_mtapi_mpsc_queue_t.h>
+#include <embb_mtapi_spinlock_t.h>
+#include <embb_mtapi_task_t_fwd.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,7 +60,8 @@ struct embb_mtapi_group_struct {
   volatile mtapi_boolean_t deleted;
   embb_atomic_int num_tasks;
   mtapi_group_attributes_t attributes;
-  embb_mtapi_task_queue_t queue;
+  embb_mtapi_mpsc_queue_t queue;
+  embb_mtapi_spinlock_t queue_lock;
 };
 
 #include <embb_mtapi_group_t_fwd.h>
@@ -83,6 +86,23 @@ void embb_mtapi_group_initialize_with_node(
  */
 void embb_mtapi_group_finalize(embb_mtapi_group_t * that);
 
+/**
+ * Push a completed task into the completion queue. Never fails, may be
+ * called by any number of threads concurrently.
+ * \memberof embb_mtapi_group_struct
+ */
+void embb_mtapi_group_push_completed_task(
+  embb_mtapi_group_t * that,
+  embb_mtapi_task_t * task);
+
+/**
+ * Pop a completed task from the completion queue. Returns MTAPI_NULL if no
+ * completed task is available.
+ * \memberof embb_mtapi_group_struct
+ */
+embb_mtapi_task_t * embb_mtapi_group_pop_completed_task(
+  embb_mtapi_group_t * that);
+
 
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <assert.h>
+
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/atomic.h>
+
+#include <embb_mtapi_mpsc_queue_t.h>
+
+
+/* ---- CLASS MEMBERS ------------------------------------------------------ */
+
+/*
+ * For a description of the algorithm, see Dmitry Vyukov. "Intrusive MPSC
+ * node-based queue". 1024cores.net, 2010. The stub node is pushed again
+ * whenever the consumer is about to take the last node, so the queue never
+ * becomes empty.
+ */
+
+static embb_mtapi_mpsc_queue_node_t * embb_mtapi_mpsc_queue_node_get_next(
+  embb_mtapi_mpsc_queue_node_t * node) {
+  return (embb_mtapi_mpsc_queue_node_t *)
+    embb_atomic_load_uintptr_t(&node->next);
+}
+
+void embb_mtapi_mpsc_queue_initialize(embb_mtapi_mpsc_queue_t * that) {
+  assert(MTAPI_NULL != that);
+
+  embb_atomic_store_uintptr_t(&that->stub.next, 0);
+  embb_atomic_store_uintptr_t(&that->head, (uintptr_t)&that->stub);
+  that->tail = &that->stub;
+}
+
+void embb_mtapi_mpsc_queue_finalize(embb_mtapi_mpsc_queue_t * that) {
+  assert(MTAPI_NULL != that);
+
+  embb_mtapi_mpsc_queue_initialize(that);
+}
+
+void embb_mtapi_mpsc_queue_push(
+  embb_mtapi_mpsc_queue_t * that,
+  embb_mtapi_mpsc_queue_node_t * node) {
+  embb_mtapi_mpsc_queue_node_t * previous;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+
+  embb_atomic_store_uintptr_t(&node->next, 0);
+  previous = (embb_mtapi_mpsc_queue_node_t *)
+    embb_atomic_swap_uintptr_t(&that->head, (uintptr_t)node);
+  /* the queue is disconnected until the previous head is linked */
+  embb_atomic_store_uintptr_t(&previous->next, (uintptr_t)node);
+}
+
+embb_mtapi_mpsc_queue_node_t * embb_mtapi_mpsc_queue_pop(
+  embb_mtapi_mpsc_queue_t * that) {
+  embb_mtapi_mpsc_queue_node_t * tail;
+  embb_mtapi_mpsc_queue_node_t * next;
+
+  assert(MTAPI_NULL != that);
+
+  tail = that->tail;
+  next = embb_mtapi_mpsc_queue_node_get_next(tail);
+  if (&that->stub == tail) {
+    if (MTAPI_NULL == next) {
+      return MTAPI_NULL;
+    }
+    /* skip the stub */
+    that->tail = next;
+    tail = next;
+    next = embb_mtapi_mpsc_queue_node_get_next(next);
+  }
+  if (MTAPI_NULL != next) {
+    that->tail = next;
+    return tail;
+  }
+  if ((uintptr_t)tail != embb_atomic_load_uintptr_t(&that->head)) {
+    /* a producer has not linked its node yet */
+    return MTAPI_NULL;
+  }
+  /* tail is the last node, put the stub behind it */
+  embb_mtapi_mpsc_queue_push(that, &that->stub);
+  next = embb_mtapi_mpsc_queue_node_get_next(tail);
+  if (MTAPI_NULL != next) {
+    that->tail = next;
+    return tail;
+  }
+  return MTAPI_NULL;
+}
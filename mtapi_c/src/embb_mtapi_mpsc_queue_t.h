@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MTAPI_C_SRC_EMBB_MTAPI_MPSC_QUEUE_T_H_
+#define MTAPI_C_SRC_EMBB_MTAPI_MPSC_QUEUE_T_H_
+
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ---- FORWARD DECLARATIONS ----------------------------------------------- */
+
+#include <embb_mtapi_mpsc_queue_t_fwd.h>
+
+
+/* ---- CLASS DECLARATION -------------------------------------------------- */
+
+/**
+ * \internal
+ * Link embedded into the elements of an MPSC queue.
+ *
+ * \ingroup INTERNAL
+ */
+struct embb_mtapi_mpsc_queue_node_struct {
+  embb_atomic_uintptr_t next;
+};
+
+/**
+ * \internal
+ * Unbounded intrusive queue for multiple producers and a single consumer
+ * (Vyukov). Pushing is a single atomic swap and never fails, popping does
+ * not wait for producers.
+ *
+ * \ingroup INTERNAL
+ */
+struct embb_mtapi_mpsc_queue_struct {
+  embb_atomic_uintptr_t head;
+  embb_mtapi_mpsc_queue_node_t * tail;
+  embb_mtapi_mpsc_queue_node_t stub;
+};
+
+/**
+ * Default constructor.
+ * \memberof embb_mtapi_mpsc_queue_struct
+ */
+void embb_mtapi_mpsc_queue_initialize(embb_mtapi_mpsc_queue_t * that);
+
+/**
+ * Destructor. Nodes still contained in the queue are not touched.
+ * \memberof embb_mtapi_mpsc_queue_struct
+ */
+void embb_mtapi_mpsc_queue_finalize(embb_mtapi_mpsc_queue_t * that);
+
+/**
+ * Push a node into the queue. May be called by any number of threads
+ * concurrently.
+ * \memberof embb_mtapi_mpsc_queue_struct
+ */
+void embb_mtapi_mpsc_queue_push(
+  embb_mtapi_mpsc_queue_t * that,
+  embb_mtapi_mpsc_queue_node_t * node);
+
+/**
+ * Pop the oldest node from the queue. Returns MTAPI_NULL if the queue is
+ * empty or the oldest node is still being pushed. Must only be called by one
+ * thread at a time.
+ * \memberof embb_mtapi_mpsc_queue_struct
+ */
+embb_mtapi_mpsc_queue_node_t * embb_mtapi_mpsc_queue_pop(
+  embb_mtapi_mpsc_queue_t * that);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MTAPI_C_SRC_EMBB_MTAPI_MPSC_QUEUE_T_H_
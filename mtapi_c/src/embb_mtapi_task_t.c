@@ -134,7 +134,7 @@ void embb_mtapi_task_execute(
     embb_mtapi_group_t* local_group =
       embb_mtapi_group_pool_get_storage_for_handle(
       context->thread_context->node->group_pool, that->group);
-    embb_mtapi_task_queue_push(&local_group->queue, that);
+    embb_mtapi_group_push_completed_task(local_group, that);
   }
 }
 
@@ -32,6 +32,7 @@
 
 #include <embb_mtapi_pool_template.h>
 #include <embb_mtapi_spinlock_t.h>
+#include <embb_mtapi_mpsc_queue_t.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -70,6 +71,9 @@ struct embb_mtapi_task_struct {
   embb_atomic_unsigned_int current_instance;
 
   mtapi_status_t error_code;
+
+  /* link into the completion queue of the group */
+  embb_mtapi_mpsc_queue_node_t group_node;
 };
 
 #include <embb_mtapi_task_t_fwd.h>